@@ -1,172 +0,0 @@
-/* ----------------------------------------------------------------------
-   MR-MPI = MapReduce-MPI library
-   http://www.cs.sandia.gov/~sjplimp/mapreduce.html
-   Steve Plimpton, sjplimp@sandia.gov, Sandia National Laboratories
-
-   Copyright (2009) Sandia Corporation.  Under the terms of Contract
-   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
-   certain rights in this software.  This software is distributed under 
-   the modified Berkeley Software Distribution (BSD) License.
-
-   See the README file in the top-level MapReduce directory.
-------------------------------------------------------------------------- */
-
-// MapReduce word frequency example in C++
-// Syntax: wordfreq file1 dir1 file2 dir2 ...
-// (1) read all files and files in dirs
-// (2) parse into words separated by whitespace
-// (3) count occurrence of each word in all files
-// (4) print top 10 words
-
-#include "mpi.h"
-#include "stdio.h"
-#include "stdlib.h"
-#include "string.h"
-#include "sys/stat.h"
-#include "mapreduce.h"
-#include "keyvalue.h"
-
-using namespace MAPREDUCE_NS;
-
-void fileread(int, char *, KeyValue *, void *);
-void sum(char *, int, char *, int, int *, KeyValue *, void *);
-int ncompare(char *, int, char *, int);
-void output(uint64_t, char *, int, char *, int, KeyValue *, void *);
-
-struct Count {
-  int n,limit,flag;
-};
-
-/* ---------------------------------------------------------------------- */
-
-int main(int narg, char **args)
-{
-  MPI_Init(&narg,&args);
-
-  int me,nprocs;
-  MPI_Comm_rank(MPI_COMM_WORLD,&me);
-  MPI_Comm_size(MPI_COMM_WORLD,&nprocs);
-
-  if (narg <= 1) {
-    if (me == 0) printf("Syntax: wordfreq file1 file2 ...\n");
-    MPI_Abort(MPI_COMM_WORLD,1);
-  }
-
-  MapReduce *mr = new MapReduce(MPI_COMM_WORLD);
-  mr->verbosity = 2;
-  mr->timer = 1;
-  //mr->memsize = 1;
-  //mr->outofcore = 1;
-
-  MPI_Barrier(MPI_COMM_WORLD);
-  double tstart = MPI_Wtime();
-
-  int nwords = mr->map(narg-1,&args[1],0,1,0,fileread,NULL);
-  int nfiles = mr->mapfilecount;
-  mr->collate(NULL);
-  int nunique = mr->reduce(sum,NULL);
-
-  MPI_Barrier(MPI_COMM_WORLD);
-  double tstop = MPI_Wtime();
-
-  mr->sort_values(&ncompare);
-
-  Count count;
-  count.n = 0;
-  count.limit = 10;
-  count.flag = 0;
-  mr->map(mr,output,&count);
-
-  mr->gather(1);
-  mr->sort_values(ncompare);
-
-  count.n = 0;
-  count.limit = 10;
-  count.flag = 1;
-  mr->map(mr,output,&count);
-
-  delete mr;
-
-  if (me == 0) {
-    printf("%d total words, %d unique words\n",nwords,nunique);
-    printf("Time to process %d files on %d procs = %g (secs)\n",
-	   nfiles,nprocs,tstop-tstart);
-  }
-
-  MPI_Finalize();
-}
-
-/* ----------------------------------------------------------------------
-   read a file
-   for each word in file, emit key = word, value = NULL
-------------------------------------------------------------------------- */
-
-void fileread(int itask, char *fname, KeyValue *kv, void *ptr)
-{
-  // filesize = # of bytes in file
-
-  struct stat stbuf;
-  int flag = stat(fname,&stbuf);
-  if (flag < 0) {
-    printf("ERROR: Could not query file size\n");
-    MPI_Abort(MPI_COMM_WORLD,1);
-  }
-  int filesize = stbuf.st_size;
-
-  FILE *fp = fopen(fname,"r");
-  char *text = new char[filesize+1];
-  int nchar = fread(text,1,filesize,fp);
-  text[nchar] = '\0';
-  fclose(fp);
-
-  char *whitespace = " \t\n\f\r\0";
-  char *word = strtok(text,whitespace);
-  while (word) {
-    kv->add(word,strlen(word)+1,NULL,0);
-    word = strtok(NULL,whitespace);
-  }
-
-  delete [] text;
-}
-
-/* ----------------------------------------------------------------------
-   count word occurrence
-   emit key = word, value = # of multi-values
-------------------------------------------------------------------------- */
-
-void sum(char *key, int keybytes, char *multivalue,
-	 int nvalues, int *valuebytes, KeyValue *kv, void *ptr) 
-{
-  kv->add(key,keybytes,(char *) &nvalues,sizeof(int));
-}
-
-/* ----------------------------------------------------------------------
-   compare two counts
-   order values by count, largest first
-------------------------------------------------------------------------- */
-
-int ncompare(char *p1, int len1, char *p2, int len2)
-{
-  int i1 = *(int *) p1;
-  int i2 = *(int *) p2;
-  if (i1 > i2) return -1;
-  else if (i1 < i2) return 1;
-  else return 0;
-}
-
-/* ----------------------------------------------------------------------
-   process a word and its count
-   depending on flag, emit KV or print it, up to limit
-------------------------------------------------------------------------- */
-
-void output(uint64_t itask, char *key, int keybytes, char *value,
-	    int valuebytes, KeyValue *kv, void *ptr)
-{
-  Count *count = (Count *) ptr;
-  count->n++;
-  if (count->n > count->limit) return;
-
-  int n = *(int *) value;
-  if (count->flag) printf("%d %s\n",n,key);
-  else kv->add(key,keybytes,(char *) &n,sizeof(int));
-}
@@ -1,27 +0,0 @@
-# Make.sh = update Makefile.lib or Makefile.list
-# Syntax: sh Make.sh Makefile.lib
-#         sh Make.sh Makefile.list
-
-# edit Makefile.lib
-# called by "make makelib"
-# use current list of *.cpp and *.h files in src dir w/out main.cpp
-
-if (test $1 = "Makefile.lib") then
-
-  list=`ls -1 *.cpp | sed s/^main\.cpp// | tr "[:cntrl:]" " "`
-  sed -i -e "s/SRC =	.*/SRC =	$list/" Makefile.lib
-  list=`ls -1 *.h | tr "[:cntrl:]" " "`
-  sed -i -e "s/INC =	.*/INC =	$list/" Makefile.lib
-
-# edit Makefile.list
-# called by "make makelist"
-# use current list of *.cpp and *.h files in src dir
-
-elif (test $1 = "Makefile.list") then
-
-  list=`ls -1 *.cpp | tr "[:cntrl:]" " "`
-  sed -i -e "s/SRC =	.*/SRC =	$list/" Makefile.list
-  list=`ls -1 *.h | tr "[:cntrl:]" " "`
-  sed -i -e "s/INC =	.*/INC =	$list/" Makefile.list
-
-fi
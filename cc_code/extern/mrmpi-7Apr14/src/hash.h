@@ -1,5 +0,0 @@
-// Hash function hashlittle()
-// from lookup3.c, by Bob Jenkins, May 2006, Public Domain
-// bob_jenkins@burtleburtle.net
-
-uint32_t hashlittle(const void *key, size_t length, uint32_t);
@@ -1 +0,0 @@
-#define MRMPI_VERSION "7 Apr 2014"
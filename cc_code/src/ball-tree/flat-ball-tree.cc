@@ -0,0 +1,304 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+// Defining symbols from header:
+#include "flat-ball-tree.h"
+
+// Standard C++ library headers:
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+// Local project headers:
+#include "kd-tree/flat-kd-tree.h"
+#include "kd-tree/k-best.h"
+
+namespace whatprot {
+
+namespace {
+using std::fabs;
+using std::max;
+using std::min;
+using std::nth_element;
+using std::pair;
+using std::sqrt;
+using std::swap;
+using std::vector;
+
+double dist_sq(int d, const double* x, const double* y) {
+    double result = 0.0;
+    for (int j = 0; j < d; j++) {
+        double diff = x[j] - y[j];
+        result += diff * diff;
+    }
+    return result;
+}
+
+// Index into order of the entry of [begin, end) which is farthest from point.
+unsigned int farthest(int d,
+                      unsigned int begin,
+                      unsigned int end,
+                      const double* point,
+                      const double* coordinates,
+                      const vector<unsigned int>& order) {
+    unsigned int result = begin;
+    double max_dist_sq = -1.0;
+    for (unsigned int i = begin; i < end; i++) {
+        double x = dist_sq(d, point, &coordinates[(size_t)order[i] * d]);
+        if (x > max_dist_sq) {
+            max_dist_sq = x;
+            result = i;
+        }
+    }
+    return result;
+}
+}  // namespace
+
+FlatBallTree::FlatBallTree(int d,
+                           int leaf_size,
+                           unsigned int num_entries,
+                           const double* coordinates,
+                           const int* hits,
+                           vector<unsigned int>* order)
+        : d(d), num_entries(num_entries) {
+    order->resize(num_entries);
+    for (unsigned int i = 0; i < num_entries; i++) {
+        (*order)[i] = i;
+    }
+    if (num_entries > 0) {
+        make_node(leaf_size, 0, num_entries, coordinates, order);
+    }
+    num_nodes = nodes.size();
+    this->coordinates.resize((size_t)num_entries * d);
+    entries.resize(num_entries);
+    for (unsigned int i = 0; i < num_entries; i++) {
+        unsigned int from = (*order)[i];
+        for (int j = 0; j < d; j++) {
+            this->coordinates[(size_t)i * d + j] =
+                    coordinates[(size_t)from * d + j];
+        }
+        entries[i].hits = hits[from];
+    }
+}
+
+unsigned int FlatBallTree::make_node(int leaf_size,
+                                     unsigned int begin,
+                                     unsigned int end,
+                                     const double* coordinates,
+                                     vector<unsigned int>* order) {
+    unsigned int node_index = nodes.size();
+    nodes.push_back(ball_tree::BallNode());
+    nodes[node_index].right_child = 0;
+    nodes[node_index].begin = begin;
+    nodes[node_index].end = end;
+    nodes[node_index].max_left = 0.0;
+    nodes[node_index].min_right = 0.0;
+    directions.resize(directions.size() + d, 0.0);
+    // The center is the mean of the entries, and the radius is the distance
+    // to the farthest of them.
+    centers.resize(centers.size() + d, 0.0);
+    double* center = &centers[(size_t)node_index * d];
+    for (unsigned int i = begin; i < end; i++) {
+        const double* x = &coordinates[(size_t)(*order)[i] * d];
+        for (int j = 0; j < d; j++) {
+            center[j] += x[j];
+        }
+    }
+    for (int j = 0; j < d; j++) {
+        center[j] /= (double)(end - begin);
+    }
+    unsigned int far_i = farthest(d, begin, end, center, coordinates, *order);
+    double radius = sqrt(dist_sq(
+            d, center, &coordinates[(size_t)(*order)[far_i] * d]));
+    // The radius is padded very slightly, so that rounding errors can never
+    // prune an entry which is really inside the ball.
+    nodes[node_index].radius = radius * (1.0 + 1e-12);
+    // As in kd_tree::make_node(), we don't want any children smaller than
+    // leaf_size. The split is at the middle, so this is the same as making a
+    // leaf for anything smaller than twice that.
+    if (end - begin < 2 * (unsigned int)leaf_size) {
+        return node_index;
+    }
+    // Split along the line between two entries which are far apart: the entry
+    // farthest from the center, and the entry farthest from that. Each entry
+    // goes to the side of the middle of its projection onto that line. Ties
+    // are broken by index, so that the tree does not depend on the details of
+    // nth_element().
+    vector<double> a(&coordinates[(size_t)(*order)[far_i] * d],
+                     &coordinates[(size_t)(*order)[far_i] * d] + d);
+    unsigned int other = farthest(d, begin, end, &a[0], coordinates, *order);
+    const double* b = &coordinates[(size_t)(*order)[other] * d];
+    double* direction = &directions[(size_t)node_index * d];
+    double norm_sq = 0.0;
+    for (int j = 0; j < d; j++) {
+        direction[j] = b[j] - a[j];
+        norm_sq += direction[j] * direction[j];
+    }
+    // If every entry is in the same place, there is nothing to split.
+    if (norm_sq == 0.0) {
+        return node_index;
+    }
+    double norm = sqrt(norm_sq);
+    for (int j = 0; j < d; j++) {
+        direction[j] /= norm;
+    }
+    vector<pair<double, unsigned int>> projections;
+    projections.reserve(end - begin);
+    for (unsigned int i = begin; i < end; i++) {
+        const double* x = &coordinates[(size_t)(*order)[i] * d];
+        double projection = 0.0;
+        for (int j = 0; j < d; j++) {
+            projection += x[j] * direction[j];
+        }
+        projections.push_back(
+                pair<double, unsigned int>(projection, (*order)[i]));
+    }
+    unsigned int mid = (end - begin) / 2;
+    nth_element(projections.begin(),
+                projections.begin() + mid,
+                projections.end());
+    double max_left = -DBL_MAX;
+    double min_right = DBL_MAX;
+    for (unsigned int i = begin; i < end; i++) {
+        (*order)[i] = projections[i - begin].second;
+        if (i - begin < mid) {
+            max_left = max(max_left, projections[i - begin].first);
+        } else {
+            min_right = min(min_right, projections[i - begin].first);
+        }
+    }
+    // Padded slightly, as with the radius.
+    nodes[node_index].max_left = max_left + 1e-12 * fabs(max_left);
+    nodes[node_index].min_right = min_right - 1e-12 * fabs(min_right);
+    make_node(leaf_size, begin, begin + mid, coordinates, order);
+    unsigned int right_child =
+            make_node(leaf_size, begin + mid, end, coordinates, order);
+    nodes[node_index].right_child = right_child;
+    return node_index;
+}
+
+void FlatBallTree::search(const double* query,
+                          int k,
+                          double epsilon,
+                          vector<const kd_tree::FlatEntry*>* k_nearest,
+                          vector<double>* dists_sq) const {
+    kd_tree::SearchScratch* scratch = FlatKDTree::thread_scratch();
+    scratch->prepare(0, 1, d, 0, k);
+    if (num_nodes > 0) {
+        search_node(0,
+                    query,
+                    FlatKDTree::prune_factor(epsilon),
+                    &scratch->k_bests[0]);
+    }
+    scratch->k_bests[0].fill(k_nearest, dists_sq);
+}
+
+void FlatBallTree::search_batch(
+        const vector<const double*>& queries,
+        int k,
+        double epsilon,
+        vector<vector<const kd_tree::FlatEntry*>>* k_nearest,
+        vector<vector<double>>* dists_sq) const {
+    k_nearest->resize(queries.size());
+    dists_sq->resize(queries.size());
+    for (unsigned int q = 0; q < queries.size(); q++) {
+        (*k_nearest)[q].clear();
+        (*dists_sq)[q].clear();
+        search(queries[q], k, epsilon, &(*k_nearest)[q], &(*dists_sq)[q]);
+    }
+}
+
+unsigned int FlatBallTree::descend(const double* query) const {
+    if (num_nodes == 0) {
+        return 0;
+    }
+    unsigned int node_index = 0;
+    while (nodes[node_index].right_child != 0) {
+        unsigned int left = node_index + 1;
+        unsigned int right = nodes[node_index].right_child;
+        if (center_dist(left, query) <= center_dist(right, query)) {
+            node_index = left;
+        } else {
+            node_index = right;
+        }
+    }
+    return nodes[node_index].begin;
+}
+
+void FlatBallTree::search_node(
+        unsigned int node_index,
+        const double* query,
+        double prune_factor,
+        kd_tree::KBest<const kd_tree::FlatEntry>* k_best) const {
+    const ball_tree::BallNode& node = nodes[node_index];
+    if (node.right_child == 0) {
+        for (unsigned int i = node.begin; i < node.end; i++) {
+            const double* x = &coordinates[(size_t)i * d];
+            double kth_dist_sq = k_best->kth_dist_sq;
+            double dist_sq = 0.0;
+            int j = 0;
+            // Stop early once the entry is too far away, checking every few
+            // dimensions so that the loop in between can be unrolled.
+            while (j < d && dist_sq < kth_dist_sq) {
+                int stop = min(d, j + 8);
+                for (; j < stop; j++) {
+                    double diff = query[j] - x[j];
+                    dist_sq += diff * diff;
+                }
+            }
+            if (dist_sq < kth_dist_sq) {
+                k_best->insert(dist_sq, &entries[i]);
+            }
+        }
+        return;
+    }
+    // Nothing in a ball is closer to the query than the distance to its
+    // center less its radius. Nothing on one side of the split is closer than
+    // the distance from the query to that side, along the direction of the
+    // split. The child with the nearer bound is searched first, because it is
+    // more likely to hold the nearest neighbors, which then prune more of the
+    // other child.
+    unsigned int first = node_index + 1;
+    unsigned int second = node.right_child;
+    double query_projection = projection(node_index, query);
+    double first_dist = max(center_dist(first, query) - nodes[first].radius,
+                            query_projection - node.max_left);
+    double second_dist = max(center_dist(second, query) - nodes[second].radius,
+                             node.min_right - query_projection);
+    if (second_dist < first_dist) {
+        swap(first, second);
+        swap(first_dist, second_dist);
+    }
+    first_dist = max(0.0, first_dist);
+    second_dist = max(0.0, second_dist);
+    if (k_best->kth_dist_sq > first_dist * first_dist * prune_factor) {
+        search_node(first, query, prune_factor, k_best);
+    }
+    if (k_best->kth_dist_sq > second_dist * second_dist * prune_factor) {
+        search_node(second, query, prune_factor, k_best);
+    }
+}
+
+double FlatBallTree::projection(unsigned int node_index,
+                                const double* query) const {
+    const double* direction = &directions[(size_t)node_index * d];
+    double result = 0.0;
+    for (int j = 0; j < d; j++) {
+        result += query[j] * direction[j];
+    }
+    return result;
+}
+
+double FlatBallTree::center_dist(unsigned int node_index,
+                                 const double* query) const {
+    return sqrt(dist_sq(d, query, &centers[(size_t)node_index * d]));
+}
+
+}  // namespace whatprot
@@ -0,0 +1,119 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+#ifndef WHATPROT_BALL_TREE_FLAT_BALL_TREE_H
+#define WHATPROT_BALL_TREE_FLAT_BALL_TREE_H
+
+// Standard C++ library headers:
+#include <vector>
+
+// Local project headers:
+#include "kd-tree/flat-kd-tree.h"
+#include "kd-tree/k-best.h"
+
+namespace whatprot {
+namespace ball_tree {
+
+// A node of a FlatBallTree. Every entry under the node is within radius of
+// its center. Nodes are stored in depth-first order, so the left child of an
+// internal node is always the node right after it.
+class BallNode {
+public:
+    // Index into the nodes of the right child. Zero for a leaf.
+    unsigned int right_child;
+    // The entries under this node (in any leaf below it) are [begin, end).
+    unsigned int begin;
+    unsigned int end;
+    double radius;
+    // The entries of an internal node are split by their projections onto a
+    // unit direction. These are the largest projection in the left child and
+    // the smallest in the right child, as with the split of an InternalNode.
+    // Both are zero for a leaf.
+    double max_left;
+    double min_right;
+};
+
+}  // namespace ball_tree
+
+// An alternative to FlatKDTree for nearest neighbor search, with the same
+// search() contract, and the same kd_tree::FlatEntry entries, so that
+// NNClassifier can use either. Each node of a KD-tree is bounded by a box
+// aligned to the axes, which is a loose bound for dye tracks of many
+// timesteps: the dye tracks lie close to a few diagonal directions, along
+// which no single coordinate is split very well. A ball tree splits each node
+// along the line between two of its entries which are far apart, so that the
+// splits follow the data, and bounds each node by a ball instead of a box.
+// The split itself also bounds the distance to each side, just like the split
+// of a KD-tree, and the search uses whichever bound is tighter.
+class FlatBallTree {
+public:
+    // Builds a tree over num_entries entries of d dimensions, where coordinate
+    // j of entry i is coordinates[i * d + j] and hits[i] is its number of
+    // hits. The entries are reordered so that every leaf holds a contiguous
+    // range of them; order is set so that entry i of the tree is entry
+    // (*order)[i] of the input. As with kd_tree::make_node(), no node is split
+    // if either of its children would have fewer than leaf_size entries.
+    FlatBallTree(int d,
+                 int leaf_size,
+                 unsigned int num_entries,
+                 const double* coordinates,
+                 const int* hits,
+                 std::vector<unsigned int>* order);
+
+    // Same as FlatKDTree::search(), with the query given as d values. This
+    // includes the meaning of epsilon.
+    void search(const double* query,
+                int k,
+                double epsilon,
+                std::vector<const kd_tree::FlatEntry*>* k_nearest,
+                std::vector<double>* dists_sq) const;
+
+    // Same as FlatKDTree::search_batch(). The queries are searched one at a
+    // time, so this exists to make the two trees interchangeable.
+    void search_batch(
+            const std::vector<const double*>& queries,
+            int k,
+            double epsilon,
+            std::vector<std::vector<const kd_tree::FlatEntry*>>* k_nearest,
+            std::vector<std::vector<double>>* dists_sq) const;
+
+    // Same as FlatKDTree::descend(), following the child with the nearer
+    // center.
+    unsigned int descend(const double* query) const;
+
+    unsigned int index(const kd_tree::FlatEntry* entry) const {
+        return entry - &entries[0];
+    }
+
+    // Builds the node for entries [begin, end) of order, and everything below
+    // it. Returns the index of the node.
+    unsigned int make_node(int leaf_size,
+                           unsigned int begin,
+                           unsigned int end,
+                           const double* coordinates,
+                           std::vector<unsigned int>* order);
+    void search_node(unsigned int node_index,
+                     const double* query,
+                     double prune_factor,
+                     kd_tree::KBest<const kd_tree::FlatEntry>* k_best) const;
+    double center_dist(unsigned int node_index, const double* query) const;
+    double projection(unsigned int node_index, const double* query) const;
+
+    int d;
+    unsigned int num_nodes;
+    unsigned int num_entries;
+    std::vector<ball_tree::BallNode> nodes;
+    std::vector<double> centers;  // d values for each node.
+    std::vector<double> directions;  // d values for each node.
+    std::vector<double> coordinates;  // d values for each entry.
+    std::vector<kd_tree::FlatEntry> entries;
+};
+
+}  // namespace whatprot
+
+#endif  // WHATPROT_BALL_TREE_FLAT_BALL_TREE_H
@@ -0,0 +1,217 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+// Boost unit test framework (recommended to be the first include):
+#include <boost/test/unit_test.hpp>
+
+// File under test:
+#include "flat-ball-tree.h"
+
+// Standard C++ library headers:
+#include <algorithm>
+#include <vector>
+
+// Local project headers:
+#include "kd-tree/flat-kd-tree.h"
+
+namespace whatprot {
+
+namespace {
+using boost::unit_test::tolerance;
+using std::sort;
+using std::vector;
+const double TOL = 0.000000001;
+
+// Deterministic points which are spread out in every dimension.
+vector<double> make_points(int n, int d) {
+    vector<double> points(n * d);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < d; j++) {
+            points[i * d + j] = (double)((i * (2 * j + 3) + j * 5) % 17) / 4.0;
+        }
+    }
+    return points;
+}
+
+// Squared distances from query to its k nearest points, nearest first, by
+// brute force. Every point has one hit.
+vector<double> brute_force(const vector<double>& points,
+                           int d,
+                           const vector<double>& query,
+                           int k) {
+    vector<double> dists_sq;
+    for (unsigned int i = 0; i < points.size() / d; i++) {
+        double dist_sq = 0.0;
+        for (int j = 0; j < d; j++) {
+            double diff = query[j] - points[i * d + j];
+            dist_sq += diff * diff;
+        }
+        dists_sq.push_back(dist_sq);
+    }
+    sort(dists_sq.begin(), dists_sq.end());
+    dists_sq.resize(k);
+    return dists_sq;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(ball_tree_suite)
+BOOST_AUTO_TEST_SUITE(flat_ball_tree_suite)
+
+BOOST_AUTO_TEST_CASE(constructor_test) {
+    int d = 3;
+    int n = 100;
+    vector<double> points = make_points(n, d);
+    vector<int> hits(n);
+    for (int i = 0; i < n; i++) {
+        hits[i] = 1 + i % 3;
+    }
+    vector<unsigned int> order;
+    FlatBallTree tree(d, 5, n, &points[0], &hits[0], &order);
+    BOOST_TEST(tree.num_entries == (unsigned int)n);
+    BOOST_TEST(tree.num_nodes == tree.nodes.size());
+    BOOST_REQUIRE(order.size() == (unsigned int)n);
+    // Every entry is there exactly once, with its coordinates and hits.
+    vector<unsigned int> sorted_order = order;
+    sort(sorted_order.begin(), sorted_order.end());
+    for (int i = 0; i < n; i++) {
+        BOOST_TEST(sorted_order[i] == (unsigned int)i);
+        BOOST_TEST(tree.entries[i].hits == hits[order[i]]);
+        for (int j = 0; j < d; j++) {
+            BOOST_TEST(tree.coordinates[i * d + j]
+                       == points[order[i] * d + j]);
+        }
+    }
+    // Every leaf has at least the leaf size, and every entry is in its
+    // ball.
+    for (unsigned int node = 0; node < tree.num_nodes; node++) {
+        const ball_tree::BallNode& ball = tree.nodes[node];
+        if (ball.right_child == 0) {
+            BOOST_TEST(ball.end - ball.begin >= 5u);
+        }
+        for (unsigned int i = ball.begin; i < ball.end; i++) {
+            double dist_sq = 0.0;
+            for (int j = 0; j < d; j++) {
+                double diff = tree.coordinates[i * d + j]
+                              - tree.centers[node * d + j];
+                dist_sq += diff * diff;
+            }
+            BOOST_TEST(dist_sq <= ball.radius * ball.radius);
+        }
+        // Every entry is on its side of the split.
+        if (ball.right_child != 0) {
+            const ball_tree::BallNode& right = tree.nodes[ball.right_child];
+            for (unsigned int i = ball.begin; i < ball.end; i++) {
+                double projection = tree.projection(node,
+                                                    &tree.coordinates[i * d]);
+                if (i < right.begin) {
+                    BOOST_TEST(projection <= ball.max_left);
+                } else {
+                    BOOST_TEST(projection >= ball.min_right);
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(search_test, *tolerance(TOL)) {
+    int k = 7;
+    int d = 12;
+    int n = 300;
+    vector<double> points = make_points(n, d);
+    vector<int> hits(n, 1);
+    vector<unsigned int> order;
+    FlatBallTree tree(d, k, n, &points[0], &hits[0], &order);
+    for (int q = 0; q < 20; q++) {
+        vector<double> query(d);
+        for (int j = 0; j < d; j++) {
+            query[j] = (double)((q * 7 + j * 3) % 13) / 3.0;
+        }
+        vector<const kd_tree::FlatEntry*> k_nearest;
+        vector<double> dists_sq;
+        tree.search(&query[0], k, 0.0, &k_nearest, &dists_sq);
+        vector<double> expected = brute_force(points, d, query, k);
+        BOOST_REQUIRE(dists_sq.size() == (unsigned int)k);
+        // The results are given farthest first.
+        for (int i = 0; i < k; i++) {
+            BOOST_TEST(dists_sq[k - 1 - i] == expected[i]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(search_hits_test) {
+    int d = 2;
+    vector<double> points = {0.0, 0.0, 1.0, 0.0, 2.0, 0.0, 3.0, 0.0};
+    vector<int> hits = {1, 3, 1, 1};
+    vector<unsigned int> order;
+    FlatBallTree tree(d, 1, 4, &points[0], &hits[0], &order);
+    vector<double> query = {0.1, 0.0};
+    vector<const kd_tree::FlatEntry*> k_nearest;
+    vector<double> dists_sq;
+    tree.search(&query[0], 3, 0.0, &k_nearest, &dists_sq);
+    // The entry with three hits is enough with the one nearest.
+    BOOST_REQUIRE(k_nearest.size() == 2u);
+    BOOST_TEST(order[tree.index(k_nearest[0])] == 1u);
+    BOOST_TEST(order[tree.index(k_nearest[1])] == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(search_batch_test) {
+    int k = 4;
+    int d = 6;
+    int n = 200;
+    vector<double> points = make_points(n, d);
+    vector<int> hits(n, 1);
+    vector<unsigned int> order;
+    FlatBallTree tree(d, k, n, &points[0], &hits[0], &order);
+    vector<vector<double>> query_values;
+    vector<const double*> queries;
+    for (int q = 0; q < 10; q++) {
+        query_values.push_back(vector<double>(d, (double)q / 2.0));
+    }
+    for (int q = 0; q < 10; q++) {
+        queries.push_back(&query_values[q][0]);
+    }
+    vector<vector<const kd_tree::FlatEntry*>> batch_k_nearest;
+    vector<vector<double>> batch_dists_sq;
+    tree.search_batch(queries, k, 0.5, &batch_k_nearest, &batch_dists_sq);
+    BOOST_REQUIRE(batch_k_nearest.size() == 10u);
+    for (int q = 0; q < 10; q++) {
+        vector<const kd_tree::FlatEntry*> k_nearest;
+        vector<double> dists_sq;
+        tree.search(queries[q], k, 0.5, &k_nearest, &dists_sq);
+        BOOST_TEST(batch_k_nearest[q] == k_nearest);
+        BOOST_TEST(batch_dists_sq[q] == dists_sq);
+        // Approximate, but within the bound of epsilon.
+        vector<double> expected = brute_force(points, d, query_values[q], k);
+        for (unsigned int i = 0; i < dists_sq.size(); i++) {
+            BOOST_TEST(dists_sq[i] <= 1.5 * 1.5 * expected[k - 1]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(descend_test) {
+    int d = 4;
+    int n = 64;
+    vector<double> points = make_points(n, d);
+    vector<int> hits(n, 1);
+    vector<unsigned int> order;
+    FlatBallTree tree(d, 4, n, &points[0], &hits[0], &order);
+    // An entry of the tree descends to a leaf, which begins at or before it.
+    unsigned int begin = tree.descend(&tree.coordinates[10 * d]);
+    bool found_leaf = false;
+    for (const ball_tree::BallNode& node : tree.nodes) {
+        if (node.right_child == 0 && node.begin == begin) {
+            found_leaf = true;
+        }
+    }
+    BOOST_TEST(found_leaf);
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // flat_ball_tree_suite
+BOOST_AUTO_TEST_SUITE_END()  // ball_tree_suite
+
+}  // namespace whatprot
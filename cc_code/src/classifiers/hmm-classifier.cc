@@ -10,7 +10,10 @@
 #include "hmm-classifier.h"
 
 // Standard C++ library headers:
+#include <algorithm>
+#include <cmath>
 #include <functional>
+#include <limits>
 #include <vector>
 
 // Local project headers:
@@ -19,16 +22,24 @@
 #include "common/scored-classification.h"
 #include "hmm/hmm/peptide-hmm.h"
 #include "hmm/precomputations/dye-seq-precomputations.h"
+#include "hmm/precomputations/dye-seq-trie.h"
+#include "hmm/precomputations/emission-precomputations.h"
 #include "hmm/precomputations/radiometry-precomputations.h"
 #include "hmm/precomputations/universal-precomputations.h"
+#include "hmm/state-vector/peptide-state-vector.h"
 #include "parameterization/model/sequencing-model.h"
 #include "parameterization/settings/sequencing-settings.h"
-#include "util/range.h"
 
 namespace whatprot {
 
 namespace {
+using std::exp;
 using std::function;
+using std::isnan;
+using std::log;
+using std::max;
+using std::min;
+using std::numeric_limits;
 using std::vector;
 }  // namespace
 
@@ -43,7 +54,9 @@ HMMClassifier::HMMClassifier(
           universal_precomputations(seq_model, num_timesteps, num_channels),
           dye_seqs(dye_seqs),
           num_timesteps(num_timesteps),
-          num_channels(num_channels) {
+          num_channels(num_channels),
+          batch_size(1),
+          abandon_epsilon(0.0) {
     max_num_dyes = 0;
     for (const SourcedData<DyeSeq, SourceCount<int>>& dye_seq : dye_seqs) {
         dye_seq_precomputations_vec.push_back(new DyeSeqPrecomputations(
@@ -64,16 +77,76 @@ HMMClassifier::HMMClassifier(
         }
     }
     universal_precomputations.set_max_num_dyes(max_num_dyes);
+    emission_precomputations = new EmissionPrecomputations(
+            seq_model, seq_settings, num_channels, max_num_dyes);
+    dye_seq_trie = new DyeSeqTrie(dye_seq_precomputations_vec, num_timesteps);
+    // Children always come after their parents in the nodes of the trie, so
+    // going backwards we see every child before its parent.
+    trie_max_counts.resize(dye_seq_trie->nodes.size(), 0);
+    for (int n = (int)dye_seq_trie->nodes.size() - 1; n >= 0; n--) {
+        const DyeSeqTrieNode& node = dye_seq_trie->nodes[n];
+        for (int i : node.dye_seq_indices) {
+            trie_max_counts[n] =
+                    max(trie_max_counts[n], dye_seqs[i].source.count);
+        }
+        for (unsigned int child_i : node.children) {
+            trie_max_counts[n] =
+                    max(trie_max_counts[n], trie_max_counts[child_i]);
+        }
+    }
 }
 
 HMMClassifier::~HMMClassifier() {
     for (DyeSeqPrecomputations* ds_pre : dye_seq_precomputations_vec) {
         delete ds_pre;
     }
+    delete dye_seq_trie;
+    delete emission_precomputations;
 }
 
 ScoredClassification HMMClassifier::classify(const Radiometry& radiometry) {
-    return classify_helper<Range>(radiometry, Range(dye_seqs.size()));
+    // With every dye seq as a candidate, we can share the forward passes of the
+    // dye seqs through dye_seq_trie. See classify_helper() for the scoring.
+    RadiometryPrecomputations radiometry_precomputations(
+            radiometry, seq_model, seq_settings, *emission_precomputations);
+    vector<double> log_scores(dye_seqs.size(),
+                              -numeric_limits<double>::infinity());
+    vector<PeptideStateVector> states(num_timesteps);
+    PeptideStateVector start;
+    double best_log_score = -numeric_limits<double>::infinity();
+    for (unsigned int root_i : dye_seq_trie->roots) {
+        const DyeSeqTrieNode& root = dye_seq_trie->nodes[root_i];
+        PeptideHMM hmm(num_timesteps,
+                       num_channels,
+                       *dye_seq_precomputations_vec[root.representative],
+                       radiometry_precomputations,
+                       universal_precomputations);
+        // The pruning is the same for every dye seq under a root, so if one
+        // has an empty range, they all do.
+        if (hmm.empty_range) {
+            continue;
+        }
+        hmm.resize_states_forward(&start);
+        start.initialize_from_start();
+        classify_trie_node(root_i,
+                           0,
+                           hmm,
+                           start,
+                           0.0,
+                           radiometry_precomputations,
+                           &states,
+                           &log_scores[0],
+                           &best_log_score);
+    }
+    // The scores are folded in in order of the dye seqs, rather than the trie,
+    // so that ties are broken the same way as in classify_helper().
+    int best_i = -1;
+    best_log_score = -numeric_limits<double>::infinity();
+    double total_score = 0.0;
+    for (unsigned int i = 0; i < dye_seqs.size(); i++) {
+        add_score(i, log_scores[i], &best_i, &best_log_score, &total_score);
+    }
+    return scored_classification(best_i, total_score);
 }
 
 ScoredClassification HMMClassifier::classify(
@@ -85,6 +158,18 @@ vector<ScoredClassification> HMMClassifier::classify(
         const vector<Radiometry>& radiometries) {
     vector<ScoredClassification> results;
     results.resize(radiometries.size());
+    if (batch_size > 1) {
+        unsigned int num_batches =
+                (radiometries.size() + batch_size - 1) / batch_size;
+#pragma omp parallel for schedule(dynamic, 1)
+        for (unsigned int i = 0; i < num_batches; i++) {
+            unsigned int begin = i * batch_size;
+            unsigned int end = min((unsigned int)radiometries.size(),
+                                   begin + batch_size);
+            classify_batch(radiometries, begin, end, &results[begin]);
+        }
+        return results;
+    }
 #pragma omp parallel for schedule(dynamic, 1)
     for (unsigned int i = 0; i < radiometries.size(); i++) {
         results[i] = classify(radiometries[i]);
@@ -92,4 +177,185 @@ vector<ScoredClassification> HMMClassifier::classify(
     return results;
 }
 
+void HMMClassifier::classify_batch(const vector<Radiometry>& radiometries,
+                                   unsigned int begin,
+                                   unsigned int end,
+                                   ScoredClassification* results) {
+    unsigned int size = end - begin;
+    vector<RadiometryPrecomputations*> radiometry_precomputations_vec;
+    vector<const RadiometryPrecomputations*> batch;
+    for (unsigned int r = begin; r < end; r++) {
+        radiometry_precomputations_vec.push_back(
+                new RadiometryPrecomputations(radiometries[r],
+                                              seq_model,
+                                              seq_settings,
+                                              *emission_precomputations));
+        batch.push_back(radiometry_precomputations_vec.back());
+    }
+    RadiometryPrecomputations batch_precomputations(batch);
+    // Same bookkeeping as in classify_helper(), for each radiometry.
+    vector<int> best_i(size, -1);
+    vector<double> best_log_score(size, -numeric_limits<double>::infinity());
+    vector<double> total_score(size, 0.0);
+    vector<double> log_scores(size);
+    // Loop over dye seqs on the outside, so that each HMM is built only once.
+    for (unsigned int i = 0; i < dye_seqs.size(); i++) {
+        PeptideHMM hmm(num_timesteps,
+                       num_channels,
+                       *dye_seq_precomputations_vec[i],
+                       batch_precomputations,
+                       universal_precomputations);
+        hmm.batch_log_probability(size, &log_scores[0]);
+        for (unsigned int b = 0; b < size; b++) {
+            add_score(i,
+                      log_scores[b],
+                      &best_i[b],
+                      &best_log_score[b],
+                      &total_score[b]);
+        }
+    }
+    for (unsigned int b = 0; b < size; b++) {
+        results[b] = scored_classification(best_i[b], total_score[b]);
+    }
+    for (RadiometryPrecomputations* precomputations :
+         radiometry_precomputations_vec) {
+        delete precomputations;
+    }
+}
+
+void HMMClassifier::classify_trie_node(
+        unsigned int node_i,
+        unsigned int t,
+        const PeptideHMM& hmm,
+        const PeptideStateVector& input,
+        double log_score,
+        const RadiometryPrecomputations& radiometry_precomputations,
+        vector<PeptideStateVector>* states,
+        double* log_scores,
+        double* best_log_score) const {
+    PeptideStateVector* output = &(*states)[t];
+    log_score += hmm.log_forward_timestep(t, input, output);
+    if (log_score == -numeric_limits<double>::infinity()) {
+        return;
+    }
+    const DyeSeqTrieNode& node = dye_seq_trie->nodes[node_i];
+    for (int i : node.dye_seq_indices) {
+        log_scores[i] = log_score;
+        *best_log_score = max(*best_log_score, log_score);
+    }
+    double log_bound = log_score + hmm.log_emission_bounds[t];
+    if (!node.children.empty()
+        && can_abandon(log_bound, trie_max_counts[node_i], *best_log_score)) {
+        return;
+    }
+    for (unsigned int child_i : node.children) {
+        const DyeSeqTrieNode& child = dye_seq_trie->nodes[child_i];
+        if (child.representative == node.representative) {
+            classify_trie_node(child_i,
+                               t + 1,
+                               hmm,
+                               *output,
+                               log_score,
+                               radiometry_precomputations,
+                               states,
+                               log_scores,
+                               best_log_score);
+        } else {
+            // From here on the EdmanTransition steps of hmm are wrong for this
+            // child, so we need the HMM of a dye seq which is under it.
+            PeptideHMM child_hmm(
+                    num_timesteps,
+                    num_channels,
+                    *dye_seq_precomputations_vec[child.representative],
+                    radiometry_precomputations,
+                    universal_precomputations);
+            classify_trie_node(child_i,
+                               t + 1,
+                               child_hmm,
+                               *output,
+                               log_score,
+                               radiometry_precomputations,
+                               states,
+                               log_scores,
+                               best_log_score);
+        }
+    }
+}
+
+double HMMClassifier::bounded_log_probability(int i,
+                                              const PeptideHMM& hmm,
+                                              double best_log_score) const {
+    if (hmm.empty_range) {
+        return -numeric_limits<double>::infinity();
+    }
+    PeptideStateVector start;
+    hmm.resize_states_forward(&start);
+    start.initialize_from_start();
+    PeptideStateVector states[2];
+    const PeptideStateVector* in = &start;
+    double log_score = 0.0;
+    for (unsigned int t = 0; t < num_timesteps; t++) {
+        PeptideStateVector* out = &states[t % 2];
+        log_score += hmm.log_forward_timestep(t, *in, out);
+        if (log_score == -numeric_limits<double>::infinity()) {
+            return log_score;
+        }
+        double log_bound = log_score + hmm.log_emission_bounds[t];
+        if (t + 1 < num_timesteps
+            && can_abandon(
+                    log_bound, dye_seqs[i].source.count, best_log_score)) {
+            return -numeric_limits<double>::infinity();
+        }
+        in = out;
+    }
+    return log_score;
+}
+
+bool HMMClassifier::can_abandon(double log_bound,
+                                int count,
+                                double best_log_score) const {
+    if (abandon_epsilon == 0.0) {
+        return false;
+    }
+    // This is count * exp(log_bound - best_log_score) < abandon_epsilon, but
+    // can't overflow.
+    return log_bound + log(count) < best_log_score + log(abandon_epsilon);
+}
+
+void HMMClassifier::add_score(int i,
+                              double log_score,
+                              int* best_i,
+                              double* best_log_score,
+                              double* total_score) const {
+    if (*best_i == -1) {
+        *best_i = i;
+    }
+    if (log_score == -numeric_limits<double>::infinity()) {
+        return;
+    }
+    if (log_score > *best_log_score) {
+        *total_score *= exp(*best_log_score - log_score);
+        *best_log_score = log_score;
+        *best_i = i;
+    }
+    *total_score += exp(log_score - *best_log_score) * dye_seqs[i].source.count;
+}
+
+ScoredClassification HMMClassifier::scored_classification(
+        int best_i, double total_score) const {
+    double best_score = (total_score > 0.0) ? 1.0 : 0.0;
+    ScoredClassification result(
+            dye_seqs[best_i].source.source, best_score, total_score);
+    // This next thing is a bit of a hack. Sometimes the candidates have a total
+    // score of 0.0, which causes the adjusted score to be nan. This can mess
+    // things up for us later. The best way to deal with it is to just set the
+    // score to 0.0 when this happens. It might be better though to find a way
+    // to avoid this situation.
+    if (isnan(result.adjusted_score())) {
+        result.score = 0.0;
+        result.total = 1.0;
+    }
+    return result;
+}
+
 }  // namespace whatprot
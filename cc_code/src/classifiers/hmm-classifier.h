@@ -12,6 +12,7 @@
 // Standard C++ library headers:
 #include <cmath>
 #include <functional>
+#include <limits>
 #include <vector>
 
 // Local project headers:
@@ -20,8 +21,11 @@
 #include "common/sourced-data.h"
 #include "hmm/hmm/peptide-hmm.h"
 #include "hmm/precomputations/dye-seq-precomputations.h"
+#include "hmm/precomputations/dye-seq-trie.h"
+#include "hmm/precomputations/emission-precomputations.h"
 #include "hmm/precomputations/radiometry-precomputations.h"
 #include "hmm/precomputations/universal-precomputations.h"
+#include "hmm/state-vector/peptide-state-vector.h"
 #include "parameterization/model/sequencing-model.h"
 #include "parameterization/settings/sequencing-settings.h"
 
@@ -46,9 +50,14 @@ public:
     ScoredClassification classify_helper(const Radiometry& radiometry,
                                          I indices) {
         RadiometryPrecomputations radiometry_precomputations(
-                radiometry, seq_model, seq_settings, max_num_dyes);
+                radiometry, seq_model, seq_settings, *emission_precomputations);
+        // We work with log probabilities so that long reads can't underflow to
+        // zero. Scores are then kept relative to the best log probability seen
+        // so far, and total_score is rescaled whenever that changes. This
+        // means the result's score and total are only meaningful as a ratio,
+        // which is all that adjusted_score() needs.
         int best_i = -1;
-        double best_score = -1.0;
+        double best_log_score = -std::numeric_limits<double>::infinity();
         double total_score = 0.0;
         for (int i : indices) {
             PeptideHMM hmm(num_timesteps,
@@ -56,35 +65,94 @@ public:
                            *dye_seq_precomputations_vec[i],
                            radiometry_precomputations,
                            universal_precomputations);
-            double score = hmm.probability();
-            total_score += score * dye_seqs[i].source.count;
-            if (score > best_score) {
-                best_score = score;
-                best_i = i;
+            double log_score;
+            if (abandon_epsilon > 0.0) {
+                log_score = bounded_log_probability(i, hmm, best_log_score);
+            } else {
+                log_score = hmm.log_probability();
             }
+            add_score(i, log_score, &best_i, &best_log_score, &total_score);
         }
-        ScoredClassification result(
-                dye_seqs[best_i].source.source, best_score, total_score);
-        // This next thing is a bit of a hack. Sometimes the candidates have a
-        // total score of 0.0, which causes the adjusted score to be nan. This
-        // can mess things up for us later. The best way to deal with it is to
-        // just set the score to 0.0 when this happens. It might be better
-        // though to find a way to avoid this situation.
-        if (std::isnan(result.adjusted_score())) {
-            result.score = 0.0;
-            result.total = 1.0;
-        }
-        return result;
+        return scored_classification(best_i, total_score);
     }
 
+    // Classifies radiometries[begin] through radiometries[end - 1] together,
+    // writing the results to results[0] through results[end - begin - 1]. The
+    // HMM for each dye seq is built once and run on every radiometry in the
+    // batch at the same time.
+    void classify_batch(const std::vector<Radiometry>& radiometries,
+                        unsigned int begin,
+                        unsigned int end,
+                        ScoredClassification* results);
+
+    // Computes the log probabilities of every dye seq under node_i of
+    // dye_seq_trie, writing them to log_scores[dye seq index]. The states
+    // before timestep t of that node are given as input, along with the log
+    // of the scaling factors which have been taken out of them. The steps for
+    // timestep t and up are taken from hmm, which must belong to a dye seq
+    // under the node. The results for timestep t go in states[t], and so on,
+    // and are only valid until the next call. Dye seqs with a probability of
+    // zero are skipped, leaving log_scores as it was, as are dye seqs which
+    // can_abandon() given the best log score so far (which is kept up to date
+    // in best_log_score).
+    void classify_trie_node(
+            unsigned int node_i,
+            unsigned int t,
+            const PeptideHMM& hmm,
+            const PeptideStateVector& input,
+            double log_score,
+            const RadiometryPrecomputations& radiometry_precomputations,
+            std::vector<PeptideStateVector>* states,
+            double* log_scores,
+            double* best_log_score) const;
+
+    // Same as hmm.log_probability() for dye seq i, except that the forward
+    // pass gives up and returns negative infinity as soon as can_abandon()
+    // says that the dye seq no longer matters.
+    double bounded_log_probability(int i,
+                                   const PeptideHMM& hmm,
+                                   double best_log_score) const;
+
+    // True if dye seqs with the given count and a log probability of at most
+    // log_bound would each add less than abandon_epsilon to the total score,
+    // relative to the score of the best dye seq so far. Such dye seqs also
+    // can't become the best one (abandon_epsilon is at most one), so their
+    // computation can be abandoned. Always false if abandon_epsilon is zero.
+    bool can_abandon(double log_bound, int count, double best_log_score) const;
+
+    // Folds the log probability of dye seq i into the running best and total
+    // of a classification.
+    void add_score(int i,
+                   double log_score,
+                   int* best_i,
+                   double* best_log_score,
+                   double* total_score) const;
+
+    // Turns the running best and total of a classification into the result.
+    ScoredClassification scored_classification(int best_i,
+                                               double total_score) const;
+
     const SequencingModel& seq_model;
     const SequencingSettings& seq_settings;
     UniversalPrecomputations universal_precomputations;
+    EmissionPrecomputations* emission_precomputations;
     std::vector<DyeSeqPrecomputations*> dye_seq_precomputations_vec;
+    DyeSeqTrie* dye_seq_trie;
+    // Largest count of any dye seq under each node of dye_seq_trie.
+    std::vector<int> trie_max_counts;
     const std::vector<SourcedData<DyeSeq, SourceCount<int>>>& dye_seqs;
     unsigned int num_timesteps;
     unsigned int num_channels;
     unsigned int max_num_dyes;
+    // Number of radiometries to run through each HMM at once when classifying
+    // a vector of radiometries. One means no batching.
+    unsigned int batch_size;
+    // Candidates which can be shown to contribute less than this (as a
+    // fraction of the best candidate's score) to the total score are abandoned
+    // part way through their HMM (see can_abandon()). This makes the reported
+    // total score slightly smaller than the true one. Zero, the default,
+    // turns this off, giving exact results. Does not apply to classify_batch().
+    double abandon_epsilon;
 };
 
 }  // namespace whatprot
@@ -11,9 +11,11 @@
 
 // Standard C++ library headers:
 #include <cmath>
+#include <unordered_map>
 #include <vector>
 
 // Local project headers:
+#include "ball-tree/flat-ball-tree.h"
 #include "classifiers/hmm-classifier.h"
 #include "classifiers/nn-classifier.h"
 #include "common/dye-seq.h"
@@ -21,6 +23,7 @@
 #include "common/radiometry.h"
 #include "common/scored-classification.h"
 #include "common/sourced-data.h"
+#include "kd-tree/flat-kd-tree.h"
 #include "parameterization/model/sequencing-model.h"
 #include "parameterization/settings/sequencing-settings.h"
 
@@ -28,6 +31,7 @@ namespace whatprot {
 
 namespace {
 using std::isnan;
+using std::unordered_map;
 using std::vector;
 }  // namespace
 
@@ -37,14 +41,22 @@ HybridClassifier::HybridClassifier(
         const SequencingModel& seq_model,
         const SequencingSettings& seq_settings,
         int k,
+        int leaf_size,
         double sig,
+        double nn_epsilon,
         vector<SourcedData<DyeTrack, SourceCountHitsList<int>>>* dye_tracks,
         int h,
         const vector<SourcedData<DyeSeq, SourceCount<int>>>& dye_seqs)
         : hmm_classifier(
                 num_timesteps, num_channels, seq_model, seq_settings, dye_seqs),
-          nn_classifier(
-                  num_timesteps, num_channels, seq_model, k, sig, dye_tracks),
+          nn_classifier(num_timesteps,
+                        num_channels,
+                        seq_model,
+                        k,
+                        leaf_size,
+                        sig,
+                        nn_epsilon,
+                        dye_tracks),
           h(h) {
     for (unsigned int i = 0; i < dye_seqs.size(); i++) {
         id_index_map[dye_seqs[i].source.source] = i;
@@ -52,13 +64,69 @@ HybridClassifier::HybridClassifier(
     }
 }
 
-ScoredClassification HybridClassifier::classify(const Radiometry& radiometry) {
-    vector<ScoredClassification> candidates;
-    candidates = nn_classifier.classify(radiometry, h);
+HybridClassifier::HybridClassifier(
+        unsigned int num_timesteps,
+        unsigned int num_channels,
+        const SequencingModel& seq_model,
+        const SequencingSettings& seq_settings,
+        int k,
+        double sig,
+        double nn_epsilon,
+        FlatKDTree* kd_tree,
+        vector<SourceCountHitsList<int>>* entry_sources,
+        int h,
+        const vector<SourcedData<DyeSeq, SourceCount<int>>>& dye_seqs)
+        : hmm_classifier(
+                num_timesteps, num_channels, seq_model, seq_settings, dye_seqs),
+          nn_classifier(num_timesteps,
+                        num_channels,
+                        k,
+                        sig,
+                        nn_epsilon,
+                        kd_tree,
+                        entry_sources),
+          h(h) {
+    for (unsigned int i = 0; i < dye_seqs.size(); i++) {
+        id_index_map[dye_seqs[i].source.source] = i;
+        id_count_map[dye_seqs[i].source.source] = dye_seqs[i].source.count;
+    }
+}
+
+HybridClassifier::HybridClassifier(
+        unsigned int num_timesteps,
+        unsigned int num_channels,
+        const SequencingModel& seq_model,
+        const SequencingSettings& seq_settings,
+        int k,
+        double sig,
+        double nn_epsilon,
+        FlatBallTree* ball_tree,
+        vector<SourceCountHitsList<int>>* entry_sources,
+        int h,
+        const vector<SourcedData<DyeSeq, SourceCount<int>>>& dye_seqs)
+        : hmm_classifier(
+                num_timesteps, num_channels, seq_model, seq_settings, dye_seqs),
+          nn_classifier(num_timesteps,
+                        num_channels,
+                        k,
+                        sig,
+                        nn_epsilon,
+                        ball_tree,
+                        entry_sources),
+          h(h) {
+    for (unsigned int i = 0; i < dye_seqs.size(); i++) {
+        id_index_map[dye_seqs[i].source.source] = i;
+        id_count_map[dye_seqs[i].source.source] = dye_seqs[i].source.count;
+    }
+}
+
+ScoredClassification HybridClassifier::classify_candidates(
+        const Radiometry& radiometry,
+        vector<ScoredClassification>* candidates) {
     double subfraction = 0.0;
     vector<int> candidate_indices;
-    candidate_indices.reserve(candidates.size());
-    for (ScoredClassification& candidate : candidates) {
+    candidate_indices.reserve(candidates->size());
+    for (ScoredClassification& candidate : *candidates) {
         subfraction +=
                 candidate.adjusted_score() * (double)id_count_map[candidate.id];
         candidate_indices.push_back(id_index_map[candidate.id]);
@@ -66,7 +134,7 @@ ScoredClassification HybridClassifier::classify(const Radiometry& radiometry) {
     ScoredClassification result;
     result = hmm_classifier.classify(radiometry, candidate_indices);
     if (result.id == -1) {
-        result = candidates.back();
+        result = candidates->back();
     } else {
         result.score *= subfraction;
     }
@@ -82,13 +150,32 @@ ScoredClassification HybridClassifier::classify(const Radiometry& radiometry) {
     return result;
 }
 
+ScoredClassification HybridClassifier::classify(const Radiometry& radiometry) {
+    vector<ScoredClassification> candidates;
+    candidates = nn_classifier.classify(radiometry, h);
+    return classify_candidates(radiometry, &candidates);
+}
+
 vector<ScoredClassification> HybridClassifier::classify(
         const vector<Radiometry>& radiometries) {
     vector<ScoredClassification> results;
     results.resize(radiometries.size());
+    vector<vector<unsigned int>> batches =
+            nn_classifier.make_batches(radiometries);
 #pragma omp parallel for schedule(dynamic, 1)
-    for (unsigned int i = 0; i < radiometries.size(); i++) {
-        results[i] = classify(radiometries[i]);
+    for (unsigned int b = 0; b < batches.size(); b++) {
+        const vector<unsigned int>& batch = batches[b];
+        vector<unordered_map<int, double>> id_score_maps;
+        vector<double> total_scores;
+        nn_classifier.classify_batch_helper(
+                radiometries, batch, &id_score_maps, &total_scores);
+        for (unsigned int i = 0; i < batch.size(); i++) {
+            vector<ScoredClassification> candidates =
+                    nn_classifier.top_classifications(
+                            id_score_maps[i], total_scores[i], h);
+            results[batch[i]] =
+                    classify_candidates(radiometries[batch[i]], &candidates);
+        }
     }
     return results;
 }
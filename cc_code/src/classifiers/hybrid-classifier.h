@@ -14,6 +14,7 @@
 #include <vector>
 
 // Local project headers:
+#include "ball-tree/flat-ball-tree.h"
 #include "classifiers/hmm-classifier.h"
 #include "classifiers/nn-classifier.h"
 #include "common/dye-seq.h"
@@ -21,6 +22,7 @@
 #include "common/radiometry.h"
 #include "common/scored-classification.h"
 #include "common/sourced-data.h"
+#include "kd-tree/flat-kd-tree.h"
 #include "parameterization/model/sequencing-model.h"
 #include "parameterization/settings/sequencing-settings.h"
 
@@ -34,11 +36,45 @@ public:
             const SequencingModel& seq_model,
             const SequencingSettings& seq_settings,
             int k,
+            int leaf_size,
             double sig,
+            double nn_epsilon,
             std::vector<SourcedData<DyeTrack, SourceCountHitsList<int>>>*
                     dye_tracks,
             int h,
             const std::vector<SourcedData<DyeSeq, SourceCount<int>>>& dye_seqs);
+    // Uses a prebuilt kd_tree for the NNClassifier; see the NNClassifier
+    // constructor with the same arguments.
+    HybridClassifier(
+            unsigned int num_timesteps,
+            unsigned int num_channels,
+            const SequencingModel& seq_model,
+            const SequencingSettings& seq_settings,
+            int k,
+            double sig,
+            double nn_epsilon,
+            FlatKDTree* kd_tree,
+            std::vector<SourceCountHitsList<int>>* entry_sources,
+            int h,
+            const std::vector<SourcedData<DyeSeq, SourceCount<int>>>& dye_seqs);
+    // Same as above, with a FlatBallTree in place of the kd_tree.
+    HybridClassifier(
+            unsigned int num_timesteps,
+            unsigned int num_channels,
+            const SequencingModel& seq_model,
+            const SequencingSettings& seq_settings,
+            int k,
+            double sig,
+            double nn_epsilon,
+            FlatBallTree* ball_tree,
+            std::vector<SourceCountHitsList<int>>* entry_sources,
+            int h,
+            const std::vector<SourcedData<DyeSeq, SourceCount<int>>>& dye_seqs);
+    // Finishes classifying radiometry with the HMM, given the candidates the
+    // NNClassifier found for it.
+    ScoredClassification classify_candidates(
+            const Radiometry& radiometry,
+            std::vector<ScoredClassification>* candidates);
     ScoredClassification classify(const Radiometry& radiometry);
     std::vector<ScoredClassification> classify(
             const std::vector<Radiometry>& radiometries);
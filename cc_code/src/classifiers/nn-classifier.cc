@@ -10,6 +10,7 @@
 #include "nn-classifier.h"
 
 // Standard C++ library headers:
+#include <algorithm>
 #include <cmath>
 #include <functional>
 #include <queue>
@@ -17,10 +18,16 @@
 #include <utility>
 #include <vector>
 
+// OpenMP
+#include <omp.h>
+
 // Local project headers:
+#include "ball-tree/flat-ball-tree.h"
 #include "common/radiometry.h"
 #include "common/scored-classification.h"
 #include "common/sourced-data.h"
+#include "kd-tree/flat-kd-tree.h"
+#include "kd-tree/kd-tree.h"
 #include "parameterization/model/sequencing-model.h"
 
 namespace {
@@ -28,12 +35,21 @@ using std::exp;
 using std::function;
 using std::greater;  // defined in <functional>
 using std::isnan;
+using std::max;
+using std::min;
 using std::move;
+using std::pair;
 using std::priority_queue;
+using std::sort;
 using std::sqrt;
 using std::unordered_map;
 using std::vector;
 using whatprot::KDTEntry;  // in namespace std for swap
+// Batches bigger than this don't fit their leaves in cache together anyways.
+const unsigned int MAX_BATCH_SIZE = 64;
+// Levels of features for FlatKDTree::build_prefilter(). More levels rule out
+// more entries, but cost more for the entries they don't rule out.
+const int PREFILTER_LEVELS = 2;
 }  // namespace
 
 namespace whatprot {
@@ -93,43 +109,163 @@ double KDTQuery::operator[](int i) const {
     return rad.intensities[i];
 }
 
-NNClassifier::NNClassifier(
+FlatKDTree* build_kd_tree(
         unsigned int num_timesteps,
         unsigned int num_channels,
         const SequencingModel& seq_model,
         int k,
-        double sig,
-        vector<SourcedData<DyeTrack, SourceCountHitsList<int>>>* dye_tracks)
-        : num_train(dye_tracks->size()),
-          num_timesteps(num_timesteps),
-          num_channels(num_channels),
-          k(k),
-          two_sig_sq(2.0 * sig * sig) {
+        int leaf_size,
+        vector<SourcedData<DyeTrack, SourceCountHitsList<int>>>* dye_tracks,
+        vector<SourceCountHitsList<int>>* entry_sources) {
+    int num_train = dye_tracks->size();
+    vector<KDTEntry> kdt_entries;
+    kdt_entries.reserve(num_train);
+    for (int i = 0; i < num_train; i++) {
+        KDTEntry kdt_convert(seq_model, move((*dye_tracks)[i]));
+        kdt_entries.push_back(move(kdt_convert));
+    }
+    int d = num_timesteps * num_channels;
+    KDTree<KDTEntry, KDTQuery> tree(k, d, leaf_size, move(kdt_entries));
+    // Searching the flattened tree is faster, because the coordinates of the
+    // entries are no longer recomputed on every search. Once we have it, we
+    // only need to keep the sources of the dye tracks.
+    FlatKDTree* kd_tree = new FlatKDTree(tree, d);
+    entry_sources->clear();
+    entry_sources->reserve(num_train);
+    for (int i = 0; i < num_train; i++) {
+        entry_sources->push_back(move(tree.values[i].dye_track.source));
+    }
+    return kd_tree;
+}
+
+FlatBallTree* build_ball_tree(
+        unsigned int num_timesteps,
+        unsigned int num_channels,
+        const SequencingModel& seq_model,
+        int leaf_size,
+        vector<SourcedData<DyeTrack, SourceCountHitsList<int>>>* dye_tracks,
+        vector<SourceCountHitsList<int>>* entry_sources) {
+    int num_train = dye_tracks->size();
+    int d = num_timesteps * num_channels;
+    // The coordinates of each dye track are computed just once, because the
+    // tree is built from distances between entries and not just from
+    // comparisons of one coordinate at a time.
     vector<KDTEntry> kdt_entries;
     kdt_entries.reserve(num_train);
+    vector<double> coordinates((size_t)num_train * d);
+    vector<int> hits(num_train);
     for (int i = 0; i < num_train; i++) {
         KDTEntry kdt_convert(seq_model, move((*dye_tracks)[i]));
+        for (int j = 0; j < d; j++) {
+            coordinates[(size_t)i * d + j] = kdt_convert[j];
+        }
+        hits[i] = kdt_convert.hits;
         kdt_entries.push_back(move(kdt_convert));
     }
-    kd_tree = new KDTree<KDTEntry, KDTQuery>(k,
-                                             num_timesteps * num_channels,  // d
-                                             move(kdt_entries));
+    vector<unsigned int> order;
+    FlatBallTree* ball_tree = new FlatBallTree(
+            d, leaf_size, num_train, &coordinates[0], &hits[0], &order);
+    entry_sources->clear();
+    entry_sources->reserve(num_train);
+    for (int i = 0; i < num_train; i++) {
+        entry_sources->push_back(
+                move(kdt_entries[order[i]].dye_track.source));
+    }
+    return ball_tree;
+}
+
+NNClassifier::NNClassifier(
+        unsigned int num_timesteps,
+        unsigned int num_channels,
+        const SequencingModel& seq_model,
+        int k,
+        int leaf_size,
+        double sig,
+        double epsilon,
+        vector<SourcedData<DyeTrack, SourceCountHitsList<int>>>* dye_tracks)
+        : ball_tree(NULL),
+          num_train(dye_tracks->size()),
+          num_timesteps(num_timesteps),
+          num_channels(num_channels),
+          k(k),
+          two_sig_sq(2.0 * sig * sig),
+          epsilon(epsilon) {
+    kd_tree = build_kd_tree(num_timesteps,
+                            num_channels,
+                            seq_model,
+                            k,
+                            leaf_size,
+                            dye_tracks,
+                            &entry_sources);
+    kd_tree->build_prefilter(num_channels, PREFILTER_LEVELS);
+}
+
+NNClassifier::NNClassifier(unsigned int num_timesteps,
+                           unsigned int num_channels,
+                           int k,
+                           double sig,
+                           double epsilon,
+                           FlatKDTree* kd_tree,
+                           vector<SourceCountHitsList<int>>* entry_sources)
+        : kd_tree(kd_tree),
+          ball_tree(NULL),
+          num_train(kd_tree->num_entries),
+          num_timesteps(num_timesteps),
+          num_channels(num_channels),
+          k(k),
+          two_sig_sq(2.0 * sig * sig),
+          epsilon(epsilon) {
+    this->entry_sources.swap(*entry_sources);
+    kd_tree->build_prefilter(num_channels, PREFILTER_LEVELS);
+}
+
+NNClassifier::NNClassifier(unsigned int num_timesteps,
+                           unsigned int num_channels,
+                           int k,
+                           double sig,
+                           double epsilon,
+                           FlatBallTree* ball_tree,
+                           vector<SourceCountHitsList<int>>* entry_sources)
+        : kd_tree(NULL),
+          ball_tree(ball_tree),
+          num_train(ball_tree->num_entries),
+          num_timesteps(num_timesteps),
+          num_channels(num_channels),
+          k(k),
+          two_sig_sq(2.0 * sig * sig),
+          epsilon(epsilon) {
+    this->entry_sources.swap(*entry_sources);
 }
 
 NNClassifier::~NNClassifier() {
     delete kd_tree;
+    delete ball_tree;
 }
 
 double NNClassifier::classify_helper(const Radiometry& radiometry,
                                      unordered_map<int, double>* id_score_map) {
-    KDTQuery query(radiometry);
-    vector<KDTEntry*> k_nearest;
+    vector<const kd_tree::FlatEntry*> k_nearest;
     vector<double> dists_sq;
-    kd_tree->search(query, &k_nearest, &dists_sq);
+    if (kd_tree != NULL) {
+        KDTQuery query(radiometry);
+        kd_tree->search(query, k, epsilon, &k_nearest, &dists_sq);
+    } else {
+        ball_tree->search(
+                radiometry.intensities, k, epsilon, &k_nearest, &dists_sq);
+    }
+    return score_neighbors(k_nearest, dists_sq, id_score_map);
+}
+
+double NNClassifier::score_neighbors(
+        const vector<const kd_tree::FlatEntry*>& k_nearest,
+        const vector<double>& dists_sq,
+        unordered_map<int, double>* id_score_map) {
     double total_score = 0.0;
     for (unsigned int i = 0; i < k_nearest.size(); i++) {
-        const SourcedData<DyeTrack, SourceCountHitsList<int>>& dye_track =
-                k_nearest[i]->dye_track;
+        unsigned int index = (kd_tree != NULL)
+                                     ? kd_tree->index(k_nearest[i])
+                                     : ball_tree->index(k_nearest[i]);
+        const SourceCountHitsList<int>& sources = entry_sources[index];
         double dist_sq = dists_sq[i];
         // For computing a gaussian kernel.
         //   * The normalization factor, 1/(sig*2*PI), is ignored here,
@@ -139,10 +275,10 @@ double NNClassifier::classify_helper(const Radiometry& radiometry,
         //     kernel is radially symmetric. It is also far more efficient to
         //     compute it this way, which is why we do it.
         double weight = exp(-dist_sq / two_sig_sq);
-        for (int j = 0; j < dye_track.source.num_sources; j++) {
-            int id = dye_track.source.sources[j]->source;
-            double count = (double)dye_track.source.sources[j]->count;
-            double hits = (double)dye_track.source.sources[j]->hits;
+        for (int j = 0; j < sources.num_sources; j++) {
+            int id = sources.sources[j].source;
+            double count = (double)sources.sources[j].count;
+            double hits = (double)sources.sources[j].hits;
             total_score += weight * hits;
             (*id_score_map)[id] += weight * hits / count;
         }
@@ -150,9 +286,65 @@ double NNClassifier::classify_helper(const Radiometry& radiometry,
     return total_score;
 }
 
-ScoredClassification NNClassifier::classify(const Radiometry& radiometry) {
-    unordered_map<int, double> id_score_map;
-    double total_score = classify_helper(radiometry, &id_score_map);
+vector<vector<unsigned int>> NNClassifier::make_batches(
+        const vector<Radiometry>& radiometries) {
+    // Sorting by the leaf each radiometry descends to puts radiometries which
+    // are near each other next to each other.
+    vector<pair<unsigned int, unsigned int>> leaf_and_index;
+    leaf_and_index.reserve(radiometries.size());
+    for (unsigned int i = 0; i < radiometries.size(); i++) {
+        const double* query = radiometries[i].intensities;
+        unsigned int leaf = (kd_tree != NULL) ? kd_tree->descend(query)
+                                              : ball_tree->descend(query);
+        leaf_and_index.push_back(pair<unsigned int, unsigned int>(leaf, i));
+    }
+    sort(leaf_and_index.begin(), leaf_and_index.end());
+    // We still want a few batches per thread, so that the work stays balanced
+    // when there are few radiometries.
+    unsigned int num_batches_wanted = 4 * omp_get_max_threads();
+    unsigned int batch_size =
+            (radiometries.size() + num_batches_wanted - 1) / num_batches_wanted;
+    batch_size = max(1u, min(MAX_BATCH_SIZE, batch_size));
+    vector<vector<unsigned int>> batches;
+    for (unsigned int i = 0; i < leaf_and_index.size(); i += batch_size) {
+        unsigned int end =
+                min(i + batch_size, (unsigned int)leaf_and_index.size());
+        batches.push_back(vector<unsigned int>());
+        batches.back().reserve(end - i);
+        for (unsigned int j = i; j < end; j++) {
+            batches.back().push_back(leaf_and_index[j].second);
+        }
+    }
+    return batches;
+}
+
+void NNClassifier::classify_batch_helper(
+        const vector<Radiometry>& radiometries,
+        const vector<unsigned int>& batch,
+        vector<unordered_map<int, double>>* id_score_maps,
+        vector<double>* total_scores) {
+    vector<const double*> queries;
+    queries.reserve(batch.size());
+    for (unsigned int i : batch) {
+        queries.push_back(radiometries[i].intensities);
+    }
+    vector<vector<const kd_tree::FlatEntry*>> k_nearest;
+    vector<vector<double>> dists_sq;
+    if (kd_tree != NULL) {
+        kd_tree->search_batch(queries, k, epsilon, &k_nearest, &dists_sq);
+    } else {
+        ball_tree->search_batch(queries, k, epsilon, &k_nearest, &dists_sq);
+    }
+    id_score_maps->resize(batch.size());
+    total_scores->resize(batch.size());
+    for (unsigned int i = 0; i < batch.size(); i++) {
+        (*total_scores)[i] = score_neighbors(
+                k_nearest[i], dists_sq[i], &(*id_score_maps)[i]);
+    }
+}
+
+ScoredClassification NNClassifier::best_classification(
+        const unordered_map<int, double>& id_score_map, double total_score) {
     int best_id = -1;
     double best_score = -1.0;
     for (const auto& id_and_score : id_score_map) {
@@ -176,10 +368,10 @@ ScoredClassification NNClassifier::classify(const Radiometry& radiometry) {
     return result;
 }
 
-vector<ScoredClassification> NNClassifier::classify(
-        const Radiometry& radiometry, unsigned int h) {
-    unordered_map<int, double> id_score_map;
-    double total_score = classify_helper(radiometry, &id_score_map);
+vector<ScoredClassification> NNClassifier::top_classifications(
+        const unordered_map<int, double>& id_score_map,
+        double total_score,
+        unsigned int h) {
     priority_queue<ScoredClassification,
                    vector<ScoredClassification>,
                    greater<ScoredClassification>>
@@ -203,13 +395,35 @@ vector<ScoredClassification> NNClassifier::classify(
     return results;
 }
 
+ScoredClassification NNClassifier::classify(const Radiometry& radiometry) {
+    unordered_map<int, double> id_score_map;
+    double total_score = classify_helper(radiometry, &id_score_map);
+    return best_classification(id_score_map, total_score);
+}
+
+vector<ScoredClassification> NNClassifier::classify(
+        const Radiometry& radiometry, unsigned int h) {
+    unordered_map<int, double> id_score_map;
+    double total_score = classify_helper(radiometry, &id_score_map);
+    return top_classifications(id_score_map, total_score, h);
+}
+
 vector<ScoredClassification> NNClassifier::classify(
         const vector<Radiometry>& radiometries) {
     vector<ScoredClassification> results;
     results.resize(radiometries.size());
+    vector<vector<unsigned int>> batches = make_batches(radiometries);
 #pragma omp parallel for schedule(dynamic, 1)
-    for (unsigned int i = 0; i < radiometries.size(); i++) {
-        results[i] = classify(radiometries[i]);
+    for (unsigned int b = 0; b < batches.size(); b++) {
+        const vector<unsigned int>& batch = batches[b];
+        vector<unordered_map<int, double>> id_score_maps;
+        vector<double> total_scores;
+        classify_batch_helper(
+                radiometries, batch, &id_score_maps, &total_scores);
+        for (unsigned int i = 0; i < batch.size(); i++) {
+            results[batch[i]] =
+                    best_classification(id_score_maps[i], total_scores[i]);
+        }
     }
     return results;
 }
@@ -16,10 +16,12 @@
 #include <vector>
 
 // Local project headers:
+#include "ball-tree/flat-ball-tree.h"
 #include "common/dye-track.h"
 #include "common/radiometry.h"
 #include "common/scored-classification.h"
 #include "common/sourced-data.h"
+#include "kd-tree/flat-kd-tree.h"
 #include "kd-tree/kd-tree.h"
 #include "parameterization/model/sequencing-model.h"
 
@@ -55,30 +57,106 @@ public:
     Radiometry rad;
 };
 
+// Builds the FlatKDTree used by NNClassifier from dye_tracks, which are moved
+// out of. The sources of the dye tracks are moved into entry_sources, in the
+// order of the entries of the tree. This is what a KD-tree index holds (see
+// write_kd_tree_index()). Each leaf of the tree holds at least leaf_size dye
+// tracks.
+FlatKDTree* build_kd_tree(
+        unsigned int num_timesteps,
+        unsigned int num_channels,
+        const SequencingModel& seq_model,
+        int k,
+        int leaf_size,
+        std::vector<SourcedData<DyeTrack, SourceCountHitsList<int>>>*
+                dye_tracks,
+        std::vector<SourceCountHitsList<int>>* entry_sources);
+
+// Same as build_kd_tree(), for a FlatBallTree.
+FlatBallTree* build_ball_tree(
+        unsigned int num_timesteps,
+        unsigned int num_channels,
+        const SequencingModel& seq_model,
+        int leaf_size,
+        std::vector<SourcedData<DyeTrack, SourceCountHitsList<int>>>*
+                dye_tracks,
+        std::vector<SourceCountHitsList<int>>* entry_sources);
+
 class NNClassifier {
 public:
     NNClassifier(unsigned int num_timesteps,
                  unsigned int num_channels,
                  const SequencingModel& seq_model,
                  int k,
+                 int leaf_size,
                  double sig,
+                 double epsilon,
                  std::vector<SourcedData<DyeTrack, SourceCountHitsList<int>>>*
                          dye_tracks);
+    // Uses a prebuilt kd_tree (i.e., read from a file with
+    // read_kd_tree_index()), taking ownership of it. The contents of
+    // entry_sources are moved out; they must be in the order of the entries of
+    // kd_tree.
+    NNClassifier(unsigned int num_timesteps,
+                 unsigned int num_channels,
+                 int k,
+                 double sig,
+                 double epsilon,
+                 FlatKDTree* kd_tree,
+                 std::vector<SourceCountHitsList<int>>* entry_sources);
+    // Same as above, except that the neighbors are searched for in a
+    // FlatBallTree (i.e., from build_ball_tree()) instead.
+    NNClassifier(unsigned int num_timesteps,
+                 unsigned int num_channels,
+                 int k,
+                 double sig,
+                 double epsilon,
+                 FlatBallTree* ball_tree,
+                 std::vector<SourceCountHitsList<int>>* entry_sources);
     ~NNClassifier();
     double classify_helper(const Radiometry& radiometry,
                            std::unordered_map<int, double>* id_score_map);
+    double score_neighbors(
+            const std::vector<const kd_tree::FlatEntry*>& k_nearest,
+            const std::vector<double>& dists_sq,
+            std::unordered_map<int, double>* id_score_map);
+    // Splits the indices of radiometries into batches to be searched for
+    // together with FlatKDTree::search_batch(). Radiometries which search the
+    // same part of the KD-tree are put in the same batch.
+    std::vector<std::vector<unsigned int>> make_batches(
+            const std::vector<Radiometry>& radiometries);
+    // Same as classify_helper() for radiometries[batch[i]], for every i, with
+    // the results in (*id_score_maps)[i] and (*total_scores)[i].
+    void classify_batch_helper(
+            const std::vector<Radiometry>& radiometries,
+            const std::vector<unsigned int>& batch,
+            std::vector<std::unordered_map<int, double>>* id_score_maps,
+            std::vector<double>* total_scores);
+    ScoredClassification best_classification(
+            const std::unordered_map<int, double>& id_score_map,
+            double total_score);
+    std::vector<ScoredClassification> top_classifications(
+            const std::unordered_map<int, double>& id_score_map,
+            double total_score,
+            unsigned int h);
     ScoredClassification classify(const Radiometry& radiometry);
     std::vector<ScoredClassification> classify(const Radiometry& radiometry,
                                                unsigned int h);
     std::vector<ScoredClassification> classify(
             const std::vector<Radiometry>& radiometries);
 
-    KDTree<KDTEntry, KDTQuery>* kd_tree;
+    // Exactly one of these is used to search for neighbors, and the other is
+    // NULL. The two have the same interface.
+    FlatKDTree* kd_tree;
+    FlatBallTree* ball_tree;
+    // Sources of the dye track behind each entry of the tree, by entry index.
+    std::vector<SourceCountHitsList<int>> entry_sources;
     int num_train;
     unsigned int num_timesteps;
     unsigned int num_channels;
     int k;  // number of nearest neighbors to use
     double two_sig_sq;  // sig to use for kernel weighting
+    double epsilon;  // for approximate search; see FlatKDTree::search()
 };
 
 }  // namespace whatprot
@@ -20,7 +20,10 @@ namespace whatprot {
 template <typename V, typename S>
 class SourcedData {
 public:
-    SourcedData(V value, S source) : value(value), source(source) {}
+    // Both are moved in, so that a source which is a view (e.g., a
+    // SourceCountHitsList into a MappedFile) stays a view.
+    SourcedData(V value, S source)
+            : value(std::move(value)), source(std::move(source)) {}
 
     SourcedData(SourcedData&& other)
             : value(std::move(other.value)), source(std::move(other.source)) {}
@@ -102,30 +105,40 @@ public:
     int hits;  // A count of the number of hits in a simulation.
 };
 
+// The sources are stored flat, in one array, rather than as an array of
+// pointers. This way a list can also be a view into memory it does not own
+// (i.e., a mapped binary dye-track file), in which case owns_sources is false
+// and the memory must outlive the list.
 template <typename S>
 class SourceCountHitsList {
 public:
-    SourceCountHitsList(int num_sources, SourceCountHits<S>** sources)
-            : sources(sources), num_sources(num_sources) {}
-
+    SourceCountHitsList(int num_sources,
+                        SourceCountHits<S>* sources,
+                        bool owns_sources = true)
+            : sources(sources),
+              num_sources(num_sources),
+              owns_sources(owns_sources) {}
+
+    // A copy always owns its sources, even if other is a view.
     SourceCountHitsList(const SourceCountHitsList& other)
-            : num_sources(other.num_sources) {
-        sources = new SourceCountHits<S>*[num_sources];
+            : num_sources(other.num_sources), owns_sources(true) {
+        sources = new SourceCountHits<S>[num_sources];
         for (int i = 0; i < num_sources; i++) {
-            sources[i] = new SourceCountHits<S>(other.sources[i]->source,
-                                                other.sources[i]->count,
-                                                other.sources[i]->hits);
+            sources[i] = other.sources[i];
         }
     }
 
     SourceCountHitsList(SourceCountHitsList&& other)
-            : sources(other.sources), num_sources(other.num_sources) {
+            : sources(other.sources),
+              num_sources(other.num_sources),
+              owns_sources(other.owns_sources) {
         other.sources = NULL;
     }
 
     SourceCountHitsList& operator=(SourceCountHitsList&& other) {
         num_sources = other.num_sources;
         sources = other.sources;
+        owns_sources = other.owns_sources;
         other.sources = NULL;
         return *this;
     }
@@ -133,19 +146,20 @@ public:
     int total_hits() {
         int total_hits = 0;
         for (int i = 0; i < num_sources; i++) {
-            total_hits += sources[i]->hits;
+            total_hits += sources[i].hits;
         }
         return total_hits;
     }
 
     ~SourceCountHitsList() {
-        if (sources != NULL) {
+        if (sources != NULL && owns_sources) {
             delete_array(num_sources, sources);
         }
     }
 
-    SourceCountHits<S>** sources;
+    SourceCountHits<S>* sources;  // owned if owns_sources is true.
     int num_sources;
+    bool owns_sources;
 };
 
 }  // namespace whatprot
@@ -106,6 +106,36 @@ BOOST_AUTO_TEST_CASE(source_count_source_is_ptr_test) {
     BOOST_TEST(sc.count == 88);
 }
 
+BOOST_AUTO_TEST_CASE(source_count_hits_list_owned_test) {
+    int num_sources = 2;
+    SourceCountHits<int>* sources = new SourceCountHits<int>[num_sources];
+    sources[0] = SourceCountHits<int>(30, 1, 5);
+    sources[1] = SourceCountHits<int>(31, 2, 7);
+    SourceCountHitsList<int> schl(num_sources, sources);
+    BOOST_TEST(schl.num_sources == num_sources);
+    BOOST_TEST(schl.owns_sources == true);
+    BOOST_TEST(schl.sources[1].source == 31);
+    BOOST_TEST(schl.total_hits() == 12);
+}
+
+BOOST_AUTO_TEST_CASE(source_count_hits_list_view_test) {
+    SourceCountHits<int> sources[2];
+    sources[0] = SourceCountHits<int>(30, 1, 5);
+    sources[1] = SourceCountHits<int>(31, 2, 7);
+    {
+        // Goes out of scope first; must not delete the stack array.
+        SourceCountHitsList<int> view(2, sources, false);
+        BOOST_TEST(view.owns_sources == false);
+        BOOST_TEST(view.sources == &sources[0]);
+        SourceCountHitsList<int> copy(view);
+        BOOST_TEST(copy.owns_sources == true);
+        BOOST_TEST(copy.sources != &sources[0]);
+        BOOST_TEST(copy.sources[0].source == 30);
+        BOOST_TEST(copy.total_hits() == 12);
+    }
+    BOOST_TEST(sources[1].hits == 7);
+}
+
 BOOST_AUTO_TEST_SUITE_END()  // sourced_data_suite
 BOOST_AUTO_TEST_SUITE_END()  // common_suite
 
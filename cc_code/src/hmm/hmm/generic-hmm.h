@@ -10,9 +10,12 @@
 #define WHATPROT_HMM_HMM_GENERIC_HMM_H
 
 // Standard C++ library headers:
+#include <cmath>
+#include <limits>
 #include <vector>
 
 // Local project headers:
+#include "hmm/state-vector/state-vector-arena.h"
 #include "hmm/step/step.h"
 #include "parameterization/fit/sequencing-model-fitter.h"
 
@@ -31,27 +34,69 @@ public:
         }
     }
 
-    virtual V* create_states_forward() const = 0;
+    // Give the state vector the shape it needs at the start of the forward
+    // pass, or at the start (i.e., finish) of the backward pass.
+    virtual void resize_states_forward(V* states) const = 0;
 
-    virtual V* create_states_backward() const = 0;
+    virtual void resize_states_backward(V* states) const = 0;
+
+    // Allocating versions of the above. Caller takes ownership.
+    V* create_states_forward() const {
+        V* states = new V();
+        resize_states_forward(states);
+        return states;
+    }
+
+    V* create_states_backward() const {
+        V* states = new V();
+        resize_states_backward(states);
+        return states;
+    }
 
     // This computes the probability of the provided dye seq producing the
     // provided radiometry. To do this efficiently, it uses a modified version
     // of the forward algorithm.
     virtual double probability() const {
+        // Steps ping-pong between the two state vectors of this thread's
+        // arena, so that no memory is allocated in the steady state.
+        StateVectorArena<V>& arena = StateVectorArena<V>::for_this_thread();
+        unsigned int num_edmans = 0;
+        auto step = steps.begin();  // const_iterator type
+        resize_states_forward(arena.in);
+        arena.in->initialize_from_start();
+        while (step != steps.end()) {
+            (*step)->forward(*arena.in, &num_edmans, arena.out);
+            arena.swap();
+            step++;
+        }
+        return arena.in->sum();
+    }
+
+    // This computes the natural log of probability(). The states are rescaled
+    // to sum to one after every step, and the logs of the scaling factors are
+    // accumulated instead (this is the scaled forward algorithm described by
+    // Rabiner). Unlike probability(), this cannot underflow to zero on long
+    // reads. Returns negative infinity if the probability is truly zero.
+    virtual double log_probability() const {
+        StateVectorArena<V>& arena = StateVectorArena<V>::for_this_thread();
         unsigned int num_edmans = 0;
         auto step = steps.begin();  // const_iterator type
-        V* states_in = create_states_forward();
-        states_in->initialize_from_start();
+        resize_states_forward(arena.in);
+        arena.in->initialize_from_start();
+        double log_scale = 0.0;
         while (step != steps.end()) {
-            V* states_out = (*step)->forward(*states_in, &num_edmans);
-            delete states_in;
-            states_in = states_out;
+            (*step)->forward(*arena.in, &num_edmans, arena.out);
+            arena.swap();
+            double scale = arena.in->normalize();
+            if (scale == 0.0) {
+                return -std::numeric_limits<double>::infinity();
+            }
+            log_scale += std::log(scale);
             step++;
         }
-        double result = states_in->sum();
-        delete states_in;
-        return result;
+        // After normalizing, the states sum to one, so all of the probability
+        // is in log_scale.
+        return log_scale;
     }
 
     // This will fit the data the HMM was provided with. It also computes the
@@ -86,24 +131,22 @@ public:
             return probability;
         }
         auto backward_states = backward_sv.end();  // iterator type
-        V* forward_states = create_states_forward();
-        forward_states->initialize_from_start();
+        StateVectorArena<V>& arena = StateVectorArena<V>::for_this_thread();
+        resize_states_forward(arena.in);
+        arena.in->initialize_from_start();
         while (step != steps.end()) {
             backward_states--;
-            (*step)->improve_fit(*forward_states,
+            (*step)->improve_fit(*arena.in,
                                  **backward_states,
                                  **(backward_states - 1),
                                  num_edmans,
                                  probability,
                                  fitter);
             delete *backward_states;
-            V* next_forward_states =
-                    (*step)->forward(*forward_states, &num_edmans);
-            delete forward_states;
-            forward_states = next_forward_states;
+            (*step)->forward(*arena.in, &num_edmans, arena.out);
+            arena.swap();
             step++;
         }
-        delete forward_states;
         delete *(backward_states - 1);
         return probability;
     }
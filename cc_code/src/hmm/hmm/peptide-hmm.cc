@@ -10,13 +10,17 @@
 #include "peptide-hmm.h"
 
 // Standard C++ library headers:
+#include <cmath>
+#include <limits>
 #include <vector>
 
 // Local project headers:
 #include "hmm/precomputations/dye-seq-precomputations.h"
 #include "hmm/precomputations/radiometry-precomputations.h"
 #include "hmm/precomputations/universal-precomputations.h"
+#include "hmm/state-vector/batch-peptide-state-vector.h"
 #include "hmm/state-vector/peptide-state-vector.h"
+#include "hmm/state-vector/state-vector-arena.h"
 #include "hmm/step/bleach-transition.h"
 #include "hmm/step/cyclic-block-transition.h"
 #include "hmm/step/detach-transition.h"
@@ -27,6 +31,8 @@
 namespace whatprot {
 
 namespace {
+using std::log;
+using std::numeric_limits;
 using std::vector;
 }
 
@@ -37,15 +43,19 @@ PeptideHMM::PeptideHMM(
         const RadiometryPrecomputations& radiometry_precomputations,
         const UniversalPrecomputations& universal_precomputations)
         : GenericHMM(num_timesteps), empty_range(false) {
+    timestep_begins.push_back(steps.size());
     steps.push_back(new InitialBrokenNTransition(
             universal_precomputations.initial_broken_n_transition));
     for (unsigned int c = 0; c < num_channels; c++) {
         steps.push_back(new DudTransition(
                 *universal_precomputations.dud_transitions[c]));
     }
-    steps.push_back(new PeptideEmission(
+    vector<PeptideEmission*> emissions;
+    emissions.push_back(new PeptideEmission(
             *radiometry_precomputations.peptide_emissions[0]));
+    steps.push_back(emissions.back());
     for (unsigned int t = 1; t < num_timesteps; t++) {
+        timestep_begins.push_back(steps.size());
         steps.push_back(new CyclicBrokenNTransition(
                 universal_precomputations.cyclic_broken_n_transition));
         steps.push_back(new DetachTransition(
@@ -56,8 +66,9 @@ PeptideHMM::PeptideHMM(
         }
         steps.push_back(
                 new EdmanTransition(dye_seq_precomputations.edman_transition));
-        steps.push_back(new PeptideEmission(
+        emissions.push_back(new PeptideEmission(
                 *radiometry_precomputations.peptide_emissions[t]));
+        steps.push_back(emissions.back());
     }
     // Now we prune to improve efficiency when run.
     KDRange range;
@@ -81,14 +92,19 @@ PeptideHMM::PeptideHMM(
         }
     }
     forward_range = range;
+    log_emission_bounds.resize(num_timesteps, 0.0);
+    for (int t = (int)num_timesteps - 2; t >= 0; t--) {
+        log_emission_bounds[t] = log_emission_bounds[t + 1]
+                                 + log(emissions[t + 1]->max_probability());
+    }
 }
 
-PeptideStateVector* PeptideHMM::create_states_forward() const {
-    return new PeptideStateVector(forward_range);
+void PeptideHMM::resize_states_forward(PeptideStateVector* states) const {
+    states->resize(forward_range);
 }
 
-PeptideStateVector* PeptideHMM::create_states_backward() const {
-    return new PeptideStateVector(backward_range);
+void PeptideHMM::resize_states_backward(PeptideStateVector* states) const {
+    states->resize(backward_range);
 }
 
 double PeptideHMM::probability() const {
@@ -99,4 +115,70 @@ double PeptideHMM::probability() const {
     }
 }
 
+double PeptideHMM::log_probability() const {
+    if (empty_range) {
+        return -numeric_limits<double>::infinity();
+    } else {
+        return GenericHMM::log_probability();
+    }
+}
+
+void PeptideHMM::batch_log_probability(unsigned int batch_size,
+                                       double* log_probabilities) const {
+    if (empty_range) {
+        for (unsigned int b = 0; b < batch_size; b++) {
+            log_probabilities[b] = -numeric_limits<double>::infinity();
+        }
+        return;
+    }
+    // This follows GenericHMM::log_probability(), except that the scaling
+    // factors are per lane. A lane whose probability is zero just accumulates
+    // negative infinity, rather than stopping early like log_probability().
+    StateVectorArena<BatchPeptideStateVector>& arena =
+            StateVectorArena<BatchPeptideStateVector>::for_this_thread();
+    vector<double> scales(batch_size);
+    unsigned int num_edmans = 0;
+    arena.in->resize(forward_range, batch_size);
+    arena.in->initialize_from_start();
+    for (unsigned int b = 0; b < batch_size; b++) {
+        log_probabilities[b] = 0.0;
+    }
+    for (const PeptideStep* step : steps) {
+        step->forward_batch(*arena.in, &num_edmans, arena.out);
+        arena.swap();
+        arena.in->normalize(&scales[0]);
+        for (unsigned int b = 0; b < batch_size; b++) {
+            log_probabilities[b] += log(scales[b]);
+        }
+    }
+}
+
+double PeptideHMM::log_forward_timestep(unsigned int t,
+                                        const PeptideStateVector& input,
+                                        PeptideStateVector* output) const {
+    // Every EdmanTransition before timestep t has been run already.
+    unsigned int num_edmans = (t == 0) ? 0 : t - 1;
+    unsigned int begin = timestep_begins[t];
+    unsigned int end = (t + 1 < num_timesteps) ? timestep_begins[t + 1]
+                                               : steps.size();
+    // Intermediate results go through this thread's arena, with the last step
+    // writing straight into output.
+    StateVectorArena<PeptideStateVector>& arena =
+            StateVectorArena<PeptideStateVector>::for_this_thread();
+    const PeptideStateVector* in = &input;
+    double log_scale = 0.0;
+    for (unsigned int i = begin; i < end; i++) {
+        PeptideStateVector* out = (i + 1 == end) ? output : arena.out;
+        steps[i]->forward(*in, &num_edmans, out);
+        double scale = out->normalize();
+        if (scale == 0.0) {
+            return -numeric_limits<double>::infinity();
+        }
+        log_scale += log(scale);
+        in = out;
+        arena.swap();
+    }
+    return log_scale;
+}
+
 }  // namespace whatprot
@@ -17,6 +17,7 @@
 #include "hmm/precomputations/dye-seq-precomputations.h"
 #include "hmm/precomputations/radiometry-precomputations.h"
 #include "hmm/precomputations/universal-precomputations.h"
+#include "hmm/state-vector/batch-peptide-state-vector.h"
 #include "hmm/state-vector/peptide-state-vector.h"
 #include "hmm/step/peptide-step.h"
 #include "parameterization/fit/sequencing-model-fitter.h"
@@ -31,9 +32,41 @@ public:
                const DyeSeqPrecomputations& dye_seq_precomputations,
                const RadiometryPrecomputations& radiometry_precomputations,
                const UniversalPrecomputations& universal_precomputations);
-    virtual PeptideStateVector* create_states_forward() const override;
-    virtual PeptideStateVector* create_states_backward() const override;
+    virtual void resize_states_forward(
+            PeptideStateVector* states) const override;
+    virtual void resize_states_backward(
+            PeptideStateVector* states) const override;
     virtual double probability() const override;
+    virtual double log_probability() const override;
+    // Same as log_probability(), but for a batch of radiometries at once. The
+    // HMM must have been constructed with batched RadiometryPrecomputations
+    // (see there), and the result for each radiometry in the batch is written
+    // to log_probabilities[lane].
+    void batch_log_probability(unsigned int batch_size,
+                               double* log_probabilities) const;
+    // Runs only the steps for timestep t (see timestep_begins) on input,
+    // writing the result to output. The states are normalized after each step
+    // as in log_probability(), and the log of the product of the scaling
+    // factors is returned, or negative infinity if the states sum to zero. The
+    // input for timestep zero should come from resize_states_forward() and
+    // initialize_from_start(). This must not be used on an HMM with an empty
+    // range.
+    double log_forward_timestep(unsigned int t,
+                                const PeptideStateVector& input,
+                                PeptideStateVector* output) const;
+    // Index in steps of the first step for each timestep. The steps for
+    // timestep t run up to the first step for timestep t + 1, and end with the
+    // PeptideEmission for t.
+    std::vector<unsigned int> timestep_begins;
+    // No step other than a PeptideEmission can increase the total probability
+    // of the states, and a PeptideEmission can at most multiply it by its
+    // largest emission probability within its pruned range. This is the sum of
+    // the logs of those largest probabilities for every timestep after t, so
+    // that the log probability of the states after timestep t plus this entry
+    // is an upper bound on the final log probability. The pruned ranges are
+    // the same for any dye seq with the same tensor_shape, so this is a bound
+    // for all of those too.
+    std::vector<double> log_emission_bounds;
     KDRange forward_range;
     KDRange backward_range;
     bool empty_range;
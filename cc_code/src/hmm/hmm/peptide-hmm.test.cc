@@ -344,6 +344,285 @@ BOOST_AUTO_TEST_CASE(probability_with_cutoff_zero_test, *tolerance(TOL)) {
     BOOST_TEST(hmm.probability() == 0.0);
 }
 
+BOOST_AUTO_TEST_CASE(log_probability_test, *tolerance(TOL)) {
+    unsigned int num_channels = 2;
+    SequencingModel seq_model;
+    seq_model.p_edman_failure = 0.06;
+    seq_model.p_detach.base = 0.05;
+    seq_model.p_detach.initial = 0.03;
+    seq_model.p_detach.initial_decay = 0.04;
+    seq_model.p_initial_block = 0.07;
+    seq_model.p_cyclic_block = 0.025;
+    for (unsigned int i = 0; i < num_channels; i++) {
+        seq_model.channel_models.push_back(new ChannelModel(i, num_channels));
+        seq_model.channel_models[i]->p_bleach = 0.05;
+        seq_model.channel_models[i]->p_dud = 0.07;
+        seq_model.channel_models[i]->bg_sig = 0.00667;
+        seq_model.channel_models[i]->mu = 1.0;
+        seq_model.channel_models[i]->sig = 0.16;
+    }
+    SequencingSettings seq_settings;
+    seq_settings.dist_cutoff = std::numeric_limits<double>::max();
+    unsigned int max_num_dyes = 5;
+    unsigned int num_timesteps = 3;
+    UniversalPrecomputations up(seq_model, num_timesteps, num_channels);
+    up.set_max_num_dyes(max_num_dyes);
+    DyeSeq ds(num_channels, "10.01111");  // two in ch 0, five in ch 1.
+    DyeSeqPrecomputations dsp(ds, seq_model, num_timesteps, num_channels);
+    Radiometry r(num_timesteps, num_channels);
+    r(0, 0) = 2.0;
+    r(0, 1) = 5.0;
+    r(1, 0) = 1.0;
+    r(1, 1) = 5.0;
+    r(2, 0) = 1.0;
+    r(2, 1) = 4.0;
+    RadiometryPrecomputations rp(r, seq_model, seq_settings, max_num_dyes);
+    PeptideHMM hmm(num_timesteps, num_channels, dsp, rp, up);
+    // Should agree with the "no change" result in probability_test.
+    BOOST_TEST(hmm.log_probability() == log(0.039508395241831577));
+}
+
+BOOST_AUTO_TEST_CASE(log_probability_distribution_tails_test, *tolerance(TOL)) {
+    unsigned int num_channels = 2;
+    SequencingModel seq_model;
+    seq_model.p_edman_failure = 0.06;
+    seq_model.p_detach.base = 0.05;
+    seq_model.p_detach.initial = 0.03;
+    seq_model.p_detach.initial_decay = 0.04;
+    seq_model.p_initial_block = 0.07;
+    seq_model.p_cyclic_block = 0.025;
+    for (unsigned int i = 0; i < num_channels; i++) {
+        seq_model.channel_models.push_back(new ChannelModel(i, num_channels));
+        seq_model.channel_models[i]->p_bleach = 0.05;
+        seq_model.channel_models[i]->p_dud = 0.07;
+        seq_model.channel_models[i]->bg_sig = 0.00667;
+        seq_model.channel_models[i]->mu = 1.0;
+        seq_model.channel_models[i]->sig = 0.16;
+    }
+    SequencingSettings seq_settings;
+    seq_settings.dist_cutoff = std::numeric_limits<double>::max();
+    unsigned int max_num_dyes = 5;
+    unsigned int num_timesteps = 3;
+    UniversalPrecomputations up(seq_model, num_timesteps, num_channels);
+    up.set_max_num_dyes(max_num_dyes);
+    DyeSeq ds(num_channels, "10.01111");  // two in ch 0, five in ch 1.
+    DyeSeqPrecomputations dsp(ds, seq_model, num_timesteps, num_channels);
+    Radiometry r(num_timesteps, num_channels);
+    r(0, 0) = 5.0;
+    r(0, 1) = 2.0;
+    r(1, 0) = 5.0;
+    r(1, 1) = 1.0;
+    r(2, 0) = 4.0;
+    r(2, 1) = 1.0;
+    RadiometryPrecomputations rp(r, seq_model, seq_settings, max_num_dyes);
+    PeptideHMM hmm(num_timesteps, num_channels, dsp, rp, up);
+    // Should agree with the "no change" result in
+    // probability_distribution_tails_test, which is tiny but not zero.
+    BOOST_TEST(hmm.log_probability() == log(2.6594025006242441e-96));
+}
+
+BOOST_AUTO_TEST_CASE(log_probability_with_cutoff_zero_test, *tolerance(TOL)) {
+    unsigned int num_channels = 2;
+    SequencingModel seq_model;
+    seq_model.p_edman_failure = 0.06;
+    seq_model.p_detach.base = 0.05;
+    seq_model.p_detach.initial = 0.03;
+    seq_model.p_detach.initial_decay = 0.04;
+    seq_model.p_initial_block = 0.07;
+    seq_model.p_cyclic_block = 0.025;
+    for (unsigned int i = 0; i < num_channels; i++) {
+        seq_model.channel_models.push_back(new ChannelModel(i, num_channels));
+        seq_model.channel_models[i]->p_bleach = 0.05;
+        seq_model.channel_models[i]->p_dud = 0.07;
+        seq_model.channel_models[i]->bg_sig = 0.00667;
+        seq_model.channel_models[i]->mu = 1.0;
+        seq_model.channel_models[i]->sig = 0.16;
+    }
+    SequencingSettings seq_settings;
+    seq_settings.dist_cutoff = 5.0;
+    unsigned int max_num_dyes = 5;
+    unsigned int num_timesteps = 3;
+    UniversalPrecomputations up(seq_model, num_timesteps, num_channels);
+    up.set_max_num_dyes(max_num_dyes);
+    DyeSeq ds(num_channels, "10.01111");  // two in ch 0, five in ch 1.
+    DyeSeqPrecomputations dsp(ds, seq_model, num_timesteps, num_channels);
+    Radiometry r(num_timesteps, num_channels);
+    r(0, 0) = 2.0;
+    r(0, 1) = 1.0;
+    r(1, 0) = 1.0;
+    r(1, 1) = 5.0;
+    r(2, 0) = 1.0;
+    r(2, 1) = 4.0;
+    RadiometryPrecomputations rp(r, seq_model, seq_settings, max_num_dyes);
+    PeptideHMM hmm(num_timesteps, num_channels, dsp, rp, up);
+    // Zero probability should come out as negative infinity.
+    double log_p = hmm.log_probability();
+    BOOST_TEST(std::isinf(log_p));
+    BOOST_TEST(log_p < 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(batch_log_probability_with_cutoff_test, *tolerance(TOL)) {
+    unsigned int num_channels = 2;
+    SequencingModel seq_model;
+    seq_model.p_edman_failure = 0.06;
+    seq_model.p_detach.base = 0.05;
+    seq_model.p_detach.initial = 0.03;
+    seq_model.p_detach.initial_decay = 0.04;
+    seq_model.p_initial_block = 0.07;
+    seq_model.p_cyclic_block = 0.025;
+    for (unsigned int i = 0; i < num_channels; i++) {
+        seq_model.channel_models.push_back(new ChannelModel(i, num_channels));
+        seq_model.channel_models[i]->p_bleach = 0.05;
+        seq_model.channel_models[i]->p_dud = 0.07;
+        seq_model.channel_models[i]->bg_sig = 0.00667;
+        seq_model.channel_models[i]->mu = 1.0;
+        seq_model.channel_models[i]->sig = 0.16;
+    }
+    SequencingSettings seq_settings;
+    seq_settings.dist_cutoff = 5.0;
+    unsigned int max_num_dyes = 5;
+    unsigned int num_timesteps = 3;
+    UniversalPrecomputations up(seq_model, num_timesteps, num_channels);
+    up.set_max_num_dyes(max_num_dyes);
+    DyeSeq ds(num_channels, "10.01111");  // two in ch 0, five in ch 1.
+    DyeSeqPrecomputations dsp(ds, seq_model, num_timesteps, num_channels);
+    // The three radiometries have different pruned ranges, and the second has
+    // a probability of zero.
+    Radiometry r0(num_timesteps, num_channels);
+    r0(0, 0) = 2.0;
+    r0(0, 1) = 5.0;
+    r0(1, 0) = 1.0;
+    r0(1, 1) = 5.0;
+    r0(2, 0) = 1.0;
+    r0(2, 1) = 4.0;
+    Radiometry r1(num_timesteps, num_channels);
+    r1(0, 0) = 2.0;
+    r1(0, 1) = 1.0;
+    r1(1, 0) = 1.0;
+    r1(1, 1) = 5.0;
+    r1(2, 0) = 1.0;
+    r1(2, 1) = 4.0;
+    Radiometry r2(num_timesteps, num_channels);
+    r2(0, 0) = 2.0;
+    r2(0, 1) = 4.0;
+    r2(1, 0) = 2.0;
+    r2(1, 1) = 3.0;
+    r2(2, 0) = 0.0;
+    r2(2, 1) = 3.0;
+    RadiometryPrecomputations rp0(r0, seq_model, seq_settings, max_num_dyes);
+    RadiometryPrecomputations rp1(r1, seq_model, seq_settings, max_num_dyes);
+    RadiometryPrecomputations rp2(r2, seq_model, seq_settings, max_num_dyes);
+    RadiometryPrecomputations batch_rp({&rp0, &rp1, &rp2});
+    PeptideHMM hmm(num_timesteps, num_channels, dsp, batch_rp, up);
+    vector<double> log_ps(3);
+    hmm.batch_log_probability(3, &log_ps[0]);
+    PeptideHMM hmm0(num_timesteps, num_channels, dsp, rp0, up);
+    PeptideHMM hmm2(num_timesteps, num_channels, dsp, rp2, up);
+    BOOST_TEST(log_ps[0] == hmm0.log_probability());
+    BOOST_TEST(std::isinf(log_ps[1]));
+    BOOST_TEST(log_ps[1] < 0.0);
+    BOOST_TEST(log_ps[2] == hmm2.log_probability());
+}
+
+BOOST_AUTO_TEST_CASE(log_forward_timestep_test, *tolerance(TOL)) {
+    unsigned int num_channels = 2;
+    SequencingModel seq_model;
+    seq_model.p_edman_failure = 0.06;
+    seq_model.p_detach.base = 0.05;
+    seq_model.p_detach.initial = 0.03;
+    seq_model.p_detach.initial_decay = 0.04;
+    seq_model.p_initial_block = 0.07;
+    seq_model.p_cyclic_block = 0.025;
+    for (unsigned int i = 0; i < num_channels; i++) {
+        seq_model.channel_models.push_back(new ChannelModel(i, num_channels));
+        seq_model.channel_models[i]->p_bleach = 0.05;
+        seq_model.channel_models[i]->p_dud = 0.07;
+        seq_model.channel_models[i]->bg_sig = 0.00667;
+        seq_model.channel_models[i]->mu = 1.0;
+        seq_model.channel_models[i]->sig = 0.16;
+    }
+    SequencingSettings seq_settings;
+    seq_settings.dist_cutoff = 5.0;
+    unsigned int max_num_dyes = 5;
+    unsigned int num_timesteps = 3;
+    UniversalPrecomputations up(seq_model, num_timesteps, num_channels);
+    up.set_max_num_dyes(max_num_dyes);
+    DyeSeq ds(num_channels, "10.01111");  // two in ch 0, five in ch 1.
+    DyeSeqPrecomputations dsp(ds, seq_model, num_timesteps, num_channels);
+    Radiometry r(num_timesteps, num_channels);
+    r(0, 0) = 2.0;
+    r(0, 1) = 5.0;
+    r(1, 0) = 1.0;
+    r(1, 1) = 5.0;
+    r(2, 0) = 1.0;
+    r(2, 1) = 4.0;
+    RadiometryPrecomputations rp(r, seq_model, seq_settings, max_num_dyes);
+    PeptideHMM hmm(num_timesteps, num_channels, dsp, rp, up);
+    BOOST_REQUIRE(hmm.timestep_begins.size() == num_timesteps);
+    // Initial block, two duds, and an emission for timestep 0.
+    BOOST_TEST(hmm.timestep_begins[0] == 0u);
+    BOOST_TEST(hmm.timestep_begins[1] == 4u);
+    // Cyclic block, detach, two bleaches, Edman, and an emission.
+    BOOST_TEST(hmm.timestep_begins[2] == 10u);
+    PeptideStateVector psv0;
+    hmm.resize_states_forward(&psv0);
+    psv0.initialize_from_start();
+    PeptideStateVector psv1;
+    PeptideStateVector psv2;
+    double log_p = hmm.log_forward_timestep(0, psv0, &psv1);
+    log_p += hmm.log_forward_timestep(1, psv1, &psv2);
+    log_p += hmm.log_forward_timestep(2, psv2, &psv1);
+    BOOST_TEST(log_p == hmm.log_probability());
+}
+
+BOOST_AUTO_TEST_CASE(log_emission_bounds_test, *tolerance(TOL)) {
+    unsigned int num_channels = 2;
+    SequencingModel seq_model;
+    seq_model.p_edman_failure = 0.06;
+    seq_model.p_detach.base = 0.05;
+    seq_model.p_detach.initial = 0.03;
+    seq_model.p_detach.initial_decay = 0.04;
+    seq_model.p_initial_block = 0.07;
+    seq_model.p_cyclic_block = 0.025;
+    for (unsigned int i = 0; i < num_channels; i++) {
+        seq_model.channel_models.push_back(new ChannelModel(i, num_channels));
+        seq_model.channel_models[i]->p_bleach = 0.05;
+        seq_model.channel_models[i]->p_dud = 0.07;
+        seq_model.channel_models[i]->bg_sig = 0.00667;
+        seq_model.channel_models[i]->mu = 1.0;
+        seq_model.channel_models[i]->sig = 0.16;
+    }
+    SequencingSettings seq_settings;
+    seq_settings.dist_cutoff = 5.0;
+    unsigned int max_num_dyes = 5;
+    unsigned int num_timesteps = 3;
+    UniversalPrecomputations up(seq_model, num_timesteps, num_channels);
+    up.set_max_num_dyes(max_num_dyes);
+    DyeSeq ds(num_channels, "10.01111");  // two in ch 0, five in ch 1.
+    DyeSeqPrecomputations dsp(ds, seq_model, num_timesteps, num_channels);
+    Radiometry r(num_timesteps, num_channels);
+    r(0, 0) = 2.0;
+    r(0, 1) = 5.0;
+    r(1, 0) = 1.0;
+    r(1, 1) = 5.0;
+    r(2, 0) = 1.0;
+    r(2, 1) = 4.0;
+    RadiometryPrecomputations rp(r, seq_model, seq_settings, max_num_dyes);
+    PeptideHMM hmm(num_timesteps, num_channels, dsp, rp, up);
+    double log_p = hmm.log_probability();
+    BOOST_REQUIRE(hmm.log_emission_bounds.size() == num_timesteps);
+    BOOST_TEST(hmm.log_emission_bounds[num_timesteps - 1] == 0.0);
+    PeptideStateVector psv0;
+    hmm.resize_states_forward(&psv0);
+    psv0.initialize_from_start();
+    PeptideStateVector psv1;
+    PeptideStateVector psv2;
+    double log_p_0 = hmm.log_forward_timestep(0, psv0, &psv1);
+    BOOST_TEST(log_p_0 + hmm.log_emission_bounds[0] >= log_p);
+    double log_p_1 = log_p_0 + hmm.log_forward_timestep(1, psv1, &psv2);
+    BOOST_TEST(log_p_1 + hmm.log_emission_bounds[1] >= log_p);
+}
+
 BOOST_AUTO_TEST_CASE(improve_fit_test, *tolerance(TOL)) {
     unsigned int num_channels = 2;
     SequencingModel seq_model;
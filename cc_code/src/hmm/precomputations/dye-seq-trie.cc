@@ -0,0 +1,71 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+// Defining symbols from header:
+#include "dye-seq-trie.h"
+
+// Standard C++ library headers:
+#include <map>
+#include <vector>
+
+// Local project headers:
+#include "hmm/precomputations/dye-seq-precomputations.h"
+
+namespace whatprot {
+
+namespace {
+using std::map;
+using std::vector;
+}  // namespace
+
+DyeSeqTrieNode::DyeSeqTrieNode(short dye, int representative)
+        : dye(dye), representative(representative) {}
+
+DyeSeqTrie::DyeSeqTrie(
+        const vector<DyeSeqPrecomputations*>& dye_seq_precomputations,
+        unsigned int num_timesteps)
+        : num_timesteps(num_timesteps) {
+    map<vector<unsigned int>, unsigned int> root_of_shape;
+    for (unsigned int i = 0; i < dye_seq_precomputations.size(); i++) {
+        const DyeSeqPrecomputations& dsp = *dye_seq_precomputations[i];
+        unsigned int node_i;
+        auto root_it = root_of_shape.find(dsp.tensor_shape);
+        if (root_it == root_of_shape.end()) {
+            node_i = nodes.size();
+            nodes.push_back(DyeSeqTrieNode(-1, i));
+            roots.push_back(node_i);
+            root_of_shape[dsp.tensor_shape] = node_i;
+        } else {
+            node_i = root_it->second;
+        }
+        // The EdmanTransition before timestep t uses the amino acid at t - 1.
+        for (unsigned int t = 1; t < num_timesteps; t++) {
+            short dye = dsp.edman_transition.dye_seq[t - 1];
+            // There are at most num_channels + 1 children, so a linear search
+            // is fine.
+            int child_i = -1;
+            for (unsigned int c : nodes[node_i].children) {
+                if (nodes[c].dye == dye) {
+                    child_i = c;
+                    break;
+                }
+            }
+            if (child_i == -1) {
+                child_i = nodes.size();
+                // Careful; this push_back() can invalidate references into
+                // nodes, so we index into it again afterwards.
+                nodes.push_back(DyeSeqTrieNode(dye, i));
+                nodes[node_i].children.push_back(child_i);
+            }
+            node_i = child_i;
+        }
+        nodes[node_i].dye_seq_indices.push_back(i);
+    }
+}
+
+}  // namespace whatprot
@@ -0,0 +1,61 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+#ifndef WHATPROT_HMM_PRECOMPUTATIONS_DYE_SEQ_TRIE_H
+#define WHATPROT_HMM_PRECOMPUTATIONS_DYE_SEQ_TRIE_H
+
+// Standard C++ library headers:
+#include <vector>
+
+// Local project headers:
+#include "hmm/precomputations/dye-seq-precomputations.h"
+
+namespace whatprot {
+
+class DyeSeqTrieNode {
+public:
+    DyeSeqTrieNode(short dye, int representative);
+
+    // Amino acid of the dye seq (as in DyeSeq::operator[]) which led to this
+    // node from its parent. Meaningless for a root.
+    short dye;
+    // Index of the first dye seq to pass through this node. The steps of its
+    // PeptideHMM may be used for every timestep up to that of this node.
+    int representative;
+    // Indices into DyeSeqTrie::nodes.
+    std::vector<unsigned int> children;
+    // Indices of the dye seqs which end at this node. Only leaves have any.
+    std::vector<int> dye_seq_indices;
+};
+
+// Arranges a set of dye seqs into a tree, such that the forward algorithm of
+// the PeptideHMM for each dye seq can be shared between dye seqs for as long as
+// they agree. A node at depth t (with the roots at depth 0) stands for the
+// states after the steps for timestep t (see PeptideHMM::timestep_begins).
+//
+// The shape of the state vectors depends on the number of dyes of each color,
+// so each root holds the dye seqs with one particular tensor_shape. Within
+// that, the only step which depends on the dye seq is the EdmanTransition, and
+// the one before timestep t only looks at the first t amino acids. The pruned
+// ranges of the steps depend only on the tensor_shape and the radiometry, so
+// any two dye seqs under a node run exactly the same steps up to that node.
+class DyeSeqTrie {
+public:
+    DyeSeqTrie(
+            const std::vector<DyeSeqPrecomputations*>& dye_seq_precomputations,
+            unsigned int num_timesteps);
+
+    std::vector<DyeSeqTrieNode> nodes;
+    // Indices into nodes, in the order their dye seqs were first seen.
+    std::vector<unsigned int> roots;
+    unsigned int num_timesteps;
+};
+
+}  // namespace whatprot
+
+#endif  // WHATPROT_HMM_PRECOMPUTATIONS_DYE_SEQ_TRIE_H
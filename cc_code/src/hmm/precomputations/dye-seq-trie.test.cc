@@ -0,0 +1,102 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+// Boost unit test framework (recommended to be the first include):
+#include <boost/test/unit_test.hpp>
+
+// File under test:
+#include "dye-seq-trie.h"
+
+// Standard C++ library headers:
+#include <vector>
+
+// Local project headers:
+#include "common/dye-seq.h"
+#include "hmm/precomputations/dye-seq-precomputations.h"
+#include "parameterization/model/sequencing-model.h"
+
+namespace whatprot {
+
+namespace {
+using std::vector;
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(hmm_suite)
+BOOST_AUTO_TEST_SUITE(precomputations_suite)
+BOOST_AUTO_TEST_SUITE(dye_seq_trie_suite)
+
+BOOST_AUTO_TEST_CASE(constructor_test) {
+    unsigned int num_channels = 2;
+    unsigned int num_timesteps = 4;
+    SequencingModel seq_model;
+    seq_model.p_edman_failure = 0.06;
+    // The first two dye seqs agree until the Edman before the last timestep.
+    // The third has the same start as the first, but a different number of
+    // dyes. The fourth only differs from the first after the last Edman.
+    vector<DyeSeq> dye_seqs;
+    dye_seqs.push_back(DyeSeq(num_channels, ".0.1"));
+    dye_seqs.push_back(DyeSeq(num_channels, ".01"));
+    dye_seqs.push_back(DyeSeq(num_channels, ".0.11"));
+    dye_seqs.push_back(DyeSeq(num_channels, ".0..1"));
+    vector<DyeSeqPrecomputations*> dsps;
+    for (const DyeSeq& dye_seq : dye_seqs) {
+        dsps.push_back(new DyeSeqPrecomputations(
+                dye_seq, seq_model, num_timesteps, num_channels));
+    }
+    DyeSeqTrie trie(dsps, num_timesteps);
+    BOOST_TEST(trie.num_timesteps == num_timesteps);
+    BOOST_REQUIRE(trie.roots.size() == 2u);
+    // First root, for dye seqs 0, 1, and 3.
+    const DyeSeqTrieNode& root0 = trie.nodes[trie.roots[0]];
+    BOOST_TEST(root0.representative == 0);
+    BOOST_TEST(root0.dye_seq_indices.size() == 0u);
+    BOOST_REQUIRE(root0.children.size() == 1u);
+    const DyeSeqTrieNode& n0 = trie.nodes[root0.children[0]];
+    BOOST_TEST(n0.dye == -1);
+    BOOST_TEST(n0.representative == 0);
+    BOOST_REQUIRE(n0.children.size() == 1u);
+    const DyeSeqTrieNode& n00 = trie.nodes[n0.children[0]];
+    BOOST_TEST(n00.dye == 0);
+    BOOST_TEST(n00.representative == 0);
+    BOOST_TEST(n00.dye_seq_indices.size() == 0u);
+    BOOST_REQUIRE(n00.children.size() == 2u);
+    const DyeSeqTrieNode& n000 = trie.nodes[n00.children[0]];
+    BOOST_TEST(n000.dye == -1);
+    BOOST_TEST(n000.representative == 0);
+    BOOST_TEST(n000.children.size() == 0u);
+    BOOST_REQUIRE(n000.dye_seq_indices.size() == 2u);
+    BOOST_TEST(n000.dye_seq_indices[0] == 0);
+    BOOST_TEST(n000.dye_seq_indices[1] == 3);
+    const DyeSeqTrieNode& n001 = trie.nodes[n00.children[1]];
+    BOOST_TEST(n001.dye == 1);
+    BOOST_TEST(n001.representative == 1);
+    BOOST_TEST(n001.children.size() == 0u);
+    BOOST_REQUIRE(n001.dye_seq_indices.size() == 1u);
+    BOOST_TEST(n001.dye_seq_indices[0] == 1);
+    // Second root, for dye seq 2 only.
+    const DyeSeqTrieNode& root1 = trie.nodes[trie.roots[1]];
+    BOOST_TEST(root1.representative == 2);
+    BOOST_REQUIRE(root1.children.size() == 1u);
+    const DyeSeqTrieNode& n1 = trie.nodes[root1.children[0]];
+    BOOST_REQUIRE(n1.children.size() == 1u);
+    const DyeSeqTrieNode& n10 = trie.nodes[n1.children[0]];
+    BOOST_REQUIRE(n10.children.size() == 1u);
+    const DyeSeqTrieNode& n100 = trie.nodes[n10.children[0]];
+    BOOST_TEST(n100.children.size() == 0u);
+    BOOST_REQUIRE(n100.dye_seq_indices.size() == 1u);
+    BOOST_TEST(n100.dye_seq_indices[0] == 2);
+    for (DyeSeqPrecomputations* dsp : dsps) {
+        delete dsp;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // dye_seq_trie_suite
+BOOST_AUTO_TEST_SUITE_END()  // precomputations_suite
+BOOST_AUTO_TEST_SUITE_END()  // hmm_suite
+
+}  // namespace whatprot
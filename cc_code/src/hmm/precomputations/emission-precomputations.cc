@@ -0,0 +1,110 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+// Defining symbols from header:
+#include "emission-precomputations.h"
+
+// Standard C++ library headers:
+#include <cmath>
+#include <vector>
+
+// Local project headers:
+#include "parameterization/model/channel-model.h"
+#include "parameterization/model/sequencing-model.h"
+#include "parameterization/settings/sequencing-settings.h"
+#include "util/fast-exp.h"
+
+namespace whatprot {
+
+namespace {
+using std::exp;
+using std::sqrt;
+using std::vector;
+}  // namespace
+
+EmissionPrecomputations::EmissionPrecomputations(
+        const SequencingModel& seq_model,
+        const SequencingSettings& seq_settings,
+        unsigned int num_channels,
+        unsigned int max_num_dyes)
+        : num_channels(num_channels),
+          max_num_dyes(max_num_dyes),
+          fast_exp(seq_settings.fast_exp),
+          strides(num_channels),
+          mus(num_channels),
+          two_variances(num_channels),
+          scales(num_channels) {
+    unsigned int size = 1;
+    for (int c = (int)num_channels - 1; c >= 0; c--) {
+        strides[c] = size;
+        size *= max_num_dyes + 1;
+    }
+    // Same constant as in ChannelModel::pdf_helper(), so that the results are
+    // exactly the same.
+    static const double pi = 3.141592653589793238;
+    vector<unsigned int> counts(num_channels, 0);
+    for (unsigned int c = 0; c < num_channels; c++) {
+        const ChannelModel& channel_model = *seq_model.channel_models[c];
+        mus[c].resize(size);
+        two_variances[c].resize(size);
+        scales[c].resize(size);
+        for (unsigned int i = 0; i < size; i++) {
+            // Unpack the index into dye counts.
+            unsigned int remainder = i;
+            for (unsigned int d = 0; d < num_channels; d++) {
+                counts[d] = remainder / strides[d];
+                remainder %= strides[d];
+            }
+            double amu = channel_model.adjusted_mu(&counts[0]);
+            double s = channel_model.sigma(amu);
+            mus[c][i] = amu;
+            two_variances[c][i] = 2.0 * s * s;
+            scales[c][i] = 1.0 / (s * sqrt(2.0 * pi));
+        }
+    }
+}
+
+unsigned int EmissionPrecomputations::index(const unsigned int* counts) const {
+    unsigned int i = 0;
+    for (unsigned int c = 0; c < num_channels; c++) {
+        i += strides[c] * counts[c];
+    }
+    return i;
+}
+
+void EmissionPrecomputations::pdf_row(const double* observed,
+                                      const unsigned int* counts,
+                                      unsigned int length,
+                                      double* out) const {
+    unsigned int begin = index(counts);
+    for (unsigned int i = 0; i < length; i++) {
+        out[i] = 1.0;
+    }
+    for (unsigned int c = 0; c < num_channels; c++) {
+        const double* mu = &mus[c][begin];
+        const double* two_variance = &two_variances[c][begin];
+        const double* scale = &scales[c][begin];
+        // The branch is outside of the loops so that each loop is simple
+        // enough to vectorize.
+        if (fast_exp) {
+            for (unsigned int i = 0; i < length; i++) {
+                double offset = observed[c] - mu[i];
+                out[i] *= scale[i]
+                          * whatprot::fast_exp(-offset * offset
+                                               / two_variance[i]);
+            }
+        } else {
+            for (unsigned int i = 0; i < length; i++) {
+                double offset = observed[c] - mu[i];
+                out[i] *= scale[i] * exp(-offset * offset / two_variance[i]);
+            }
+        }
+    }
+}
+
+}  // namespace whatprot
@@ -0,0 +1,61 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+#ifndef WHATPROT_HMM_PRECOMPUTATIONS_EMISSION_PRECOMPUTATIONS_H
+#define WHATPROT_HMM_PRECOMPUTATIONS_EMISSION_PRECOMPUTATIONS_H
+
+// Standard C++ library headers:
+#include <vector>
+
+// Local project headers:
+#include "parameterization/model/sequencing-model.h"
+#include "parameterization/settings/sequencing-settings.h"
+
+namespace whatprot {
+
+// The part of ChannelModel::pdf() which depends only on the dye counts, for
+// every channel and every vector of dye counts up to max_num_dyes. This is the
+// same for every radiometry, so computing it once up front leaves only a few
+// multiplications and an exp() per channel for each emission probability.
+class EmissionPrecomputations {
+public:
+    EmissionPrecomputations(const SequencingModel& seq_model,
+                            const SequencingSettings& seq_settings,
+                            unsigned int num_channels,
+                            unsigned int max_num_dyes);
+    // Index into the tables below for a vector of dye counts, one per channel,
+    // none of which may be more than max_num_dyes.
+    unsigned int index(const unsigned int* counts) const;
+    // Writes the emission probability of the given intensities (one per
+    // channel) to out[i], for the dye counts given by counts with i added to
+    // the count of the last channel, for i from 0 to length - 1. This is the
+    // product over the channels of ChannelModel::pdf(), and is exactly the
+    // same unless fast_exp is set.
+    void pdf_row(const double* observed,
+                 const unsigned int* counts,
+                 unsigned int length,
+                 double* out) const;
+    unsigned int num_channels;
+    unsigned int max_num_dyes;
+    bool fast_exp;
+    // The amount by which index() changes for one more dye of each channel.
+    // The last channel has a stride of one, so that pdf_row() is a walk
+    // through contiguous memory.
+    std::vector<unsigned int> strides;
+    // For each channel c, and for each index() of the dye counts:
+    //   - mus[c][i] is the ChannelModel::adjusted_mu() of the dye counts,
+    //   - two_variances[c][i] is twice the square of the corresponding sigma,
+    //   - scales[c][i] is the normalizing factor of the normal distribution.
+    std::vector<std::vector<double>> mus;
+    std::vector<std::vector<double>> two_variances;
+    std::vector<std::vector<double>> scales;
+};
+
+}  // namespace whatprot
+
+#endif  // WHATPROT_HMM_PRECOMPUTATIONS_EMISSION_PRECOMPUTATIONS_H
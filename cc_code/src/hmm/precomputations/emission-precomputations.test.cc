@@ -0,0 +1,130 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+
+// Boost unit test framework (recommended to be the first include):
+#include <boost/test/unit_test.hpp>
+
+// File under test:
+#include "emission-precomputations.h"
+
+// Standard C++ library headers:
+#include <vector>
+
+// Local project headers:
+#include "parameterization/model/channel-model.h"
+#include "parameterization/model/sequencing-model.h"
+#include "parameterization/settings/sequencing-settings.h"
+
+namespace whatprot {
+
+namespace {
+using boost::unit_test::tolerance;
+using std::vector;
+const double TOL = 0.000000001;
+const double FAST_EXP_TOL = 0.0000001;
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(hmm_suite)
+BOOST_AUTO_TEST_SUITE(precomputations_suite)
+BOOST_AUTO_TEST_SUITE(emission_precomputations_suite)
+
+BOOST_AUTO_TEST_CASE(constructor_test) {
+    unsigned int num_channels = 3;
+    unsigned int max_num_dyes = 4;
+    SequencingModel seq_model;
+    for (unsigned int c = 0; c < num_channels; c++) {
+        seq_model.channel_models.push_back(new ChannelModel(c, num_channels));
+        seq_model.channel_models[c]->bg_sig = 0.05;
+        seq_model.channel_models[c]->mu = 1.0;
+        seq_model.channel_models[c]->sig = 0.16;
+    }
+    SequencingSettings seq_settings;
+    seq_settings.fast_exp = false;
+    EmissionPrecomputations ep(
+            seq_model, seq_settings, num_channels, max_num_dyes);
+    BOOST_TEST(ep.num_channels == num_channels);
+    BOOST_TEST(ep.max_num_dyes == max_num_dyes);
+    BOOST_TEST(ep.fast_exp == false);
+    BOOST_TEST(ep.strides.size() == num_channels);
+    BOOST_TEST(ep.strides[0] == 25u);
+    BOOST_TEST(ep.strides[1] == 5u);
+    BOOST_TEST(ep.strides[2] == 1u);
+    BOOST_TEST(ep.mus.size() == num_channels);
+    BOOST_TEST(ep.mus[0].size() == 125u);
+    vector<unsigned int> counts = {3, 1, 2};
+    BOOST_TEST(ep.index(&counts[0]) == 3u * 25u + 1u * 5u + 2u);
+}
+
+BOOST_AUTO_TEST_CASE(pdf_row_test, *tolerance(TOL)) {
+    unsigned int num_channels = 2;
+    unsigned int max_num_dyes = 3;
+    SequencingModel seq_model;
+    for (unsigned int c = 0; c < num_channels; c++) {
+        seq_model.channel_models.push_back(new ChannelModel(c, num_channels));
+        seq_model.channel_models[c]->bg_sig = 0.05;
+        seq_model.channel_models[c]->mu = 1.0 + 0.1 * c;
+        seq_model.channel_models[c]->sig = 0.16;
+    }
+    // Interactions between the channels make adjusted_mu() depend on every
+    // dye count.
+    seq_model.channel_models[0]->interactions[1] = 0.9;
+    seq_model.channel_models[0]->flat_interactions[1] = 0.95;
+    seq_model.channel_models[1]->interactions[1] = 0.8;
+    SequencingSettings seq_settings;
+    seq_settings.fast_exp = false;
+    EmissionPrecomputations ep(
+            seq_model, seq_settings, num_channels, max_num_dyes);
+    vector<double> observed = {1.3, 2.1};
+    for (unsigned int d = 0; d <= max_num_dyes; d++) {
+        vector<unsigned int> counts = {d, 1};
+        vector<double> out(3);
+        ep.pdf_row(&observed[0], &counts[0], 3, &out[0]);
+        for (unsigned int i = 0; i < 3; i++) {
+            counts[1] = 1 + i;
+            BOOST_TEST(out[i]
+                       == seq_model.channel_models[0]->pdf(observed[0],
+                                                           &counts[0])
+                                  * seq_model.channel_models[1]->pdf(
+                                          observed[1], &counts[0]));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(pdf_row_fast_exp_test, *tolerance(FAST_EXP_TOL)) {
+    unsigned int num_channels = 2;
+    unsigned int max_num_dyes = 3;
+    SequencingModel seq_model;
+    for (unsigned int c = 0; c < num_channels; c++) {
+        seq_model.channel_models.push_back(new ChannelModel(c, num_channels));
+        seq_model.channel_models[c]->bg_sig = 0.05;
+        seq_model.channel_models[c]->mu = 1.0;
+        seq_model.channel_models[c]->sig = 0.16;
+    }
+    SequencingSettings seq_settings;
+    seq_settings.fast_exp = true;
+    EmissionPrecomputations ep(
+            seq_model, seq_settings, num_channels, max_num_dyes);
+    vector<double> observed = {1.3, 1.1};
+    vector<unsigned int> counts = {1, 0};
+    vector<double> out(4);
+    ep.pdf_row(&observed[0], &counts[0], 4, &out[0]);
+    for (unsigned int i = 0; i < 4; i++) {
+        counts[1] = i;
+        double expected =
+                seq_model.channel_models[0]->pdf(observed[0], &counts[0])
+                * seq_model.channel_models[1]->pdf(observed[1], &counts[0]);
+        BOOST_TEST(out[i] / expected == 1.0);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // emission_precomputations_suite
+BOOST_AUTO_TEST_SUITE_END()  // precomputations_suite
+BOOST_AUTO_TEST_SUITE_END()  // hmm_suite
+
+}  // namespace whatprot
@@ -9,14 +9,22 @@
 // Defining symbols from header:
 #include "radiometry-precomputations.h"
 
+// Standard C++ library headers:
+#include <vector>
+
 // Local project headers:
 #include "common/radiometry.h"
+#include "hmm/precomputations/emission-precomputations.h"
 #include "hmm/step/peptide-emission.h"
 #include "parameterization/model/sequencing-model.h"
 #include "parameterization/settings/sequencing-settings.h"
 
 namespace whatprot {
 
+namespace {
+using std::vector;
+}  // namespace
+
 RadiometryPrecomputations::RadiometryPrecomputations(
         const Radiometry& radiometry,
         const SequencingModel& seq_model,
@@ -28,6 +36,34 @@ RadiometryPrecomputations::RadiometryPrecomputations(
     }
 }
 
+RadiometryPrecomputations::RadiometryPrecomputations(
+        const Radiometry& radiometry,
+        const SequencingModel& seq_model,
+        const SequencingSettings& seq_settings,
+        const EmissionPrecomputations& emission_precomputations)
+        : RadiometryPrecomputations(radiometry,
+                                    seq_model,
+                                    seq_settings,
+                                    emission_precomputations.max_num_dyes) {
+    // Nothing has been computed yet (see PeptideEmission::ensure_computed()),
+    // so it's not too late to switch to the tables.
+    for (PeptideEmission* emission : peptide_emissions) {
+        emission->emission_precomputations = &emission_precomputations;
+    }
+}
+
+RadiometryPrecomputations::RadiometryPrecomputations(
+        const vector<const RadiometryPrecomputations*>& batch) {
+    unsigned int num_timesteps = batch[0]->peptide_emissions.size();
+    for (unsigned int t = 0; t < num_timesteps; t++) {
+        vector<const PeptideEmission*> emissions;
+        for (const RadiometryPrecomputations* precomputations : batch) {
+            emissions.push_back(precomputations->peptide_emissions[t]);
+        }
+        peptide_emissions.push_back(new PeptideEmission(emissions));
+    }
+}
+
 RadiometryPrecomputations::~RadiometryPrecomputations() {
     for (PeptideEmission* step : peptide_emissions) {
         delete step;
@@ -14,6 +14,7 @@
 
 // Local project headers:
 #include "common/radiometry.h"
+#include "hmm/precomputations/emission-precomputations.h"
 #include "hmm/step/peptide-emission.h"
 #include "parameterization/model/sequencing-model.h"
 #include "parameterization/settings/sequencing-settings.h"
@@ -26,6 +27,19 @@ public:
                               const SequencingModel& seq_model,
                               const SequencingSettings& seq_settings,
                               unsigned int max_num_dyes);
+    // Same as above, except that the emission probabilities are computed from
+    // the tables in emission_precomputations (which knows max_num_dyes), which
+    // is much faster. It must outlive this.
+    RadiometryPrecomputations(
+            const Radiometry& radiometry,
+            const SequencingModel& seq_model,
+            const SequencingSettings& seq_settings,
+            const EmissionPrecomputations& emission_precomputations);
+    // Batches the emissions of several radiometries together, for use with
+    // BatchPeptideStateVector. The radiometries must all have the same number
+    // of timesteps. See the batched constructor of PeptideEmission.
+    RadiometryPrecomputations(
+            const std::vector<const RadiometryPrecomputations*>& batch);
     ~RadiometryPrecomputations();
     std::vector<PeptideEmission*> peptide_emissions;
 };
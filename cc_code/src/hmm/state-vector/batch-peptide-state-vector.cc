@@ -0,0 +1,115 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+// Defining symbols from header:
+#include "batch-peptide-state-vector.h"
+
+// Standard C++ library headers:
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// Local project headers:
+#include "tensor/range-loop.h"
+#include "tensor/tensor.h"
+#include "util/kd-range.h"
+
+namespace whatprot {
+
+namespace {
+using std::ldexp;
+using std::numeric_limits;
+}  // namespace
+
+BatchPeptideStateVector::BatchPeptideStateVector()
+        : batch_size(0), allow_detached(true) {}
+
+KDRange BatchPeptideStateVector::batch_range(const KDRange& range,
+                                             unsigned int batch_size) {
+    KDRange result = range;
+    result.min.push_back(0);
+    result.max.push_back(batch_size);
+    return result;
+}
+
+void BatchPeptideStateVector::resize(const KDRange& range,
+                                     unsigned int batch_size) {
+    KDRange tensor_range = batch_range(range, batch_size);
+    tensor.resize(tensor_range);
+    broken_n_tensor.resize(tensor_range);
+    this->range = range;
+    this->batch_size = batch_size;
+    p_detached.assign(batch_size, 0.0);
+    allow_detached = true;
+}
+
+void BatchPeptideStateVector::initialize_from_start() {
+    // The tensors may have been resized rather than newly constructed, so we
+    // can't assume they are zeroed.
+    for (unsigned int i = 0; i < tensor.size; i++) {
+        tensor.values[i] = 0.0;
+    }
+    for (unsigned int i = 0; i < broken_n_tensor.size; i++) {
+        broken_n_tensor.values[i] = 0.0;
+    }
+    // The starting state is the last location of the first timestep, for
+    // which the lanes are the last batch_size entries.
+    for (unsigned int b = 0; b < batch_size; b++) {
+        p_detached[b] = 0.0;
+        tensor.values[tensor.strides[0] - batch_size + b] = 1.0;
+    }
+}
+
+void BatchPeptideStateVector::sum(double* sums) const {
+    for (unsigned int b = 0; b < batch_size; b++) {
+        sums[b] = p_detached[b];
+    }
+    KDRange tensor_range = batch_range(range, batch_size);
+    dispatch_order(tensor_range.min.size(), [&](auto o) {
+        const unsigned int ORDER = decltype(o)::value;
+        for_each_row<ORDER>(
+                tensor_range,
+                [&](const unsigned int* loc, unsigned int length) {
+                    // Both tensors always have the same shape.
+                    unsigned int i = tensor.offset<ORDER>(loc);
+                    const double* row = &tensor.values[i];
+                    const double* n_row = &broken_n_tensor.values[i];
+                    for (unsigned int b = 0; b < length; b++) {
+                        sums[b] += row[b] + n_row[b];
+                    }
+                });
+    });
+}
+
+void BatchPeptideStateVector::normalize(double* sums) {
+    sum(sums);
+    for (unsigned int b = 0; b < batch_size; b++) {
+        if (sums[b] == 0.0) {
+            continue;
+        }
+        // See PeptideStateVector::normalize() regarding pre_factor.
+        double pre_factor = 1.0;
+        if (sums[b] < numeric_limits<double>::min()) {
+            pre_factor = ldexp(1.0, 600);
+        }
+        double factor = 1.0 / (sums[b] * pre_factor);
+        // Values outside of range are never read, so it is simpler and faster
+        // to scale the whole tensor than to iterate over the range. Lane b is
+        // every batch_size-th value, starting from b.
+        for (unsigned int i = b; i < tensor.size; i += batch_size) {
+            tensor.values[i] = tensor.values[i] * pre_factor * factor;
+        }
+        for (unsigned int i = b; i < broken_n_tensor.size; i += batch_size) {
+            broken_n_tensor.values[i] =
+                    broken_n_tensor.values[i] * pre_factor * factor;
+        }
+        p_detached[b] = p_detached[b] * pre_factor * factor;
+    }
+}
+
+}  // namespace whatprot
@@ -0,0 +1,57 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+#ifndef WHATPROT_HMM_STATE_VECTOR_BATCH_PEPTIDE_STATE_VECTOR_H
+#define WHATPROT_HMM_STATE_VECTOR_BATCH_PEPTIDE_STATE_VECTOR_H
+
+// Standard C++ library headers:
+#include <vector>
+
+// Local project headers:
+#include "tensor/tensor.h"
+#include "util/kd-range.h"
+
+namespace whatprot {
+
+// The state vectors for a batch of radiometries being run through the same
+// PeptideHMM at once. Each radiometry in the batch gets a "lane". The tensors
+// are like those of a PeptideStateVector, but with one extra dimension at the
+// end indexing the lane. Putting the lanes last makes them contiguous in
+// memory, so that a step can do the same work on every lane with one simple
+// loop that the compiler is able to vectorize.
+class BatchPeptideStateVector {
+public:
+    // The default constructor gives an empty state vector, which should be
+    // given a range with resize() before use.
+    BatchPeptideStateVector();
+    // Gives range with an extra dimension from 0 to batch_size at the end,
+    // i.e., the range of the tensors of a BatchPeptideStateVector.
+    static KDRange batch_range(const KDRange& range, unsigned int batch_size);
+    // Reshape to the given range (without the lane dimension) and number of
+    // lanes, reusing memory where possible (see Tensor::resize()). The
+    // detached states are reset, and the tensor values are left unspecified.
+    void resize(const KDRange& range, unsigned int batch_size);
+    // Put 1.0 in the starting state of every lane.
+    void initialize_from_start();
+    // Sum of the states of each lane, written to sums[lane].
+    void sum(double* sums) const;
+    // Divide the states of each lane by the sum of that lane's states, writing
+    // those sums to sums[lane]. Lanes with a sum of zero are left unchanged.
+    void normalize(double* sums);
+
+    Tensor tensor;
+    Tensor broken_n_tensor;
+    KDRange range;  // does not include the lane dimension.
+    std::vector<double> p_detached;  // probability of detached state per lane.
+    unsigned int batch_size;
+    bool allow_detached;  // detached state "in range"
+};
+
+}  // namespace whatprot
+
+#endif  // WHATPROT_HMM_STATE_VECTOR_BATCH_PEPTIDE_STATE_VECTOR_H
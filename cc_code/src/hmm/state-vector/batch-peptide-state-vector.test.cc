@@ -0,0 +1,161 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+// Boost unit test framework (recommended to be the first include):
+#include <boost/test/unit_test.hpp>
+
+// File under test:
+#include "batch-peptide-state-vector.h"
+
+// Standard C++ library headers:
+#include <vector>
+
+// Local project headers:
+#include "util/kd-range.h"
+
+namespace whatprot {
+
+namespace {
+using boost::unit_test::tolerance;
+using std::vector;
+const double TOL = 0.000000001;
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(hmm_suite)
+BOOST_AUTO_TEST_SUITE(state_vector_suite)
+BOOST_AUTO_TEST_SUITE(batch_peptide_state_vector_suite)
+
+BOOST_AUTO_TEST_CASE(constructor_test) {
+    BatchPeptideStateVector bpsv;
+    BOOST_TEST(bpsv.batch_size == 0u);
+    BOOST_TEST(bpsv.p_detached.size() == 0u);
+    BOOST_TEST(bpsv.allow_detached == true);
+}
+
+BOOST_AUTO_TEST_CASE(batch_range_test) {
+    KDRange range;
+    range.min = {1, 2};
+    range.max = {3, 4};
+    KDRange result = BatchPeptideStateVector::batch_range(range, 5);
+    BOOST_TEST(result.min.size() == 3u);
+    BOOST_TEST(result.min[0] == 1u);
+    BOOST_TEST(result.min[1] == 2u);
+    BOOST_TEST(result.min[2] == 0u);
+    BOOST_TEST(result.max.size() == 3u);
+    BOOST_TEST(result.max[0] == 3u);
+    BOOST_TEST(result.max[1] == 4u);
+    BOOST_TEST(result.max[2] == 5u);
+}
+
+BOOST_AUTO_TEST_CASE(resize_test) {
+    BatchPeptideStateVector bpsv;
+    bpsv.allow_detached = false;
+    KDRange range;
+    range.min = {1, 2};
+    range.max = {3, 4};
+    bpsv.resize(range, 3);
+    BOOST_TEST(bpsv.range.min.size() == 2u);
+    BOOST_TEST(bpsv.range.min[0] == 1u);
+    BOOST_TEST(bpsv.range.min[1] == 2u);
+    BOOST_TEST(bpsv.range.max.size() == 2u);
+    BOOST_TEST(bpsv.range.max[0] == 3u);
+    BOOST_TEST(bpsv.range.max[1] == 4u);
+    BOOST_TEST(bpsv.tensor.order == 3u);
+    BOOST_TEST(bpsv.tensor.size == 12u);
+    BOOST_TEST(bpsv.broken_n_tensor.size == 12u);
+    BOOST_TEST(bpsv.batch_size == 3u);
+    BOOST_TEST(bpsv.p_detached.size() == 3u);
+    BOOST_TEST(bpsv.p_detached[0] == 0.0);
+    BOOST_TEST(bpsv.p_detached[1] == 0.0);
+    BOOST_TEST(bpsv.p_detached[2] == 0.0);
+    BOOST_TEST(bpsv.allow_detached == true);
+}
+
+BOOST_AUTO_TEST_CASE(initialize_from_start_test) {
+    BatchPeptideStateVector bpsv;
+    KDRange range;
+    range.min = {0, 0};
+    range.max = {2, 2};
+    bpsv.resize(range, 2);
+    bpsv.tensor.values[0] = 0.7;
+    bpsv.broken_n_tensor.values[0] = 0.3;
+    bpsv.p_detached[1] = 0.2;
+    bpsv.initialize_from_start();
+    BOOST_TEST((bpsv.tensor[{0, 0, 0}]) == 0.0);
+    BOOST_TEST((bpsv.tensor[{0, 0, 1}]) == 0.0);
+    BOOST_TEST((bpsv.tensor[{0, 1, 0}]) == 1.0);
+    BOOST_TEST((bpsv.tensor[{0, 1, 1}]) == 1.0);
+    BOOST_TEST((bpsv.tensor[{1, 0, 0}]) == 0.0);
+    BOOST_TEST((bpsv.tensor[{1, 0, 1}]) == 0.0);
+    BOOST_TEST((bpsv.tensor[{1, 1, 0}]) == 0.0);
+    BOOST_TEST((bpsv.tensor[{1, 1, 1}]) == 0.0);
+    for (unsigned int i = 0; i < bpsv.broken_n_tensor.size; i++) {
+        BOOST_TEST(bpsv.broken_n_tensor.values[i] == 0.0);
+    }
+    BOOST_TEST(bpsv.p_detached[0] == 0.0);
+    BOOST_TEST(bpsv.p_detached[1] == 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(sum_test, *tolerance(TOL)) {
+    BatchPeptideStateVector bpsv;
+    KDRange range;
+    range.min = {0, 0};
+    range.max = {1, 2};
+    bpsv.resize(range, 2);
+    bpsv.tensor[{0, 0, 0}] = 0.1;
+    bpsv.tensor[{0, 0, 1}] = 0.2;
+    bpsv.tensor[{0, 1, 0}] = 0.3;
+    bpsv.tensor[{0, 1, 1}] = 0.4;
+    bpsv.broken_n_tensor[{0, 0, 0}] = 0.5;
+    bpsv.broken_n_tensor[{0, 0, 1}] = 0.6;
+    bpsv.broken_n_tensor[{0, 1, 0}] = 0.7;
+    bpsv.broken_n_tensor[{0, 1, 1}] = 0.8;
+    bpsv.p_detached[0] = 0.9;
+    bpsv.p_detached[1] = 1.1;
+    vector<double> sums(2);
+    bpsv.sum(&sums[0]);
+    BOOST_TEST(sums[0] == 0.1 + 0.3 + 0.5 + 0.7 + 0.9);
+    BOOST_TEST(sums[1] == 0.2 + 0.4 + 0.6 + 0.8 + 1.1);
+}
+
+BOOST_AUTO_TEST_CASE(normalize_test, *tolerance(TOL)) {
+    BatchPeptideStateVector bpsv;
+    KDRange range;
+    range.min = {0, 0};
+    range.max = {1, 2};
+    bpsv.resize(range, 2);
+    bpsv.tensor[{0, 0, 0}] = 0.1;
+    bpsv.tensor[{0, 0, 1}] = 0.0;
+    bpsv.tensor[{0, 1, 0}] = 0.3;
+    bpsv.tensor[{0, 1, 1}] = 0.0;
+    bpsv.broken_n_tensor[{0, 0, 0}] = 0.5;
+    bpsv.broken_n_tensor[{0, 0, 1}] = 0.0;
+    bpsv.broken_n_tensor[{0, 1, 0}] = 0.7;
+    bpsv.broken_n_tensor[{0, 1, 1}] = 0.0;
+    bpsv.p_detached[0] = 0.4;
+    bpsv.p_detached[1] = 0.0;
+    vector<double> sums(2);
+    bpsv.normalize(&sums[0]);
+    BOOST_TEST(sums[0] == 2.0);
+    BOOST_TEST(sums[1] == 0.0);
+    BOOST_TEST((bpsv.tensor[{0, 0, 0}]) == 0.05);
+    BOOST_TEST((bpsv.tensor[{0, 1, 0}]) == 0.15);
+    BOOST_TEST((bpsv.broken_n_tensor[{0, 0, 0}]) == 0.25);
+    BOOST_TEST((bpsv.broken_n_tensor[{0, 1, 0}]) == 0.35);
+    BOOST_TEST(bpsv.p_detached[0] == 0.2);
+    // A lane which sums to zero is left as it is.
+    BOOST_TEST((bpsv.tensor[{0, 0, 1}]) == 0.0);
+    BOOST_TEST((bpsv.tensor[{0, 1, 1}]) == 0.0);
+    BOOST_TEST(bpsv.p_detached[1] == 0.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // batch_peptide_state_vector_suite
+BOOST_AUTO_TEST_SUITE_END()  // state_vector_suite
+BOOST_AUTO_TEST_SUITE_END()  // hmm_suite
+
+}  // namespace whatprot
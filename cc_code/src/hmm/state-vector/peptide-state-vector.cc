@@ -10,6 +10,8 @@
 #include "peptide-state-vector.h"
 
 // Standard C++ library headers:
+#include <cmath>
+#include <limits>
 #include <vector>
 
 // Local project headers:
@@ -17,6 +19,11 @@
 
 namespace whatprot {
 
+namespace {
+using std::ldexp;
+using std::numeric_limits;
+}  // namespace
+
 PeptideStateVector::PeptideStateVector(unsigned int order,
                                        const unsigned int* shape)
         : tensor(order, shape),
@@ -35,7 +42,27 @@ PeptideStateVector::PeptideStateVector(const KDRange& range)
           p_detached(0.0),
           allow_detached(true) {}
 
+PeptideStateVector::PeptideStateVector()
+        : p_detached(0.0), allow_detached(true) {}
+
+void PeptideStateVector::resize(const KDRange& range) {
+    tensor.resize(range);
+    broken_n_tensor.resize(range);
+    this->range = range;
+    p_detached = 0.0;
+    allow_detached = true;
+}
+
 void PeptideStateVector::initialize_from_start() {
+    // The tensors may have been resized rather than newly constructed, so we
+    // can't assume they are zeroed.
+    for (unsigned int i = 0; i < tensor.size; i++) {
+        tensor.values[i] = 0.0;
+    }
+    for (unsigned int i = 0; i < broken_n_tensor.size; i++) {
+        broken_n_tensor.values[i] = 0.0;
+    }
+    p_detached = 0.0;
     tensor.values[tensor.strides[0] - 1] = 1.0;
 }
 
@@ -57,4 +84,30 @@ double PeptideStateVector::source() const {
     return tensor.values[tensor.strides[0] - 1];
 }
 
+double PeptideStateVector::normalize() {
+    double total = sum();
+    if (total == 0.0) {
+        return total;
+    }
+    // If total is subnormal then 1.0 / total overflows to infinity, so we
+    // first scale by a power of two, which is exact. Otherwise the extra
+    // multiplication is by one, which is also exact.
+    double pre_factor = 1.0;
+    if (total < numeric_limits<double>::min()) {
+        pre_factor = ldexp(1.0, 600);
+    }
+    double factor = 1.0 / (total * pre_factor);
+    // Values outside of range are never read, so it is simpler and faster to
+    // scale the whole tensor than to iterate over the range.
+    for (unsigned int i = 0; i < tensor.size; i++) {
+        tensor.values[i] = tensor.values[i] * pre_factor * factor;
+    }
+    for (unsigned int i = 0; i < broken_n_tensor.size; i++) {
+        broken_n_tensor.values[i] =
+                broken_n_tensor.values[i] * pre_factor * factor;
+    }
+    p_detached = p_detached * pre_factor * factor;
+    return total;
+}
+
 }  // namespace whatprot
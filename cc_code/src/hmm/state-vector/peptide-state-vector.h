@@ -24,6 +24,13 @@ public:
     // of the underlying tensor.
     PeptideStateVector(unsigned int order, const unsigned int* shape);
     PeptideStateVector(const KDRange& range);
+    // The default constructor gives an empty state vector, which should be
+    // given a range with resize() before use.
+    PeptideStateVector();
+    // Reshape to the given range, reusing memory where possible (see
+    // Tensor::resize()). The detached state is reset as if newly constructed,
+    // but the tensor values are left unspecified.
+    void resize(const KDRange& range);
     // Put 1.0 in starting state.
     void initialize_from_start();
     // Put 1.0 in every state.
@@ -32,6 +39,9 @@ public:
     double sum() const;
     // Probability of the original source state.
     double source() const;
+    // Divide every state by the sum of the states, returning that sum. This is
+    // a no-op when the sum is zero.
+    double normalize();
 
     Tensor tensor;
     Tensor broken_n_tensor;
@@ -12,8 +12,16 @@
 // File under test:
 #include "peptide-state-vector.h"
 
+// Local project headers:
+#include "util/kd-range.h"
+
 namespace whatprot {
 
+namespace {
+using boost::unit_test::tolerance;
+const double TOL = 0.000000001;
+}  // namespace
+
 BOOST_AUTO_TEST_SUITE(hmm_suite)
 BOOST_AUTO_TEST_SUITE(state_vector_suite)
 BOOST_AUTO_TEST_SUITE(peptide_state_vector_suite)
@@ -37,6 +45,49 @@ BOOST_AUTO_TEST_CASE(constructor_test) {
     BOOST_TEST(psv.allow_detached == true);
 }
 
+BOOST_AUTO_TEST_CASE(resize_test) {
+    unsigned int order = 2;
+    unsigned int* shape = new unsigned int[order];
+    shape[0] = 5;
+    shape[1] = 5;
+    PeptideStateVector psv(order, shape);
+    delete[] shape;
+    psv.p_detached = 0.5;
+    psv.allow_detached = false;
+    KDRange range;
+    range.min = {1, 2};
+    range.max = {3, 4};
+    psv.resize(range);
+    BOOST_TEST(psv.range.min[0] == 1u);
+    BOOST_TEST(psv.range.min[1] == 2u);
+    BOOST_TEST(psv.range.max[0] == 3u);
+    BOOST_TEST(psv.range.max[1] == 4u);
+    BOOST_TEST(psv.tensor.size == 4u);
+    BOOST_TEST(psv.broken_n_tensor.size == 4u);
+    BOOST_TEST(psv.p_detached == 0.0);
+    BOOST_TEST(psv.allow_detached == true);
+}
+
+BOOST_AUTO_TEST_CASE(initialize_from_start_after_resize_test) {
+    unsigned int order = 2;
+    unsigned int* shape = new unsigned int[order];
+    shape[0] = 2;
+    shape[1] = 2;
+    PeptideStateVector psv(order, shape);
+    delete[] shape;
+    psv.tensor.values[0] = 0.7;
+    psv.broken_n_tensor.values[0] = 0.3;
+    KDRange range;
+    range.min = {0, 0};
+    range.max = {1, 2};
+    psv.resize(range);
+    psv.initialize_from_start();
+    BOOST_TEST(psv.tensor.values[0] == 0.0);
+    BOOST_TEST(psv.tensor.values[1] == 1.0);
+    BOOST_TEST(psv.broken_n_tensor.values[0] == 0.0);
+    BOOST_TEST(psv.broken_n_tensor.values[1] == 0.0);
+}
+
 BOOST_AUTO_TEST_CASE(initialize_from_start_test) {
     unsigned int order = 3;
     unsigned int* shape = new unsigned int[order];
@@ -99,6 +150,56 @@ BOOST_AUTO_TEST_CASE(source_test) {
     BOOST_TEST(psv.source() == 1.23456789);
 }
 
+BOOST_AUTO_TEST_CASE(normalize_test, *tolerance(TOL)) {
+    unsigned int order = 2;
+    unsigned int* shape = new unsigned int[order];
+    shape[0] = 1;
+    shape[1] = 2;
+    PeptideStateVector psv(order, shape);
+    delete[] shape;
+    psv.tensor.values[0] = 1.0;
+    psv.tensor.values[1] = 2.0;
+    psv.broken_n_tensor.values[0] = 3.0;
+    psv.broken_n_tensor.values[1] = 4.0;
+    psv.p_detached = 10.0;
+    BOOST_TEST(psv.normalize() == 20.0);
+    BOOST_TEST(psv.tensor.values[0] == 0.05);
+    BOOST_TEST(psv.tensor.values[1] == 0.1);
+    BOOST_TEST(psv.broken_n_tensor.values[0] == 0.15);
+    BOOST_TEST(psv.broken_n_tensor.values[1] == 0.2);
+    BOOST_TEST(psv.p_detached == 0.5);
+}
+
+BOOST_AUTO_TEST_CASE(normalize_subnormal_test, *tolerance(TOL)) {
+    unsigned int order = 2;
+    unsigned int* shape = new unsigned int[order];
+    shape[0] = 1;
+    shape[1] = 2;
+    PeptideStateVector psv(order, shape);
+    delete[] shape;
+    // The sum of these is small enough that one over it is infinite.
+    psv.tensor.values[0] = 1e-310;
+    psv.tensor.values[1] = 3e-310;
+    psv.p_detached = 0.0;
+    BOOST_TEST(psv.normalize() == 4e-310);
+    BOOST_TEST(psv.tensor.values[0] == 0.25);
+    BOOST_TEST(psv.tensor.values[1] == 0.75);
+    BOOST_TEST(psv.p_detached == 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(normalize_zero_test) {
+    unsigned int order = 2;
+    unsigned int* shape = new unsigned int[order];
+    shape[0] = 1;
+    shape[1] = 2;
+    PeptideStateVector psv(order, shape);
+    delete[] shape;
+    BOOST_TEST(psv.normalize() == 0.0);
+    BOOST_TEST(psv.tensor.values[0] == 0.0);
+    BOOST_TEST(psv.tensor.values[1] == 0.0);
+    BOOST_TEST(psv.p_detached == 0.0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()  // peptide_state_vector_suite
 BOOST_AUTO_TEST_SUITE_END()  // state_vector_suite
 BOOST_AUTO_TEST_SUITE_END()  // hmm_suite
@@ -0,0 +1,50 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+#ifndef WHATPROT_HMM_STATE_VECTOR_STATE_VECTOR_ARENA_H
+#define WHATPROT_HMM_STATE_VECTOR_STATE_VECTOR_ARENA_H
+
+// Standard C++ library headers:
+#include <utility>
+
+namespace whatprot {
+
+// Owns a pair of state vectors to be used for a forward (or backward) pass of
+// an HMM. Each step reads from one and writes into the other, and then the two
+// swap roles. State vectors only reallocate their memory when they need to
+// grow, so once an arena has been used on the largest HMM it will see, further
+// use of the arena is allocation-free.
+//
+// V is the state vector type.
+template <typename V>
+class StateVectorArena {
+public:
+    StateVectorArena() : in(&ping), out(&pong) {}
+
+    // Arenas are not thread-safe, so each thread needs its own. This gives the
+    // arena for the calling thread, which lives until that thread exits. It
+    // must not be used by two passes at once, i.e., by nested calls.
+    static StateVectorArena& for_this_thread() {
+        static thread_local StateVectorArena arena;
+        return arena;
+    }
+
+    // Exchange the roles of in and out.
+    void swap() {
+        std::swap(in, out);
+    }
+
+    V ping;
+    V pong;
+    V* in;  // points to either ping or pong.
+    V* out;  // points to whichever of ping or pong in does not.
+};
+
+}  // namespace whatprot
+
+#endif  // WHATPROT_HMM_STATE_VECTOR_STATE_VECTOR_ARENA_H
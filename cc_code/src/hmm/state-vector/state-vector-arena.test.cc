@@ -0,0 +1,52 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+// Boost unit test framework (recommended to be the first include):
+#include <boost/test/unit_test.hpp>
+
+// File under test:
+#include "state-vector-arena.h"
+
+// Local project headers:
+#include "hmm/state-vector/peptide-state-vector.h"
+
+namespace whatprot {
+
+BOOST_AUTO_TEST_SUITE(hmm_suite)
+BOOST_AUTO_TEST_SUITE(state_vector_suite)
+BOOST_AUTO_TEST_SUITE(state_vector_arena_suite)
+
+BOOST_AUTO_TEST_CASE(constructor_test) {
+    StateVectorArena<PeptideStateVector> arena;
+    BOOST_TEST(arena.in == &arena.ping);
+    BOOST_TEST(arena.out == &arena.pong);
+}
+
+BOOST_AUTO_TEST_CASE(swap_test) {
+    StateVectorArena<PeptideStateVector> arena;
+    arena.swap();
+    BOOST_TEST(arena.in == &arena.pong);
+    BOOST_TEST(arena.out == &arena.ping);
+    arena.swap();
+    BOOST_TEST(arena.in == &arena.ping);
+    BOOST_TEST(arena.out == &arena.pong);
+}
+
+BOOST_AUTO_TEST_CASE(for_this_thread_test) {
+    StateVectorArena<PeptideStateVector>& arena1 =
+            StateVectorArena<PeptideStateVector>::for_this_thread();
+    StateVectorArena<PeptideStateVector>& arena2 =
+            StateVectorArena<PeptideStateVector>::for_this_thread();
+    BOOST_TEST(&arena1 == &arena2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // state_vector_arena_suite
+BOOST_AUTO_TEST_SUITE_END()  // state_vector_suite
+BOOST_AUTO_TEST_SUITE_END()  // hmm_suite
+
+}  // namespace whatprot
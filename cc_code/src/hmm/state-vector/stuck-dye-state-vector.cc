@@ -33,4 +33,14 @@ double StuckDyeStateVector::source() const {
     return dye;
 }
 
+double StuckDyeStateVector::normalize() {
+    double total = sum();
+    if (total == 0.0) {
+        return total;
+    }
+    dye /= total;
+    no_dye /= total;
+    return total;
+}
+
 }  // namespace whatprot
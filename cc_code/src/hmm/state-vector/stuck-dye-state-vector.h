@@ -30,6 +30,9 @@ public:
     double sum() const;
     // Probability of the original source state.
     double source() const;
+    // Divide every state by the sum of the states, returning that sum. This is
+    // a no-op when the sum is zero.
+    double normalize();
 
     double dye;
     double no_dye;
@@ -10,11 +10,14 @@
 #include "binomial-transition.h"
 
 // Standard C++ library headers:
+#include <algorithm>
 #include <limits>
 
 // Local project headers:
+#include "hmm/state-vector/batch-peptide-state-vector.h"
 #include "hmm/state-vector/peptide-state-vector.h"
 #include "parameterization/fit/parameter-fitter.h"
+#include "tensor/range-loop.h"
 #include "tensor/tensor.h"
 #include "tensor/vector.h"
 #include "util/kd-range.h"
@@ -22,8 +25,48 @@
 namespace whatprot {
 
 namespace {
+using std::max;
+using std::min;
 using std::numeric_limits;
 using std::vector;
+
+// Calls f(in_base, out_base, length) once for every "lane" of range, where a
+// lane is a contiguous run of entries in the innermost dimension, with the
+// location in dimension dim left out. The entry with count x in dimension dim
+// for the k-th entry of the lane is then
+//   - input.values[in_base + x * input.strides[dim] + k]
+// and likewise for output. This lets the binomial transition be applied to
+// every fibre along dim at once, with the innermost dimension as the SIMD lane
+// axis. If dim is itself the innermost dimension, lanes have length one, which
+// reduces to doing one fibre at a time.
+//
+// The input and output ranges may differ in dimension dim (and only in dim).
+template <typename F>
+void for_each_lane(const Tensor& input,
+                   const Tensor& output,
+                   const KDRange& range,
+                   unsigned int dim,
+                   F f) {
+    // We walk a copy of range which is only one entry wide in dimension dim.
+    // That entry is chosen so it is in bounds for both tensors' offsets; the
+    // offsets are then shifted back to what they would be for a count of zero.
+    unsigned int x = max(input.range.min[dim], output.range.min[dim]);
+    KDRange lane_range = range;
+    lane_range.min[dim] = x;
+    lane_range.max[dim] = x + 1;
+    dispatch_order(range.min.size(), [&](auto o) {
+        const unsigned int ORDER = decltype(o)::value;
+        for_each_row<ORDER>(
+                lane_range,
+                [&](const unsigned int* loc, unsigned int length) {
+                    int in_base = (int)input.offset<ORDER>(loc)
+                                  - (int)x * input.strides[dim];
+                    int out_base = (int)output.offset<ORDER>(loc)
+                                   - (int)x * output.strides[dim];
+                    f(in_base, out_base, length);
+                });
+    });
+}
 }  // namespace
 
 BinomialTransition::BinomialTransition(double q, int channel)
@@ -88,9 +131,10 @@ void BinomialTransition::prune_backward(KDRange* range, bool* allow_detached) {
     *range = forward_range;
 }
 
-PeptideStateVector* BinomialTransition::forward(
-        const PeptideStateVector& input, unsigned int* num_edmans) const {
-    PeptideStateVector* output = new PeptideStateVector(backward_range);
+void BinomialTransition::forward(const PeptideStateVector& input,
+                                 unsigned int* num_edmans,
+                                 PeptideStateVector* output) const {
+    output->resize(backward_range);
     forward(input.tensor, &output->tensor);
     forward(input.broken_n_tensor, &output->broken_n_tensor);
     output->range = backward_range;
@@ -98,27 +142,47 @@ PeptideStateVector* BinomialTransition::forward(
     if (output->allow_detached) {
         output->p_detached = input.p_detached;
     }
-    return output;
 }
 
 void BinomialTransition::forward(const Tensor& input, Tensor* output) const {
-    // Mismatched range is OK, range should only differ on the channel being
-    // processed.
-    ConstTensorVectorIterator* in_itr =
-            input.const_vector_iterator(forward_range, 1 + channel);
-    TensorVectorIterator* out_itr =
-            output->vector_iterator(backward_range, 1 + channel);
-    while (!in_itr->done()) {
-        const Vector* in_v = in_itr->get();
-        Vector* out_v = out_itr->get();
-        this->forward(*in_v, out_v);
-        delete in_v;
-        delete out_v;
-        in_itr->advance();
-        out_itr->advance();
-    }
-    delete in_itr;
-    delete out_itr;
+    forward(forward_range, backward_range, input, output);
+}
+
+void BinomialTransition::forward(const KDRange& from_range,
+                                 const KDRange& to_range,
+                                 const Tensor& input,
+                                 Tensor* output) const {
+    unsigned int d = 1 + channel;
+    int in_stride = input.strides[d];
+    int out_stride = output->strides[d];
+    unsigned int to_min = to_range.min[d];
+    unsigned int to_max = to_range.max[d];
+    unsigned int from_max = from_range.max[d];
+    for_each_lane(
+            input,
+            *output,
+            to_range,
+            d,
+            [&](int in_base, int out_base, unsigned int length) {
+                for (unsigned int to = to_min; to < to_max; to++) {
+                    double* out =
+                            &output->values[out_base + (int)to * out_stride];
+                    for (unsigned int k = 0; k < length; k++) {
+                        out[k] = 0.0;
+                    }
+                    unsigned int from_min = max(to, from_range.min[d]);
+                    for (unsigned int from = from_min; from < from_max;
+                         from++) {
+                        double p = prob(from, to);
+                        const double* in =
+                                &input.values[in_base + (int)from * in_stride];
+#pragma omp simd
+                        for (unsigned int k = 0; k < length; k++) {
+                            out[k] += p * in[k];
+                        }
+                    }
+                }
+            });
 }
 
 void BinomialTransition::forward(const Vector& input, Vector* output) const {
@@ -126,7 +190,7 @@ void BinomialTransition::forward(const Vector& input, Vector* output) const {
     unsigned int to_max = backward_range.max[1 + channel];
     for (unsigned int to = to_min; to < to_max; to++) {
         double v_to = 0.0;
-        unsigned int from_min = std::max(to, forward_range.min[1 + channel]);
+        unsigned int from_min = max(to, forward_range.min[1 + channel]);
         unsigned int from_max = forward_range.max[1 + channel];
         for (unsigned int from = from_min; from < from_max; from++) {
             v_to += prob(from, to) * input[from];
@@ -135,9 +199,10 @@ void BinomialTransition::forward(const Vector& input, Vector* output) const {
     }
 }
 
-PeptideStateVector* BinomialTransition::backward(
-        const PeptideStateVector& input, unsigned int* num_edmans) const {
-    PeptideStateVector* output = new PeptideStateVector(forward_range);
+void BinomialTransition::backward(const PeptideStateVector& input,
+                                  unsigned int* num_edmans,
+                                  PeptideStateVector* output) const {
+    output->resize(forward_range);
     backward(input.tensor, &output->tensor);
     backward(input.broken_n_tensor, &output->broken_n_tensor);
     output->range = forward_range;
@@ -145,27 +210,39 @@ PeptideStateVector* BinomialTransition::backward(
     if (output->allow_detached) {
         output->p_detached = input.p_detached;
     }
-    return output;
 }
 
 void BinomialTransition::backward(const Tensor& input, Tensor* output) const {
-    // Mismatched range is OK, range should only differ on the channel being
-    // processed.
-    ConstTensorVectorIterator* in_itr =
-            input.const_vector_iterator(backward_range, 1 + channel);
-    TensorVectorIterator* out_itr =
-            output->vector_iterator(forward_range, 1 + channel);
-    while (!out_itr->done()) {
-        const Vector* in_v = in_itr->get();
-        Vector* out_v = out_itr->get();
-        this->backward(*in_v, out_v);
-        delete in_v;
-        delete out_v;
-        in_itr->advance();
-        out_itr->advance();
-    }
-    delete in_itr;
-    delete out_itr;
+    unsigned int d = 1 + channel;
+    int in_stride = input.strides[d];
+    int out_stride = output->strides[d];
+    unsigned int from_min = forward_range.min[d];
+    unsigned int from_max = forward_range.max[d];
+    unsigned int to_min = backward_range.min[d];
+    for_each_lane(
+            input,
+            *output,
+            forward_range,
+            d,
+            [&](int in_base, int out_base, unsigned int length) {
+                for (unsigned int from = from_min; from < from_max; from++) {
+                    double* out =
+                            &output->values[out_base + (int)from * out_stride];
+                    for (unsigned int k = 0; k < length; k++) {
+                        out[k] = 0.0;
+                    }
+                    unsigned int to_max = min(from + 1, backward_range.max[d]);
+                    for (unsigned int to = to_min; to < to_max; to++) {
+                        double p = prob(from, to);
+                        const double* in =
+                                &input.values[in_base + (int)to * in_stride];
+#pragma omp simd
+                        for (unsigned int k = 0; k < length; k++) {
+                            out[k] += p * in[k];
+                        }
+                    }
+                }
+            });
 }
 
 void BinomialTransition::backward(const Vector& input, Vector* output) const {
@@ -174,7 +251,7 @@ void BinomialTransition::backward(const Vector& input, Vector* output) const {
     for (int from = from_max - 1; from >= from_min; from--) {
         double v_from = 0.0;
         int to_min = backward_range.min[1 + channel];
-        int to_max = std::min(from, (int)backward_range.max[1 + channel] - 1);
+        int to_max = min(from, (int)backward_range.max[1 + channel] - 1);
         for (int to = to_min; to <= to_max; to++) {
             v_from += prob(from, to) * input[to];
         }
@@ -182,6 +259,28 @@ void BinomialTransition::backward(const Vector& input, Vector* output) const {
     }
 }
 
+void BinomialTransition::forward_batch(const BatchPeptideStateVector& input,
+                                       unsigned int* num_edmans,
+                                       BatchPeptideStateVector* output) const {
+    output->resize(backward_range, input.batch_size);
+    // The lane dimension comes last, so it becomes the SIMD lane axis of the
+    // Tensor version of forward().
+    KDRange from_range = BatchPeptideStateVector::batch_range(forward_range,
+                                                              input.batch_size);
+    KDRange to_range = BatchPeptideStateVector::batch_range(backward_range,
+                                                            input.batch_size);
+    forward(from_range, to_range, input.tensor, &output->tensor);
+    forward(from_range,
+            to_range,
+            input.broken_n_tensor,
+            &output->broken_n_tensor);
+    output->range = backward_range;
+    output->allow_detached = input.allow_detached;
+    if (output->allow_detached) {
+        output->p_detached = input.p_detached;
+    }
+}
+
 void BinomialTransition::improve_fit(
         const PeptideStateVector& forward_psv,
         const PeptideStateVector& backward_psv,
@@ -238,7 +337,7 @@ void BinomialTransition::improve_fit(const Vector& forward_vector,
     int from_max = forward_range.max[1 + channel];
     // Note that we can ignore when starting location (from) is 0 because then
     // there are no dyes, it's irrelevant. We would be adding 0s.
-    for (int from = from_max - 1; from >= std::max(from_min, 1); from--) {
+    for (int from = from_max - 1; from >= max(from_min, 1); from--) {
         double p_state =
                 forward_vector[from] * backward_vector[from] / probability;
         fitter->denominator += p_state * (double)from;
@@ -247,7 +346,7 @@ void BinomialTransition::improve_fit(const Vector& forward_vector,
         // We can ignore when to and from are equal, because no dyes are lost
         // then, so it gives us nothing else for the numerator; we would be
         // adding zero.
-        for (int to = to_min; to < std::min(to_max, from); to++) {
+        for (int to = to_min; to < min(to_max, from); to++) {
             double p_transition = forward_vector[from] * prob(from, to)
                                   * next_backward_vector[to] / probability;
             fitter->numerator += p_transition * (double)(from - to);
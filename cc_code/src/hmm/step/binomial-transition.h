@@ -13,6 +13,7 @@
 #include <vector>
 
 // Local project headers:
+#include "hmm/state-vector/batch-peptide-state-vector.h"
 #include "hmm/state-vector/peptide-state-vector.h"
 #include "hmm/step/peptide-step.h"
 #include "parameterization/fit/parameter-fitter.h"
@@ -24,6 +25,10 @@ namespace whatprot {
 
 class BinomialTransition : public PeptideStep {
 public:
+    // This next line makes the allocating versions of forward() and backward()
+    // from Step visible alongside the overrides below.
+    using PeptideStep::backward;
+    using PeptideStep::forward;
     BinomialTransition(double q, int channel);
     BinomialTransition(const BinomialTransition& other);
     virtual ~BinomialTransition();
@@ -32,16 +37,25 @@ public:
     double prob(unsigned int from, unsigned int to) const;
     virtual void prune_forward(KDRange* range, bool* allow_detached) override;
     virtual void prune_backward(KDRange* range, bool* allow_detached) override;
-    virtual PeptideStateVector* forward(
-            const PeptideStateVector& input,
-            unsigned int* num_edmans) const override;
+    virtual void forward(const PeptideStateVector& input,
+                         unsigned int* num_edmans,
+                         PeptideStateVector* output) const override;
     void forward(const Tensor& input, Tensor* output) const;
+    // Like the above, but from_range and to_range replace forward_range and
+    // backward_range. This lets forward_batch() add the lane dimension.
+    void forward(const KDRange& from_range,
+                 const KDRange& to_range,
+                 const Tensor& input,
+                 Tensor* output) const;
     void forward(const Vector& input, Vector* output) const;
-    virtual PeptideStateVector* backward(
-            const PeptideStateVector& input,
-            unsigned int* num_edmans) const override;
+    virtual void backward(const PeptideStateVector& input,
+                          unsigned int* num_edmans,
+                          PeptideStateVector* output) const override;
     void backward(const Tensor& input, Tensor* output) const;
     void backward(const Vector& input, Vector* output) const;
+    virtual void forward_batch(const BatchPeptideStateVector& input,
+                               unsigned int* num_edmans,
+                               BatchPeptideStateVector* output) const override;
     void improve_fit(const PeptideStateVector& forward_psv,
                      const PeptideStateVector& backward_psv,
                      const PeptideStateVector& next_backward_psv,
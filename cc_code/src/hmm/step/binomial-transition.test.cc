@@ -538,6 +538,42 @@ BOOST_AUTO_TEST_CASE(forward_other_dye_colors_test, *tolerance(TOL)) {
     delete psv2;
 }
 
+BOOST_AUTO_TEST_CASE(forward_pruned_other_dye_colors_test, *tolerance(TOL)) {
+    double q = 0.05;
+    double p = 0.95;
+    int channel = 0;  // corresponds to 1st dim of tensor
+    TestableBinomialTransition bt(q, channel);
+    bt.reserve(2);
+    bt.forward_range.min = {0, 1, 0};
+    bt.forward_range.max = {1, 3, 2};
+    bt.backward_range.min = {0, 0, 0};
+    bt.backward_range.max = {1, 3, 2};
+    unsigned int order = 3;
+    unsigned int* shape = new unsigned int[order];
+    shape[0] = 1;
+    shape[1] = 3;
+    shape[2] = 2;
+    PeptideStateVector psv1(order, shape);
+    delete[] shape;
+    // These first two are outside of the forward range and should be ignored.
+    psv1.tensor[{0, 0, 0}] = 0.9;
+    psv1.tensor[{0, 0, 1}] = 0.9;
+    psv1.tensor[{0, 1, 0}] = 0.1;
+    psv1.tensor[{0, 1, 1}] = 0.2;
+    psv1.tensor[{0, 2, 0}] = 0.3;
+    psv1.tensor[{0, 2, 1}] = 0.4;
+    psv1.allow_detached = false;
+    unsigned int edmans = 0;
+    PeptideStateVector* psv2 = bt.forward(psv1, &edmans);
+    BOOST_TEST((psv2->tensor[{0, 0, 0}]) == 0.1 * q + 0.3 * q * q);
+    BOOST_TEST((psv2->tensor[{0, 0, 1}]) == 0.2 * q + 0.4 * q * q);
+    BOOST_TEST((psv2->tensor[{0, 1, 0}]) == 0.1 * p + 0.3 * 2 * p * q);
+    BOOST_TEST((psv2->tensor[{0, 1, 1}]) == 0.2 * p + 0.4 * 2 * p * q);
+    BOOST_TEST((psv2->tensor[{0, 2, 0}]) == 0.3 * p * p);
+    BOOST_TEST((psv2->tensor[{0, 2, 1}]) == 0.4 * p * p);
+    delete psv2;
+}
+
 BOOST_AUTO_TEST_CASE(backward_trivial_test, *tolerance(TOL)) {
     double q = 0.05;
     int channel = 0;
@@ -833,6 +869,43 @@ BOOST_AUTO_TEST_CASE(backward_other_dye_colors_test, *tolerance(TOL)) {
     delete psv2;
 }
 
+BOOST_AUTO_TEST_CASE(backward_pruned_other_dye_colors_test, *tolerance(TOL)) {
+    double q = 0.05;
+    double p = 0.95;
+    int channel = 0;  // corresponds to 1st dim of tensor
+    TestableBinomialTransition bt(q, channel);
+    bt.reserve(2);
+    bt.forward_range.min = {0, 1, 0};
+    bt.forward_range.max = {1, 3, 2};
+    bt.backward_range.min = {0, 0, 0};
+    bt.backward_range.max = {1, 3, 2};
+    unsigned int order = 3;
+    unsigned int* shape = new unsigned int[order];
+    shape[0] = 1;
+    shape[1] = 3;
+    shape[2] = 2;
+    PeptideStateVector psv1(order, shape);
+    delete[] shape;
+    psv1.tensor[{0, 0, 0}] = 0.1;
+    psv1.tensor[{0, 0, 1}] = 0.2;
+    psv1.tensor[{0, 1, 0}] = 0.3;
+    psv1.tensor[{0, 1, 1}] = 0.4;
+    psv1.tensor[{0, 2, 0}] = 0.5;
+    psv1.tensor[{0, 2, 1}] = 0.6;
+    psv1.allow_detached = false;
+    unsigned int edmans = 0;
+    PeptideStateVector* psv2 = bt.backward(psv1, &edmans);
+    BOOST_TEST((psv2->tensor[{0, 1, 0}]) == 0.1 * q + 0.3 * p);
+    BOOST_TEST((psv2->tensor[{0, 1, 1}]) == 0.2 * q + 0.4 * p);
+    BOOST_TEST((psv2->tensor[{0, 2, 0}])
+               == 0.1 * q * q + 0.3 * 2 * p * q + 0.5 * p * p);
+    BOOST_TEST((psv2->tensor[{0, 2, 1}])
+               == 0.2 * q * q + 0.4 * 2 * p * q + 0.6 * p * p);
+    BOOST_TEST(psv2->range.min[1] == 1u);
+    BOOST_TEST(psv2->range.max[1] == 3u);
+    delete psv2;
+}
+
 BOOST_AUTO_TEST_CASE(improve_fit_trivial_test, *tolerance(TOL)) {
     double q = 0.05;
     int channel = 0;
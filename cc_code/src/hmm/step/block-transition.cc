@@ -10,9 +10,11 @@
 #include "block-transition.h"
 
 // Local project headers:
+#include "hmm/state-vector/batch-peptide-state-vector.h"
 #include "hmm/state-vector/peptide-state-vector.h"
 #include "hmm/step/peptide-step.h"
 #include "parameterization/fit/parameter-fitter.h"
+#include "tensor/range-loop.h"
 #include "util/kd-range.h"
 
 namespace whatprot {
@@ -28,9 +30,10 @@ void BrokenNTransition::prune_backward(KDRange* range, bool* allow_detached) {
     *range = pruned_range;
 }
 
-PeptideStateVector* BrokenNTransition::forward(const PeptideStateVector& input,
-                                               unsigned int* num_edmans) const {
-    PeptideStateVector* output = new PeptideStateVector(pruned_range);
+void BrokenNTransition::forward(const PeptideStateVector& input,
+                                unsigned int* num_edmans,
+                                PeptideStateVector* output) const {
+    output->resize(pruned_range);
     ConstTensorIterator* tsr_in_itr = input.tensor.const_iterator(pruned_range);
     ConstTensorIterator* brkn_in_itr =
             input.broken_n_tensor.const_iterator(pruned_range);
@@ -56,12 +59,12 @@ PeptideStateVector* BrokenNTransition::forward(const PeptideStateVector& input,
     if (output->allow_detached) {
         output->p_detached = input.p_detached;
     }
-    return output;
 }
 
-PeptideStateVector* BrokenNTransition::backward(
-        const PeptideStateVector& input, unsigned int* num_edmans) const {
-    PeptideStateVector* output = new PeptideStateVector(pruned_range);
+void BrokenNTransition::backward(const PeptideStateVector& input,
+                                 unsigned int* num_edmans,
+                                 PeptideStateVector* output) const {
+    output->resize(pruned_range);
     ConstTensorIterator* tsr_in_itr = input.tensor.const_iterator(pruned_range);
     ConstTensorIterator* brkn_in_itr =
             input.broken_n_tensor.const_iterator(pruned_range);
@@ -87,7 +90,38 @@ PeptideStateVector* BrokenNTransition::backward(
     if (output->allow_detached) {
         output->p_detached = input.p_detached;
     }
-    return output;
+}
+
+void BrokenNTransition::forward_batch(const BatchPeptideStateVector& input,
+                                      unsigned int* num_edmans,
+                                      BatchPeptideStateVector* output) const {
+    output->resize(pruned_range, input.batch_size);
+    KDRange range = BatchPeptideStateVector::batch_range(pruned_range,
+                                                         input.batch_size);
+    dispatch_order(range.min.size(), [&](auto o) {
+        const unsigned int ORDER = decltype(o)::value;
+        for_each_row<ORDER>(
+                range,
+                [&](const unsigned int* loc, unsigned int length) {
+                    // tensor and broken_n_tensor always have the same shape.
+                    unsigned int i = input.tensor.offset<ORDER>(loc);
+                    unsigned int j = output->tensor.offset<ORDER>(loc);
+                    const double* tsr_in = &input.tensor.values[i];
+                    const double* brkn_in = &input.broken_n_tensor.values[i];
+                    double* tsr_out = &output->tensor.values[j];
+                    double* brkn_out = &output->broken_n_tensor.values[j];
+                    for (unsigned int b = 0; b < length; b++) {
+                        tsr_out[b] = (1 - p_block) * tsr_in[b];
+                        brkn_out[b] = brkn_in[b] + p_block * tsr_in[b];
+                    }
+                });
+    });
+    // Now we fix up the ranges, allow_detached, etc...
+    output->range = pruned_range;
+    output->allow_detached = input.allow_detached;
+    if (output->allow_detached) {
+        output->p_detached = input.p_detached;
+    }
 }
 
 void BrokenNTransition::improve_fit(const PeptideStateVector& forward_psv,
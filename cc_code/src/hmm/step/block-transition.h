@@ -10,6 +10,7 @@
 #define WHATPROT_HMM_STEP_BROKEN_N_TRANSITION_H
 
 // Local project headers:
+#include "hmm/state-vector/batch-peptide-state-vector.h"
 #include "hmm/state-vector/peptide-state-vector.h"
 #include "hmm/step/peptide-step.h"
 #include "parameterization/fit/parameter-fitter.h"
@@ -19,15 +20,22 @@ namespace whatprot {
 
 class BrokenNTransition : public PeptideStep {
 public:
+    // This next line makes the allocating versions of forward() and backward()
+    // from Step visible alongside the overrides below.
+    using PeptideStep::backward;
+    using PeptideStep::forward;
     BrokenNTransition(double p_block);
     virtual void prune_forward(KDRange* range, bool* allow_detached) override;
     virtual void prune_backward(KDRange* range, bool* allow_detached) override;
-    virtual PeptideStateVector* forward(
-            const PeptideStateVector& input,
-            unsigned int* num_edmans) const override;
-    virtual PeptideStateVector* backward(
-            const PeptideStateVector& input,
-            unsigned int* num_edmans) const override;
+    virtual void forward(const PeptideStateVector& input,
+                         unsigned int* num_edmans,
+                         PeptideStateVector* output) const override;
+    virtual void backward(const PeptideStateVector& input,
+                          unsigned int* num_edmans,
+                          PeptideStateVector* output) const override;
+    virtual void forward_batch(const BatchPeptideStateVector& input,
+                               unsigned int* num_edmans,
+                               BatchPeptideStateVector* output) const override;
     void improve_fit(const PeptideStateVector& forward_psv,
                      const PeptideStateVector& backward_psv,
                      const PeptideStateVector& next_backward_psv,
@@ -10,9 +10,11 @@
 #include "detach-transition.h"
 
 // Local project headers:
+#include "hmm/state-vector/batch-peptide-state-vector.h"
 #include "hmm/state-vector/peptide-state-vector.h"
 #include "parameterization/fit/sequencing-model-fitter.h"
 #include "tensor/const-tensor-iterator.h"
+#include "tensor/range-loop.h"
 #include "tensor/tensor-iterator.h"
 #include "util/kd-range.h"
 
@@ -33,9 +35,10 @@ void DetachTransition::prune_backward(KDRange* range, bool* allow_detached) {
     detached_backward = allow_detached;
 }
 
-PeptideStateVector* DetachTransition::forward(const PeptideStateVector& input,
-                                              unsigned int* num_edmans) const {
-    PeptideStateVector* output = new PeptideStateVector(pruned_range);
+void DetachTransition::forward(const PeptideStateVector& input,
+                               unsigned int* num_edmans,
+                               PeptideStateVector* output) const {
+    output->resize(pruned_range);
     double sum = forward(input.tensor, &output->tensor);
     sum += forward(input.broken_n_tensor, &output->broken_n_tensor);
     if (detached_backward) {
@@ -48,28 +51,30 @@ PeptideStateVector* DetachTransition::forward(const PeptideStateVector& input,
     // Now we fix up the ranges, allow_detached, etc...
     output->range = pruned_range;
     output->allow_detached = detached_backward;
-    return output;
 }
 
 double DetachTransition::forward(const Tensor& input, Tensor* output) const {
-    ConstTensorIterator* in_itr = input.const_iterator(pruned_range);
-    TensorIterator* out_itr = output->iterator(pruned_range);
     double sum = 0.0;
-    while (!in_itr->done()) {
-        double value = *in_itr->get();
-        *out_itr->get() = value * (1 - p_detach);
-        sum += value;
-        in_itr->advance();
-        out_itr->advance();
-    }
-    delete in_itr;
-    delete out_itr;
+    dispatch_order(pruned_range.min.size(), [&](auto o) {
+        const unsigned int ORDER = decltype(o)::value;
+        for_each_row<ORDER>(
+                pruned_range,
+                [&](const unsigned int* loc, unsigned int length) {
+                    const double* in = &input.values[input.offset<ORDER>(loc)];
+                    double* out = &output->values[output->offset<ORDER>(loc)];
+                    for (unsigned int i = 0; i < length; i++) {
+                        out[i] = in[i] * (1 - p_detach);
+                        sum += in[i];
+                    }
+                });
+    });
     return sum;
 }
 
-PeptideStateVector* DetachTransition::backward(const PeptideStateVector& input,
-                                               unsigned int* num_edmans) const {
-    PeptideStateVector* output = new PeptideStateVector(pruned_range);
+void DetachTransition::backward(const PeptideStateVector& input,
+                                unsigned int* num_edmans,
+                                PeptideStateVector* output) const {
+    output->resize(pruned_range);
     backward(input.tensor, input.p_detached, &output->tensor);
     backward(input.broken_n_tensor, input.p_detached, &output->broken_n_tensor);
     if (detached_forward) {
@@ -82,7 +87,6 @@ PeptideStateVector* DetachTransition::backward(const PeptideStateVector& input,
     // Now we fix up the ranges, allow_detached, etc...
     output->range = pruned_range;
     output->allow_detached = detached_forward;
-    return output;
 }
 
 void DetachTransition::backward(const Tensor& input,
@@ -102,6 +106,53 @@ void DetachTransition::backward(const Tensor& input,
     delete out_itr;
 }
 
+void DetachTransition::forward_batch(const BatchPeptideStateVector& input,
+                                     unsigned int* num_edmans,
+                                     BatchPeptideStateVector* output) const {
+    output->resize(pruned_range, input.batch_size);
+    KDRange range = BatchPeptideStateVector::batch_range(pruned_range,
+                                                         input.batch_size);
+    // The resize zeroed output->p_detached, so we can use it to accumulate the
+    // sum of each lane before fixing it up below.
+    double* sums = &output->p_detached[0];
+    forward_batch(range, input.tensor, &output->tensor, sums);
+    forward_batch(range, input.broken_n_tensor, &output->broken_n_tensor, sums);
+    for (unsigned int b = 0; b < input.batch_size; b++) {
+        if (detached_backward) {
+            if (detached_forward) {
+                output->p_detached[b] =
+                        input.p_detached[b] + p_detach * sums[b];
+            } else {
+                output->p_detached[b] = p_detach * sums[b];
+            }
+        } else {
+            output->p_detached[b] = 0.0;
+        }
+    }
+    // Now we fix up the ranges, allow_detached, etc...
+    output->range = pruned_range;
+    output->allow_detached = detached_backward;
+}
+
+void DetachTransition::forward_batch(const KDRange& range,
+                                     const Tensor& input,
+                                     Tensor* output,
+                                     double* sums) const {
+    dispatch_order(range.min.size(), [&](auto o) {
+        const unsigned int ORDER = decltype(o)::value;
+        for_each_row<ORDER>(
+                range,
+                [&](const unsigned int* loc, unsigned int length) {
+                    const double* in = &input.values[input.offset<ORDER>(loc)];
+                    double* out = &output->values[output->offset<ORDER>(loc)];
+                    for (unsigned int b = 0; b < length; b++) {
+                        out[b] = in[b] * (1 - p_detach);
+                        sums[b] += in[b];
+                    }
+                });
+    });
+}
+
 void DetachTransition::improve_fit(const PeptideStateVector& forward_psv,
                                    const PeptideStateVector& backward_psv,
                                    const PeptideStateVector& next_backward_psv,
@@ -10,6 +10,7 @@
 #define WHATPROT_HMM_STEP_DETACH_TRANSITION_H
 
 // Local project headers:
+#include "hmm/state-vector/batch-peptide-state-vector.h"
 #include "hmm/state-vector/peptide-state-vector.h"
 #include "hmm/step/peptide-step.h"
 #include "parameterization/fit/sequencing-model-fitter.h"
@@ -19,17 +20,30 @@ namespace whatprot {
 
 class DetachTransition : public PeptideStep {
 public:
+    // This next line makes the allocating versions of forward() and backward()
+    // from Step visible alongside the overrides below.
+    using PeptideStep::backward;
+    using PeptideStep::forward;
     DetachTransition(unsigned int timestep, double p_detach);
     virtual void prune_forward(KDRange* range, bool* allow_detached) override;
     virtual void prune_backward(KDRange* range, bool* allow_detached) override;
-    virtual PeptideStateVector* forward(
-            const PeptideStateVector& input,
-            unsigned int* num_edmans) const override;
+    virtual void forward(const PeptideStateVector& input,
+                         unsigned int* num_edmans,
+                         PeptideStateVector* output) const override;
     double forward(const Tensor& input, Tensor* output) const;
-    virtual PeptideStateVector* backward(
-            const PeptideStateVector& input,
-            unsigned int* num_edmans) const override;
+    virtual void backward(const PeptideStateVector& input,
+                          unsigned int* num_edmans,
+                          PeptideStateVector* output) const override;
     void backward(const Tensor& input, double p_detached, Tensor* output) const;
+    virtual void forward_batch(const BatchPeptideStateVector& input,
+                               unsigned int* num_edmans,
+                               BatchPeptideStateVector* output) const override;
+    // Batched version of forward() for Tensors. The range must include the
+    // lane dimension. The sum of each lane of input is added to sums[lane].
+    void forward_batch(const KDRange& range,
+                       const Tensor& input,
+                       Tensor* output,
+                       double* sums) const;
     virtual void improve_fit(const PeptideStateVector& forward_psv,
                              const PeptideStateVector& backward_psv,
                              const PeptideStateVector& next_backward_psv,
@@ -9,15 +9,26 @@
 // Defining symbols from header:
 #include "edman-transition.h"
 
+// Standard C++ library headers:
+#include <algorithm>
+
 // Local project headers:
 #include "common/dye-track.h"
+#include "hmm/state-vector/batch-peptide-state-vector.h"
 #include "hmm/state-vector/peptide-state-vector.h"
 #include "parameterization/fit/sequencing-model-fitter.h"
+#include "tensor/range-loop.h"
+#include "tensor/tensor.h"
 #include "tensor/vector.h"
 #include "util/kd-range.h"
 
 namespace whatprot {
 
+namespace {
+using std::copy;
+using std::fill;
+}  // namespace
+
 EdmanTransition::EdmanTransition(double p_edman_failure,
                                  const DyeSeq& dye_seq,
                                  const DyeTrack& dye_track)
@@ -59,111 +70,147 @@ void EdmanTransition::prune_backward(KDRange* range, bool* allow_detached) {
     set_true_forward_range(*range);
 }
 
-PeptideStateVector* EdmanTransition::forward(const PeptideStateVector& input,
-                                             unsigned int* num_edmans) const {
+void EdmanTransition::forward(const PeptideStateVector& input,
+                              unsigned int* num_edmans,
+                              PeptideStateVector* output) const {
     (*num_edmans)++;
-    PeptideStateVector* output = new PeptideStateVector(safe_backward_range);
+    output->resize(safe_backward_range);
+    forward(true_forward_range, input.tensor, &output->tensor);
+    forward_broken_n(true_forward_range,
+                     input.broken_n_tensor,
+                     &output->broken_n_tensor);
+    // Now we fix up the ranges, allow_detached, etc...
+    output->range = true_backward_range;
+    output->allow_detached = input.allow_detached;
+    if (output->allow_detached) {
+        output->p_detached = input.p_detached;
+    }
+}
+
+void EdmanTransition::forward(const KDRange& range,
+                              const Tensor& input,
+                              Tensor* output) const {
     // First we set all of the output in the backward range to zero. This allows
     // us to use += when gathering the various probabilities coming in from the
     // input PeptideStateVector. This is way easier than the alternative, since
-    // the forward and backward ranges may not match up the way you expect.
-    TensorIterator* out_itr = output->tensor.iterator(safe_backward_range);
-    while (!out_itr->done()) {
-        *out_itr->get() = 0.0;
-        out_itr->advance();
-    }
-    delete out_itr;
+    // the forward and backward ranges may not match up the way you expect. The
+    // output was just resized to the backward range, so that is all of it.
+    fill(output->values, output->values + output->size, 0.0);
     // Now we iterate through the input in the forward range, and multiply these
     // values out into every receiving value in the output. We don't worry about
     // whether we are writing to locations which are actually in the
     // backward range, as this would be more trouble than it's worth, and likely
     // would not improve the runtime (checking conditionals is expensive).
-    ConstTensorIterator* in_itr =
-            input.tensor.const_iterator(true_forward_range);
+    //
     // true_forward_range is a strict subset of safe_backward_range, so we can
     // use it to index into output.
-    out_itr = output->tensor.iterator(true_forward_range);
-    unsigned int t_stride = output->tensor.strides[0];
-    while (!in_itr->done()) {
-        double f_val = *in_itr->get();
-        unsigned int i = out_itr->index;
-        unsigned int t = out_itr->loc[0];
-        int c = dye_seq[t];
-        // Probability of failure is straightforward.
-        output->tensor.values[i] += p_edman_failure * f_val;
-        // Probability of success is broken into smaller pieces.
-        if (c == -1) {
-            // If no fluorophore removed in the successful Edman cycle scenario,
-            // we just take the remaining portion of the probability to the next
-            // successful Edman count ('+ t_stride' does this)
-            output->tensor.values[i + t_stride] +=
-                    (1 - p_edman_failure) * f_val;
-        } else {
-            // If fluorophore removed, we need to split this probability
-            // further. As before we reindex to the next successful Edman count
-            // (with '+ t_stride').
-            unsigned int c_idx = in_itr->loc[1 + c];
-            unsigned int c_total = dye_track(t, c);
-            double ratio = (double)c_idx / (double)c_total;
-            unsigned int c_stride = output->tensor.strides[1 + c];
-            if (c_idx < c_total) {
-                // Here we multiply additionally by probability of no
-                // fluorophore removal.
-                output->tensor.values[i + t_stride] +=
-                        (1 - p_edman_failure) * (1 - ratio) * f_val;
-            }
-            if (c_idx > 0) {
-                // And here we handle probability of flurophore removal
-                // ('- c_stride' indexes to the correct location).
-                output->tensor.values[i + t_stride - c_stride] +=
-                        (1 - p_edman_failure) * ratio * f_val;
-            }
-        }
-        in_itr->advance();
-        out_itr->advance();
-    }
-    delete in_itr;
-    delete out_itr;
-    // We also need to deal with the 'block' states. Even though Edman
-    // degradation has no effect on these states, which is the whole reason for
-    // their existence, we still need to copy them to the new tensor so that the
-    // old values are not lost.
+    unsigned int t_stride = output->strides[0];
+    // Index of the channel which is the innermost dimension of the tensors.
+    // This is the only channel whose dye count changes along a row. When range
+    // has a lane dimension (see BatchPeptideStateVector) this matches no
+    // channel, which is what we want.
+    int last_c = (int)range.min.size() - 2;
+    dispatch_order(range.min.size(), [&](auto o) {
+        const unsigned int ORDER = decltype(o)::value;
+        for_each_row<ORDER>(
+                range,
+                [&](const unsigned int* loc, unsigned int length) {
+                    const double* in = &input.values[input.offset<ORDER>(loc)];
+                    double* out = &output->values[output->offset<ORDER>(loc)];
+                    // Adding t_stride takes us to the next successful Edman
+                    // count.
+                    double* out_next = out + t_stride;
+                    // Every entry of a row has the same Edman count, which is
+                    // the 0th index.
+                    unsigned int t = loc[0];
+                    int c = dye_seq[t];
+                    // Probability of failure is straightforward.
+                    for (unsigned int i = 0; i < length; i++) {
+                        out[i] += p_edman_failure * in[i];
+                    }
+                    // Probability of success is broken into smaller pieces.
+                    if (c == -1) {
+                        // If no fluorophore removed in the successful Edman
+                        // cycle scenario, we just take the remaining portion
+                        // of the probability to the next successful Edman
+                        // count.
+                        for (unsigned int i = 0; i < length; i++) {
+                            out_next[i] += (1 - p_edman_failure) * in[i];
+                        }
+                        return;
+                    }
+                    // If fluorophore removed, we need to split this
+                    // probability further.
+                    unsigned int c_total = dye_track(t, c);
+                    // Subtracting c_stride indexes to the location with one
+                    // less fluorophore of color c.
+                    double* out_removed = out_next - output->strides[1 + c];
+                    unsigned int c_step = (c == last_c) ? 1 : 0;
+                    for (unsigned int i = 0; i < length; i++) {
+                        unsigned int c_idx = loc[1 + c] + i * c_step;
+                        double ratio = (double)c_idx / (double)c_total;
+                        if (c_idx < c_total) {
+                            // Here we multiply additionally by probability of
+                            // no fluorophore removal.
+                            out_next[i] +=
+                                    (1 - p_edman_failure) * (1 - ratio) * in[i];
+                        }
+                        if (c_idx > 0) {
+                            // And here we handle probability of flurophore
+                            // removal.
+                            out_removed[i] +=
+                                    (1 - p_edman_failure) * ratio * in[i];
+                        }
+                    }
+                });
+    });
+}
+
+void EdmanTransition::forward_broken_n(const KDRange& range,
+                                       const Tensor& input,
+                                       Tensor* output) const {
+    // Even though Edman degradation has no effect on the 'block' states, which
+    // is the whole reason for their existence, we still need to copy them to
+    // the new tensor so that the old values are not lost.
     //
     // Note that just as with the normal tensor states, we first just set every
     // value in the 'safe-backward-range' to zero, as that is much easier than
     // tracking everything properly.
-    TensorIterator* out_n_itr =
-            output->broken_n_tensor.iterator(safe_backward_range);
-    while (!out_n_itr->done()) {
-        *out_n_itr->get() = 0.0;
-        out_n_itr->advance();
-    }
-    delete out_n_itr;
+    fill(output->values, output->values + output->size, 0.0);
     // Now we actually transfer the values.
-    ConstTensorIterator* in_n_itr =
-            input.broken_n_tensor.const_iterator(true_forward_range);
-    // true_forward_range is a strict subset of safe_backward_range, so we can
-    // use it to index into output.
-    out_n_itr = output->broken_n_tensor.iterator(true_forward_range);
-    while (!in_n_itr->done()) {
-        *out_n_itr->get() = *in_n_itr->get();
-        in_n_itr->advance();
-        out_n_itr->advance();
-    }
-    delete in_n_itr;
-    delete out_n_itr;
+    dispatch_order(range.min.size(), [&](auto o) {
+        const unsigned int ORDER = decltype(o)::value;
+        for_each_row<ORDER>(
+                range,
+                [&](const unsigned int* loc, unsigned int length) {
+                    const double* in = &input.values[input.offset<ORDER>(loc)];
+                    double* out = &output->values[output->offset<ORDER>(loc)];
+                    copy(in, in + length, out);
+                });
+    });
+}
+
+void EdmanTransition::forward_batch(const BatchPeptideStateVector& input,
+                                    unsigned int* num_edmans,
+                                    BatchPeptideStateVector* output) const {
+    (*num_edmans)++;
+    output->resize(safe_backward_range, input.batch_size);
+    KDRange range = BatchPeptideStateVector::batch_range(true_forward_range,
+                                                         input.batch_size);
+    forward(range, input.tensor, &output->tensor);
+    forward_broken_n(range, input.broken_n_tensor, &output->broken_n_tensor);
     // Now we fix up the ranges, allow_detached, etc...
     output->range = true_backward_range;
     output->allow_detached = input.allow_detached;
     if (output->allow_detached) {
         output->p_detached = input.p_detached;
     }
-    return output;
 }
 
-PeptideStateVector* EdmanTransition::backward(const PeptideStateVector& input,
-                                              unsigned int* num_edmans) const {
-    PeptideStateVector* output = new PeptideStateVector(safe_forward_range);
+void EdmanTransition::backward(const PeptideStateVector& input,
+                               unsigned int* num_edmans,
+                               PeptideStateVector* output) const {
+    output->resize(safe_forward_range);
     // First we set all of the output in the forward range to zero. This allows
     // us to use += when gathering the various probabilities coming in from the
     // input PeptideStateVector. This is way easier than the alternative, since
@@ -273,7 +320,6 @@ PeptideStateVector* EdmanTransition::backward(const PeptideStateVector& input,
         output->p_detached = input.p_detached;
     }
     (*num_edmans)--;
-    return output;
 }
 
 void EdmanTransition::improve_fit(const PeptideStateVector& forward_psv,
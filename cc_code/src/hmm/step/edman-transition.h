@@ -11,15 +11,21 @@
 
 // Local project headers:
 #include "common/dye-track.h"
+#include "hmm/state-vector/batch-peptide-state-vector.h"
 #include "hmm/state-vector/peptide-state-vector.h"
 #include "hmm/step/peptide-step.h"
 #include "parameterization/fit/sequencing-model-fitter.h"
+#include "tensor/tensor.h"
 #include "util/kd-range.h"
 
 namespace whatprot {
 
 class EdmanTransition : public PeptideStep {
 public:
+    // This next line makes the allocating versions of forward() and backward()
+    // from Step visible alongside the overrides below.
+    using PeptideStep::backward;
+    using PeptideStep::forward;
     EdmanTransition(double p_edman_failure,
                     const DyeSeq& dye_seq,
                     const DyeTrack& dye_track);
@@ -27,12 +33,24 @@ public:
     void set_true_backward_range(const KDRange& range);
     virtual void prune_forward(KDRange* range, bool* allow_detached) override;
     virtual void prune_backward(KDRange* range, bool* allow_detached) override;
-    virtual PeptideStateVector* forward(
-            const PeptideStateVector& input,
-            unsigned int* num_edmans) const override;
-    virtual PeptideStateVector* backward(
-            const PeptideStateVector& input,
-            unsigned int* num_edmans) const override;
+    virtual void forward(const PeptideStateVector& input,
+                         unsigned int* num_edmans,
+                         PeptideStateVector* output) const override;
+    // These do the work of forward() on each tensor of the state vector,
+    // iterating over the given range. This is true_forward_range, or for
+    // forward_batch() the same with the lane dimension added.
+    void forward(const KDRange& range,
+                 const Tensor& input,
+                 Tensor* output) const;
+    void forward_broken_n(const KDRange& range,
+                          const Tensor& input,
+                          Tensor* output) const;
+    virtual void forward_batch(const BatchPeptideStateVector& input,
+                               unsigned int* num_edmans,
+                               BatchPeptideStateVector* output) const override;
+    virtual void backward(const PeptideStateVector& input,
+                          unsigned int* num_edmans,
+                          PeptideStateVector* output) const override;
     virtual void improve_fit(const PeptideStateVector& forward_psv,
                              const PeptideStateVector& backward_psv,
                              const PeptideStateVector& next_backward_psv,
@@ -17,13 +17,15 @@
 
 // Local project headers:
 #include "common/radiometry.h"
+#include "hmm/precomputations/emission-precomputations.h"
+#include "hmm/state-vector/batch-peptide-state-vector.h"
 #include "hmm/state-vector/peptide-state-vector.h"
 #include "parameterization/fit/sequencing-model-fitter.h"
 #include "parameterization/model/channel-model.h"
 #include "parameterization/model/sequencing-model.h"
 #include "parameterization/settings/sequencing-settings.h"
-#include "tensor/const-tensor-iterator.h"
-#include "tensor/tensor-iterator.h"
+#include "tensor/range-loop.h"
+#include "tensor/tensor.h"
 #include "util/kd-range.h"
 
 namespace whatprot {
@@ -31,9 +33,19 @@ namespace whatprot {
 namespace {
 using std::function;
 using std::lround;
+using std::max;
 using std::min;
 using std::numeric_limits;
 using std::vector;
+
+// Drops the Edman cycle dimension from a range like pruned_range, to get a
+// range in the coordinates of ptsr.
+KDRange without_edman_cycle(const KDRange& range) {
+    KDRange result;
+    result.min.assign(range.min.begin() + 1, range.min.end());
+    result.max.assign(range.max.begin() + 1, range.max.end());
+    return result;
+}
 }  // namespace
 
 PeptideEmission::PeptideEmission(const Radiometry& radiometry,
@@ -42,10 +54,13 @@ PeptideEmission::PeptideEmission(const Radiometry& radiometry,
                                  const SequencingModel& seq_model,
                                  const SequencingSettings& seq_settings)
         : radiometry(radiometry),
+          seq_model(seq_model),
+          emission_precomputations(NULL),
           timestep(timestep),
           i_am_a_copy(false),
           num_channels(radiometry.num_channels),
-          max_num_dyes(max_num_dyes) {
+          max_num_dyes(max_num_dyes),
+          batch_size(0) {
     pruned_range.min.resize(1 + num_channels);
     pruned_range.max.resize(1 + num_channels);
     pruned_range.min[0] = 0;
@@ -164,35 +179,185 @@ PeptideEmission::PeptideEmission(const Radiometry& radiometry,
     // pruned_range saves us the trouble of literally filling in every possible
     // value (with likely performance improvements), but we need to exclude its
     // first element because that refers to the Edman cycle.
-    KDRange trange = pruned_range;
-    trange.min.erase(trange.min.begin());
-    trange.max.erase(trange.max.begin());
+    ptsr = new Tensor(without_edman_cycle(pruned_range));
+    // Nothing is computed yet. Most dye seqs have far fewer dyes than
+    // max_num_dyes, so their HMMs prune this range down much further, and the
+    // rest is filled in by ensure_computed() only as it is needed.
+    computed_range = new KDRange();
+    computed_range->min.resize(num_channels, 0);
+    computed_range->max.resize(num_channels, 0);
+}
+
+PeptideEmission::PeptideEmission(const vector<const PeptideEmission*>& batch)
+        // The radiometry isn't meaningful for a batched emission, but it must
+        // refer to something.
+        : radiometry(batch[0]->radiometry),
+          seq_model(batch[0]->seq_model),
+          emission_precomputations(NULL),
+          timestep(batch[0]->timestep),
+          i_am_a_copy(false),
+          num_channels(batch[0]->num_channels),
+          max_num_dyes(batch[0]->max_num_dyes),
+          batch_size(batch.size()),
+          batch_p_detached(batch.size(), 0.0) {
+    pruned_range = batch[0]->pruned_range;
+    for (unsigned int b = 1; b < batch_size; b++) {
+        pruned_range = pruned_range.bounding_union(batch[b]->pruned_range);
+    }
+    // As in the other constructor, ptsr doesn't include the Edman cycle, but
+    // this time we add the lane dimension at the end.
+    KDRange trange = batch[0]->ptsr->range;
+    for (unsigned int b = 1; b < batch_size; b++) {
+        trange = trange.bounding_union(batch[b]->ptsr->range);
+    }
+    trange.min.push_back(0);
+    trange.max.push_back(batch_size);
+    // Newly constructed tensors are zeroed, so the emission probability of a
+    // lane is zero wherever that lane's own emission was pruned.
     ptsr = new Tensor(trange);
-    TensorIterator* it = ptsr->iterator(trange);
-    while (!it->done()) {
-        *it->get() = 1.0;
-        for (unsigned int c = 0; c < num_channels; c++) {
-            double observed = radiometry(timestep, c);
-            *it->get() *= seq_model.channel_models[c]->pdf(observed, it->loc);
+    computed_range = new KDRange(trange);
+    for (unsigned int b = 0; b < batch_size; b++) {
+        const Tensor& lane_ptsr = *batch[b]->ptsr;
+        // The whole of the lane's ptsr is copied, so all of it is needed.
+        // ensure_computed() wants the Edman cycle dimension too.
+        KDRange lane_range = lane_ptsr.range;
+        lane_range.min.insert(lane_range.min.begin(), 0);
+        lane_range.max.insert(lane_range.max.begin(), 1);
+        batch[b]->ensure_computed(lane_range);
+        for_each_row<0>(
+                lane_ptsr.range,
+                [&](const unsigned int* loc, unsigned int length) {
+                    const double* in =
+                            &lane_ptsr.values[lane_ptsr.offset<0>(loc)];
+                    // Location in ptsr of the start of the row, for lane b.
+                    unsigned int out_i = b;
+                    for (unsigned int c = 0; c < num_channels; c++) {
+                        out_i += ptsr->strides[c] * (loc[c] - trange.min[c]);
+                    }
+                    unsigned int out_stride = ptsr->strides[num_channels - 1];
+                    for (unsigned int i = 0; i < length; i++) {
+                        ptsr->values[out_i + i * out_stride] = in[i];
+                    }
+                });
+        // See forward_or_backward() for why the first value of the lane's ptsr
+        // is for the detached state.
+        if (batch[b]->pruned_range.includes_zero()) {
+            batch_p_detached[b] = lane_ptsr.values[0];
         }
-        it->advance();
     }
-    delete it;
 }
 
 PeptideEmission::PeptideEmission(const PeptideEmission& other)
         : radiometry(other.radiometry),
+          seq_model(other.seq_model),
+          emission_precomputations(other.emission_precomputations),
           timestep(other.timestep),
           pruned_range(other.pruned_range),
           ptsr(other.ptsr),
+          computed_range(other.computed_range),
           i_am_a_copy(true),
           num_channels(other.num_channels),
-          max_num_dyes(other.max_num_dyes) {}
+          max_num_dyes(other.max_num_dyes),
+          batch_size(other.batch_size),
+          batch_p_detached(other.batch_p_detached) {}
 
 PeptideEmission::~PeptideEmission() {
     if (!i_am_a_copy) {
         delete ptsr;
+        delete computed_range;
+    }
+}
+
+void PeptideEmission::ensure_computed(const KDRange& range) const {
+    KDRange trange = without_edman_cycle(range);
+    if (computed_range->contains(trange)) {
+        return;
+    }
+    // The computed part of ptsr must stay a box, so we grow it to the smallest
+    // box containing both, and fill in only the entries which are new.
+    KDRange old_range = *computed_range;
+    *computed_range =
+            old_range.bounding_union(trange).intersect(ptsr->range);
+    unsigned int last = num_channels - 1;
+    vector<double> observed(num_channels);
+    for (unsigned int c = 0; c < num_channels; c++) {
+        observed[c] = radiometry(timestep, c);
+    }
+    vector<unsigned int> counts(num_channels);
+    for_each_row<0>(
+            *computed_range,
+            [&](const unsigned int* loc, unsigned int length) {
+                for (unsigned int c = 0; c < num_channels; c++) {
+                    counts[c] = loc[c];
+                }
+                double* out = &ptsr->values[ptsr->offset<0>(loc)];
+                unsigned int begin = loc[last];
+                unsigned int end = begin + length;
+                // If the row is within old_range in every other dimension,
+                // then the entries in old_range are one run in the middle,
+                // which we skip.
+                unsigned int skip_min = end;
+                unsigned int skip_max = end;
+                bool overlaps_old_range = !old_range.is_empty();
+                for (unsigned int c = 0; c < last; c++) {
+                    if (loc[c] < old_range.min[c]
+                        || loc[c] >= old_range.max[c]) {
+                        overlaps_old_range = false;
+                    }
+                }
+                if (overlaps_old_range) {
+                    skip_min = old_range.min[last];
+                    skip_max = old_range.max[last];
+                }
+                compute_run(&observed[0], &counts[0], begin, skip_min, out);
+                compute_run(&observed[0],
+                            &counts[0],
+                            skip_max,
+                            end,
+                            &out[skip_max - begin]);
+            });
+}
+
+void PeptideEmission::compute_run(const double* observed,
+                                  unsigned int* counts,
+                                  unsigned int begin,
+                                  unsigned int end,
+                                  double* out) const {
+    if (begin >= end) {
+        return;
     }
+    unsigned int last = num_channels - 1;
+    counts[last] = begin;
+    if (emission_precomputations != NULL) {
+        emission_precomputations->pdf_row(observed, counts, end - begin, out);
+        return;
+    }
+    for (unsigned int i = 0; i < end - begin; i++) {
+        counts[last] = begin + i;
+        out[i] = 1.0;
+        for (unsigned int c = 0; c < num_channels; c++) {
+            out[i] *= seq_model.channel_models[c]->pdf(observed[c], counts);
+        }
+    }
+}
+
+double PeptideEmission::max_probability() const {
+    double result = 0.0;
+    if (batch_size != 0) {
+        for (unsigned int i = 0; i < ptsr->size; i++) {
+            result = max(result, ptsr->values[i]);
+        }
+        return result;
+    }
+    ensure_computed(pruned_range);
+    KDRange trange = without_edman_cycle(pruned_range).intersect(ptsr->range);
+    for_each_row<0>(trange, [&](const unsigned int* loc, unsigned int length) {
+        const double* prob = &ptsr->values[ptsr->offset<0>(loc)];
+        for (unsigned int i = 0; i < length; i++) {
+            result = max(result, prob[i]);
+        }
+    });
+    return result;
 }
 
 void PeptideEmission::prune_forward(KDRange* range, bool* allow_detached) {
@@ -209,47 +374,112 @@ void PeptideEmission::prune_backward(KDRange* range, bool* allow_detached) {
     *allow_detached = this->allow_detached;
 }
 
-PeptideStateVector* PeptideEmission::forward_or_backward(
-        const PeptideStateVector& input, unsigned int* num_edmans) const {
-    vector<unsigned int> zeros(num_channels, 0);
-    PeptideStateVector* output = new PeptideStateVector(pruned_range);
+void PeptideEmission::forward_or_backward(const PeptideStateVector& input,
+                                          unsigned int* num_edmans,
+                                          PeptideStateVector* output) const {
+    ensure_computed(pruned_range);
+    output->resize(pruned_range);
     forward_or_backward(input.tensor, &output->tensor);
     forward_or_backward(input.broken_n_tensor, &output->broken_n_tensor);
     if (allow_detached) {
         // This is safe because the allow_detached is only true if pruned_range
-        // includes zero.
-        double prob = (*ptsr)[&zeros[0]];
+        // includes zero, in which case the zero location is the first entry
+        // of ptsr.
+        double prob = ptsr->values[0];
         output->p_detached = input.p_detached * prob;
     }
     output->range = pruned_range;
     output->allow_detached = allow_detached;
-    return output;
 }
 
 void PeptideEmission::forward_or_backward(const Tensor& input,
                                           Tensor* output) const {
-    ConstTensorIterator* inputit = input.const_iterator(pruned_range);
-    TensorIterator* outputit = output->iterator(pruned_range);
-    while (!inputit->done()) {
+    dispatch_order(pruned_range.min.size(), [&](auto o) {
+        const unsigned int ORDER = decltype(o)::value;
         // Edman cycle is always the 0th index. We need to snag the rest of the
-        // index since the values aren't indexed by Edman cycle.
-        double prob = (*ptsr)[&inputit->loc[1]];
-        *outputit->get() = *inputit->get() * prob;
-        inputit->advance();
-        outputit->advance();
-    }
-    delete inputit;
-    delete outputit;
+        // location since ptsr isn't indexed by Edman cycle, so ptsr has one
+        // less dimension (or zero stays zero, meaning order is not fixed).
+        const unsigned int PTSR_ORDER = (ORDER != 0) ? ORDER - 1 : 0;
+        for_each_row<ORDER>(
+                pruned_range,
+                [&](const unsigned int* loc, unsigned int length) {
+                    const double* in = &input.values[input.offset<ORDER>(loc)];
+                    double* out = &output->values[output->offset<ORDER>(loc)];
+                    const double* prob =
+                            &ptsr->values[ptsr->offset<PTSR_ORDER>(&loc[1])];
+                    for (unsigned int i = 0; i < length; i++) {
+                        out[i] = in[i] * prob[i];
+                    }
+                });
+    });
+}
+
+void PeptideEmission::forward(const PeptideStateVector& input,
+                              unsigned int* num_edmans,
+                              PeptideStateVector* output) const {
+    forward_or_backward(input, num_edmans, output);
 }
 
-PeptideStateVector* PeptideEmission::forward(const PeptideStateVector& input,
-                                             unsigned int* num_edmans) const {
-    return forward_or_backward(input, num_edmans);
+void PeptideEmission::backward(const PeptideStateVector& input,
+                               unsigned int* num_edmans,
+                               PeptideStateVector* output) const {
+    forward_or_backward(input, num_edmans, output);
 }
 
-PeptideStateVector* PeptideEmission::backward(const PeptideStateVector& input,
-                                              unsigned int* num_edmans) const {
-    return forward_or_backward(input, num_edmans);
+void PeptideEmission::forward_batch(const BatchPeptideStateVector& input,
+                                    unsigned int* num_edmans,
+                                    BatchPeptideStateVector* output) const {
+    if (batch_size == 0) {
+        ensure_computed(pruned_range);
+    }
+    output->resize(pruned_range, input.batch_size);
+    KDRange range = BatchPeptideStateVector::batch_range(pruned_range,
+                                                         input.batch_size);
+    dispatch_order(range.min.size(), [&](auto o) {
+        const unsigned int ORDER = decltype(o)::value;
+        // As in forward_or_backward(), ptsr is not indexed by Edman cycle. It
+        // is indexed by lane only if this is a batched emission. Zero stays
+        // zero, meaning the order is not fixed.
+        const unsigned int PTSR_ORDER = (ORDER >= 2) ? ORDER - 1 : 0;
+        const unsigned int UNBATCHED_PTSR_ORDER = (ORDER >= 3) ? ORDER - 2 : 0;
+        for_each_row<ORDER>(
+                range,
+                [&](const unsigned int* loc, unsigned int length) {
+                    // tensor and broken_n_tensor always have the same shape.
+                    unsigned int i = input.tensor.offset<ORDER>(loc);
+                    unsigned int j = output->tensor.offset<ORDER>(loc);
+                    const double* in = &input.tensor.values[i];
+                    const double* n_in = &input.broken_n_tensor.values[i];
+                    double* out = &output->tensor.values[j];
+                    double* n_out = &output->broken_n_tensor.values[j];
+                    if (batch_size == 0) {
+                        double prob = ptsr->values[ptsr->offset<
+                                UNBATCHED_PTSR_ORDER>(&loc[1])];
+                        for (unsigned int b = 0; b < length; b++) {
+                            out[b] = in[b] * prob;
+                            n_out[b] = n_in[b] * prob;
+                        }
+                    } else {
+                        const double* prob =
+                                &ptsr->values[ptsr->offset<PTSR_ORDER>(
+                                        &loc[1])];
+                        for (unsigned int b = 0; b < length; b++) {
+                            out[b] = in[b] * prob[b];
+                            n_out[b] = n_in[b] * prob[b];
+                        }
+                    }
+                });
+    });
+    if (allow_detached) {
+        for (unsigned int b = 0; b < input.batch_size; b++) {
+            // See forward_or_backward() regarding ptsr->values[0].
+            double prob = (batch_size == 0) ? ptsr->values[0]
+                                            : batch_p_detached[b];
+            output->p_detached[b] = input.p_detached[b] * prob;
+        }
+    }
+    output->range = pruned_range;
+    output->allow_detached = allow_detached;
 }
 
 void PeptideEmission::improve_fit(const PeptideStateVector& forward_psv,
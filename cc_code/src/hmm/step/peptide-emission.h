@@ -14,6 +14,8 @@
 
 // Local project headers:
 #include "common/radiometry.h"
+#include "hmm/precomputations/emission-precomputations.h"
+#include "hmm/state-vector/batch-peptide-state-vector.h"
 #include "hmm/state-vector/peptide-state-vector.h"
 #include "hmm/step/peptide-step.h"
 #include "parameterization/fit/sequencing-model-fitter.h"
@@ -26,24 +28,60 @@ namespace whatprot {
 
 class PeptideEmission : public PeptideStep {
 public:
+    // This next line makes the allocating versions of forward() and backward()
+    // from Step visible alongside the overrides below.
+    using PeptideStep::backward;
+    using PeptideStep::forward;
     PeptideEmission(const Radiometry& radiometry,
                     unsigned int timestep,
                     unsigned int max_num_dyes,
                     const SequencingModel& seq_model,
                     const SequencingSettings& seq_settings);
+    // Combines the emissions for the same timestep of several radiometries
+    // into one emission for use with forward_batch(), where the radiometry
+    // batch[b] gets lane b. The pruned_range is the smallest range containing
+    // the pruned_range of every emission in the batch, and ptsr gets an extra
+    // dimension at the end for the lane. An emission made this way must ONLY
+    // be used through forward_batch().
+    PeptideEmission(const std::vector<const PeptideEmission*>& batch);
     PeptideEmission(const PeptideEmission& other);
     virtual ~PeptideEmission();
+    // The emission probabilities in ptsr are only computed when they are first
+    // needed. This computes (once) every emission probability within range,
+    // which includes the Edman cycle dimension like pruned_range does. This is
+    // done automatically by forward(), backward(), and forward_batch() for the
+    // pruned_range, but must be called before reading ptsr directly. Not
+    // needed for a batched emission, which is always computed in full.
+    void ensure_computed(const KDRange& range) const;
+    // Largest emission probability within the pruned_range (or anywhere, for a
+    // batched emission). This is zero if the pruned_range is empty.
+    double max_probability() const;
+    // Computes the emission probabilities for the dye counts given by counts
+    // with the count of the last channel set to each of begin through end - 1,
+    // writing them to out[0] through out[end - begin - 1]. The count of the
+    // last channel is changed, but the others are left as they are.
+    void compute_run(const double* observed,
+                     unsigned int* counts,
+                     unsigned int begin,
+                     unsigned int end,
+                     double* out) const;
     virtual void prune_forward(KDRange* range, bool* allow_detached) override;
     virtual void prune_backward(KDRange* range, bool* allow_detached) override;
-    PeptideStateVector* forward_or_backward(const PeptideStateVector& input,
-                                            unsigned int* num_edmans) const;
+    void forward_or_backward(const PeptideStateVector& input,
+                             unsigned int* num_edmans,
+                             PeptideStateVector* output) const;
     void forward_or_backward(const Tensor& input, Tensor* output) const;
-    virtual PeptideStateVector* forward(
-            const PeptideStateVector& input,
-            unsigned int* num_edmans) const override;
-    virtual PeptideStateVector* backward(
-            const PeptideStateVector& input,
-            unsigned int* num_edmans) const override;
+    virtual void forward(const PeptideStateVector& input,
+                         unsigned int* num_edmans,
+                         PeptideStateVector* output) const override;
+    virtual void backward(const PeptideStateVector& input,
+                          unsigned int* num_edmans,
+                          PeptideStateVector* output) const override;
+    // If this is a batched emission (see above) each lane uses its own
+    // emission probabilities. Otherwise every lane uses the same ones.
+    virtual void forward_batch(const BatchPeptideStateVector& input,
+                               unsigned int* num_edmans,
+                               BatchPeptideStateVector* output) const override;
     // This improve_fit() function currently does nothing. While fitting normal
     // distributions in addition to other parameters during parameter fitting
     // with whatprot's HMMs worked well on simulated data, the mismatch in
@@ -59,17 +97,31 @@ public:
                              double probability,
                              SequencingModelFitter* fitter) const override;
     const Radiometry& radiometry;
+    const SequencingModel& seq_model;
+    // If not NULL, the emission probabilities are computed from these tables
+    // rather than by calling ChannelModel::pdf() directly. Not owned.
+    const EmissionPrecomputations* emission_precomputations;
     unsigned int timestep;
     KDRange pruned_range;
     bool allow_detached;
     // This is a pointer so that endless copies of PeptideEmission can be made
     // with minimal resource requirements.
     Tensor* ptsr;
+    // The part of ptsr which has been computed so far (see ensure_computed()).
+    // This is shared between copies along with ptsr; the values for one
+    // radiometry are then computed at most once, no matter how many dye seqs
+    // they are used for.
+    KDRange* computed_range;
     // We need to know whether this instance is a copy to know whether to delete
-    // ptsr when the destructor is called.
+    // ptsr and computed_range when the destructor is called.
     bool i_am_a_copy;
     unsigned int num_channels;
     unsigned int max_num_dyes;
+    // Number of lanes for a batched emission, or zero if not batched.
+    unsigned int batch_size;
+    // For a batched emission, the emission probability of the detached state
+    // for each lane (zero if pruned out for that lane).
+    std::vector<double> batch_p_detached;
 };
 
 }  // namespace whatprot
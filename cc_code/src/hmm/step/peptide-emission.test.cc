@@ -22,12 +22,14 @@
 
 // Local project headers:
 #include "common/radiometry.h"
+#include "hmm/state-vector/batch-peptide-state-vector.h"
 #include "parameterization/fit/log-normal-distribution-fitter.h"
 #include "parameterization/fit/sequencing-model-fitter.h"
 #include "parameterization/model/sequencing-model.h"
 #include "parameterization/settings/sequencing-settings.h"
 #include "tensor/tensor.h"
 #include "test-util/fakeit.h"
+#include "util/kd-range.h"
 
 namespace whatprot {
 
@@ -66,6 +68,7 @@ BOOST_AUTO_TEST_CASE(constructor_test, *tolerance(TOL)) {
     SequencingSettings seq_settings;
     seq_settings.dist_cutoff = numeric_limits<double>::max();
     PeptideEmission e(rad, timestep, max_num_dyes, seq_model, seq_settings);
+    e.ensure_computed(e.pruned_range);
     BOOST_TEST(e.ptsr->range.min.size() == num_channels);
     BOOST_TEST(e.ptsr->range.min[0] == 0u);
     BOOST_TEST(e.ptsr->range.max.size() == num_channels);
@@ -100,6 +103,7 @@ BOOST_AUTO_TEST_CASE(constructor_no_cutoff_test, *tolerance(TOL)) {
     SequencingSettings seq_settings;
     seq_settings.dist_cutoff = std::numeric_limits<double>::max();
     PeptideEmission e(rad, timestep, max_num_dyes, seq_model, seq_settings);
+    e.ensure_computed(e.pruned_range);
     BOOST_TEST(e.ptsr->range.min.size() == num_channels);
     BOOST_TEST(e.ptsr->range.min[0] == 0u);
     BOOST_TEST(e.ptsr->range.max.size() == num_channels);
@@ -139,6 +143,7 @@ BOOST_AUTO_TEST_CASE(ptsr_multiple_timesteps_test, *tolerance(TOL)) {
     SequencingSettings seq_settings;
     seq_settings.dist_cutoff = std::numeric_limits<double>::max();
     PeptideEmission e(rad, timestep, max_num_dyes, seq_model, seq_settings);
+    e.ensure_computed(e.pruned_range);
     BOOST_TEST(e.ptsr->range.min.size() == num_channels);
     BOOST_TEST(e.ptsr->range.min[0] == 0u);
     BOOST_TEST(e.ptsr->range.max.size() == num_channels);
@@ -174,6 +179,7 @@ BOOST_AUTO_TEST_CASE(ptsr_multiple_channels_test, *tolerance(TOL)) {
     SequencingSettings seq_settings;
     seq_settings.dist_cutoff = std::numeric_limits<double>::max();
     PeptideEmission e(rad, timestep, max_num_dyes, seq_model, seq_settings);
+    e.ensure_computed(e.pruned_range);
     BOOST_TEST(e.ptsr->range.min.size() == num_channels);
     BOOST_TEST(e.ptsr->range.min[0] == 0u);
     BOOST_TEST(e.ptsr->range.min[1] == 0u);
@@ -233,6 +239,7 @@ BOOST_AUTO_TEST_CASE(ptsr_multiple_channels_different_pdfs_test,
     SequencingSettings seq_settings;
     seq_settings.dist_cutoff = std::numeric_limits<double>::max();
     PeptideEmission e(rad, timestep, max_num_dyes, seq_model, seq_settings);
+    e.ensure_computed(e.pruned_range);
     BOOST_TEST(e.ptsr->range.min.size() == num_channels);
     BOOST_TEST(e.ptsr->range.min[0] == 0u);
     BOOST_TEST(e.ptsr->range.min[1] == 0u);
@@ -271,6 +278,7 @@ BOOST_AUTO_TEST_CASE(ptsr_multiple_dye_counts_test, *tolerance(TOL)) {
     SequencingSettings seq_settings;
     seq_settings.dist_cutoff = std::numeric_limits<double>::max();
     PeptideEmission e(rad, timestep, max_num_dyes, seq_model, seq_settings);
+    e.ensure_computed(e.pruned_range);
     BOOST_TEST(e.ptsr->range.min.size() == num_channels);
     BOOST_TEST(e.ptsr->range.min[0] == 0u);
     BOOST_TEST(e.ptsr->range.max.size() == num_channels);
@@ -312,6 +320,7 @@ BOOST_AUTO_TEST_CASE(ptsr_multiple_everything_test, *tolerance(TOL)) {
     SequencingSettings seq_settings;
     seq_settings.dist_cutoff = std::numeric_limits<double>::max();
     PeptideEmission e(rad, timestep, max_num_dyes, seq_model, seq_settings);
+    e.ensure_computed(e.pruned_range);
     BOOST_TEST(e.ptsr->range.min.size() == num_channels);
     BOOST_TEST(e.ptsr->range.min[0] == 0u);
     BOOST_TEST(e.ptsr->range.min[1] == 0u);
@@ -339,6 +348,92 @@ BOOST_AUTO_TEST_CASE(ptsr_multiple_everything_test, *tolerance(TOL)) {
     seq_model.channel_models.resize(0);
 }
 
+BOOST_AUTO_TEST_CASE(ensure_computed_lazy_test, *tolerance(TOL)) {
+    unsigned int num_timesteps = 1;
+    unsigned int num_channels = 2;
+    Radiometry rad(num_timesteps, num_channels);
+    rad(0, 0) = 1.0;
+    rad(0, 1) = 1.1;
+    unsigned int max_num_dyes = 3;
+    SequencingModel seq_model;
+    Mock<ChannelModel> cm_mock;
+    unsigned int num_calls = 0;
+    When(ConstOverloadedMethod(
+                 cm_mock, pdf, double(double, const unsigned int*)))
+            .AlwaysDo([&num_calls](double observed,
+                                   const unsigned int* counts) -> double {
+                num_calls++;
+                return (observed + 0.042)
+                       / (double)(counts[0] + 3.14 * counts[1] + 7);
+            });
+    When(Method(cm_mock, sigma)).AlwaysReturn(0.5);
+    seq_model.channel_models.push_back(&cm_mock.get());
+    seq_model.channel_models.push_back(&cm_mock.get());
+    unsigned int timestep = 0;
+    SequencingSettings seq_settings;
+    seq_settings.dist_cutoff = std::numeric_limits<double>::max();
+    PeptideEmission e(rad, timestep, max_num_dyes, seq_model, seq_settings);
+    BOOST_TEST(num_calls == 0u);
+    KDRange range;
+    range.min = {0, 0, 1};
+    range.max = {1, 2, 3};
+    e.ensure_computed(range);
+    // Two calls to pdf (one per channel) for each of the four entries.
+    BOOST_TEST(num_calls == 8u);
+    // Copies share what has been computed.
+    PeptideEmission e_copy(e);
+    e_copy.ensure_computed(range);
+    BOOST_TEST(num_calls == 8u);
+    // Growing the range only computes the entries which are new; the computed
+    // part becomes [0, 3) x [0, 3), five more entries.
+    range.min = {0, 1, 0};
+    range.max = {1, 3, 2};
+    e_copy.ensure_computed(range);
+    BOOST_TEST(num_calls == 18u);
+    vector<unsigned int> counts(num_channels);
+    for (unsigned int i = 0; i < 3; i++) {
+        for (unsigned int j = 0; j < 3; j++) {
+            counts = {i, j};
+            BOOST_TEST((*e.ptsr)[&counts[0]]
+                       == cm_mock.get().pdf(1.0, &counts[0])
+                                  * cm_mock.get().pdf(1.1, &counts[0]));
+        }
+    }
+    // Avoid double clean-up:
+    seq_model.channel_models.resize(0);
+}
+
+BOOST_AUTO_TEST_CASE(max_probability_test, *tolerance(TOL)) {
+    unsigned int num_timesteps = 1;
+    unsigned int num_channels = 1;
+    Radiometry rad(num_timesteps, num_channels);
+    rad(0, 0) = 1.0;
+    unsigned int max_num_dyes = 3;
+    SequencingModel seq_model;
+    Mock<ChannelModel> cm_mock;
+    When(ConstOverloadedMethod(
+                 cm_mock, pdf, double(double, const unsigned int*)))
+            .AlwaysDo(
+                    [](double observed, const unsigned int* counts) -> double {
+                        return 0.1 * (double)(counts[0] + 1);
+                    });
+    When(Method(cm_mock, sigma)).AlwaysReturn(0.5);
+    seq_model.channel_models.push_back(&cm_mock.get());
+    unsigned int timestep = 0;
+    SequencingSettings seq_settings;
+    seq_settings.dist_cutoff = std::numeric_limits<double>::max();
+    PeptideEmission e(rad, timestep, max_num_dyes, seq_model, seq_settings);
+    BOOST_TEST(e.max_probability() == 0.4);
+    e.pruned_range.min = {0, 1};
+    e.pruned_range.max = {1, 3};
+    BOOST_TEST(e.max_probability() == 0.3);
+    e.pruned_range.min = {0, 2};
+    e.pruned_range.max = {1, 2};
+    BOOST_TEST(e.max_probability() == 0.0);
+    // Avoid double clean-up:
+    seq_model.channel_models.resize(0);
+}
+
 BOOST_AUTO_TEST_CASE(forward_trivial_test, *tolerance(TOL)) {
     unsigned int num_timesteps = 1;
     unsigned int num_channels = 1;
@@ -938,6 +1033,111 @@ BOOST_AUTO_TEST_CASE(forward_multiple_everything_test, *tolerance(TOL)) {
     delete psv2;
 }
 
+BOOST_AUTO_TEST_CASE(batch_constructor_test, *tolerance(TOL)) {
+    unsigned int num_timesteps = 1;
+    unsigned int num_channels = 1;
+    Radiometry rad0(num_timesteps, num_channels);
+    rad0(0, 0) = 2.0;
+    Radiometry rad1(num_timesteps, num_channels);
+    rad1(0, 0) = 3.0;
+    unsigned int max_num_dyes = 2;
+    SequencingModel seq_model;
+    Mock<ChannelModel> cm_mock;
+    When(ConstOverloadedMethod(
+                 cm_mock, pdf, double(double, const unsigned int*)))
+            .AlwaysDo(
+                    [](double observed, const unsigned int* counts) -> double {
+                        return observed / (double)(counts[0] + 7);
+                    });
+    When(Method(cm_mock, sigma)).AlwaysReturn(0.5);
+    seq_model.channel_models.push_back(&cm_mock.get());
+    unsigned int timestep = 0;
+    SequencingSettings seq_settings;
+    seq_settings.dist_cutoff = numeric_limits<double>::max();
+    PeptideEmission e0(rad0, timestep, max_num_dyes, seq_model, seq_settings);
+    PeptideEmission e1(rad1, timestep, max_num_dyes, seq_model, seq_settings);
+    // Lane one can't be detached.
+    e1.pruned_range.min = {0, 1};
+    PeptideEmission e({&e0, &e1});
+    BOOST_TEST(e.batch_size == 2u);
+    BOOST_TEST(e.ptsr->range.min.size() == 2u);
+    BOOST_TEST(e.ptsr->range.min[0] == 0u);
+    BOOST_TEST(e.ptsr->range.min[1] == 0u);
+    BOOST_TEST(e.ptsr->range.max.size() == 2u);
+    BOOST_TEST(e.ptsr->range.max[0] == max_num_dyes + 1);
+    BOOST_TEST(e.ptsr->range.max[1] == 2u);
+    BOOST_TEST(((*e.ptsr)[{0, 0}]) == 2.0 / 7.0);
+    BOOST_TEST(((*e.ptsr)[{0, 1}]) == 3.0 / 7.0);
+    BOOST_TEST(((*e.ptsr)[{1, 0}]) == 2.0 / 8.0);
+    BOOST_TEST(((*e.ptsr)[{1, 1}]) == 3.0 / 8.0);
+    BOOST_TEST(((*e.ptsr)[{2, 0}]) == 2.0 / 9.0);
+    BOOST_TEST(((*e.ptsr)[{2, 1}]) == 3.0 / 9.0);
+    BOOST_TEST(e.batch_p_detached[0] == 2.0 / 7.0);
+    BOOST_TEST(e.batch_p_detached[1] == 0.0);
+    BOOST_TEST(e.pruned_range.min[0] == 0u);
+    BOOST_TEST(e.pruned_range.min[1] == 0u);
+    BOOST_TEST(e.pruned_range.max[0] == 1u);
+    BOOST_TEST(e.pruned_range.max[1] == max_num_dyes + 1);
+    // Avoid double clean-up:
+    seq_model.channel_models.resize(0);
+}
+
+BOOST_AUTO_TEST_CASE(forward_batch_test, *tolerance(TOL)) {
+    unsigned int num_timesteps = 1;
+    unsigned int num_channels = 1;
+    Radiometry rad0(num_timesteps, num_channels);
+    rad0(0, 0) = 2.0;
+    Radiometry rad1(num_timesteps, num_channels);
+    rad1(0, 0) = 3.0;
+    unsigned int max_num_dyes = 1;
+    SequencingModel seq_model;
+    Mock<ChannelModel> cm_mock;
+    When(ConstOverloadedMethod(
+                 cm_mock, pdf, double(double, const unsigned int*)))
+            .AlwaysDo(
+                    [](double observed, const unsigned int* counts) -> double {
+                        return observed / (double)(counts[0] + 7);
+                    });
+    When(Method(cm_mock, sigma)).AlwaysReturn(0.5);
+    seq_model.channel_models.push_back(&cm_mock.get());
+    unsigned int timestep = 0;
+    SequencingSettings seq_settings;
+    seq_settings.dist_cutoff = numeric_limits<double>::max();
+    PeptideEmission e0(rad0, timestep, max_num_dyes, seq_model, seq_settings);
+    PeptideEmission e1(rad1, timestep, max_num_dyes, seq_model, seq_settings);
+    PeptideEmission e({&e0, &e1});
+    e.allow_detached = true;
+    BatchPeptideStateVector bpsv1;
+    bpsv1.resize(e.pruned_range, 2);
+    bpsv1.tensor[{0, 0, 0}] = 0.1;
+    bpsv1.tensor[{0, 0, 1}] = 0.2;
+    bpsv1.tensor[{0, 1, 0}] = 0.3;
+    bpsv1.tensor[{0, 1, 1}] = 0.4;
+    bpsv1.broken_n_tensor[{0, 0, 0}] = 0.5;
+    bpsv1.broken_n_tensor[{0, 0, 1}] = 0.6;
+    bpsv1.broken_n_tensor[{0, 1, 0}] = 0.7;
+    bpsv1.broken_n_tensor[{0, 1, 1}] = 0.8;
+    bpsv1.p_detached[0] = 0.9;
+    bpsv1.p_detached[1] = 1.1;
+    unsigned int edmans = 0;
+    BatchPeptideStateVector bpsv2;
+    e.forward_batch(bpsv1, &edmans, &bpsv2);
+    BOOST_TEST(bpsv2.batch_size == 2u);
+    BOOST_TEST((bpsv2.tensor[{0, 0, 0}]) == 0.1 * 2.0 / 7.0);
+    BOOST_TEST((bpsv2.tensor[{0, 0, 1}]) == 0.2 * 3.0 / 7.0);
+    BOOST_TEST((bpsv2.tensor[{0, 1, 0}]) == 0.3 * 2.0 / 8.0);
+    BOOST_TEST((bpsv2.tensor[{0, 1, 1}]) == 0.4 * 3.0 / 8.0);
+    BOOST_TEST((bpsv2.broken_n_tensor[{0, 0, 0}]) == 0.5 * 2.0 / 7.0);
+    BOOST_TEST((bpsv2.broken_n_tensor[{0, 0, 1}]) == 0.6 * 3.0 / 7.0);
+    BOOST_TEST((bpsv2.broken_n_tensor[{0, 1, 0}]) == 0.7 * 2.0 / 8.0);
+    BOOST_TEST((bpsv2.broken_n_tensor[{0, 1, 1}]) == 0.8 * 3.0 / 8.0);
+    BOOST_TEST(bpsv2.p_detached[0] == 0.9 * 2.0 / 7.0);
+    BOOST_TEST(bpsv2.p_detached[1] == 1.1 * 3.0 / 7.0);
+    BOOST_TEST(bpsv2.allow_detached == true);
+    // Avoid double clean-up:
+    seq_model.channel_models.resize(0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()  // peptide_emission_suite
 BOOST_AUTO_TEST_SUITE_END()  // step_suite
 BOOST_AUTO_TEST_SUITE_END()  // hmm_suite
@@ -10,6 +10,7 @@
 #define WHATPROT_HMM_STEP_PEPTIDE_STEP_H
 
 // Local project headers:
+#include "hmm/state-vector/batch-peptide-state-vector.h"
 #include "hmm/state-vector/peptide-state-vector.h"
 #include "hmm/step/step.h"
 #include "util/kd-range.h"
@@ -36,6 +37,12 @@ public:
     // allow_detached indicates whether the detached state is possible, and
     // should be read and set appropriately.
     virtual void prune_backward(KDRange* range, bool* allow_detached) = 0;
+
+    // Same as forward(), but for every lane of a BatchPeptideStateVector at
+    // once. Only needed for classification, so there is no batched backward().
+    virtual void forward_batch(const BatchPeptideStateVector& input,
+                               unsigned int* num_edmans,
+                               BatchPeptideStateVector* output) const = 0;
 };
 
 }  // namespace whatprot
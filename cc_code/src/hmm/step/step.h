@@ -17,8 +17,31 @@ namespace whatprot {
 template <typename SV>  // SV is the state vector type.
 class Step {
 public:
-    virtual SV* forward(const SV& input, unsigned int* num_edmans) const = 0;
-    virtual SV* backward(const SV& input, unsigned int* num_edmans) const = 0;
+    // These write their results into output, which is resized as needed by
+    // the implementation. Passing the same output objects in over and over
+    // (see StateVectorArena) avoids allocating new memory on every step.
+    virtual void forward(const SV& input,
+                         unsigned int* num_edmans,
+                         SV* output) const = 0;
+    virtual void backward(const SV& input,
+                          unsigned int* num_edmans,
+                          SV* output) const = 0;
+
+    // Convenience versions of forward() and backward() which allocate a new
+    // state vector for the result. Caller takes ownership. Subclasses need a
+    // 'using' declaration to make these visible alongside their overrides.
+    SV* forward(const SV& input, unsigned int* num_edmans) const {
+        SV* output = new SV();
+        forward(input, num_edmans, output);
+        return output;
+    }
+
+    SV* backward(const SV& input, unsigned int* num_edmans) const {
+        SV* output = new SV();
+        backward(input, num_edmans, output);
+        return output;
+    }
+
     virtual void improve_fit(const SV& forward_states,
                              const SV& backward_states,
                              const SV& next_backward_states,
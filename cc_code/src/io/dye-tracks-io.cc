@@ -11,29 +11,160 @@
 
 // Standard C++ library headers:
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <limits>
 #include <string>
 #include <vector>
 
 // Local project headers:
 #include "common/dye-track.h"
 #include "common/sourced-data.h"
+#include "util/mapped-file.h"
 
 namespace whatprot {
 
 namespace {
 using std::copy;
 using std::ifstream;
+using std::int16_t;
+using std::int32_t;
+using std::memcmp;
+using std::memcpy;
+using std::memset;
+using std::numeric_limits;
 using std::ofstream;
+using std::size_t;
 using std::string;
+using std::uint32_t;
+using std::uint64_t;
 using std::vector;
+
+// Header of the binary format, exactly as it is laid out in the file.
+class BinaryHeader {
+public:
+    char magic[8];
+    uint32_t version;
+    uint32_t num_timesteps;
+    uint32_t num_channels;
+    uint32_t reserved;
+    uint64_t num_dye_tracks;
+    uint64_t num_sources;
+    uint64_t counts_offset;
+    uint64_t source_offsets_offset;
+    uint64_t sources_offset;
+};
+static_assert(sizeof(BinaryHeader) == DYE_TRACKS_BINARY_HEADER_SIZE,
+              "BinaryHeader must match the layout of the file.");
+// The sources in the file are used in place as SourceCountHits<int>.
+static_assert(sizeof(short) == sizeof(int16_t)
+                      && sizeof(SourceCountHits<int>) == 3 * sizeof(int32_t),
+              "Binary dye-track layout does not match the in-memory one.");
+
+// Rounds offset up to a multiple of eight bytes, so that the uint64 block after
+// it is aligned.
+uint64_t align_offset(uint64_t offset) {
+    return (offset + 7) / 8 * 8;
+}
+
+// Whether the header describes a file of this version, which fits in the
+// mapping, with every block aligned to its element size.
+bool is_valid_header(const BinaryHeader& header,
+                     const MappedFile& mapped_file) {
+    if (header.version != DYE_TRACKS_BINARY_VERSION
+        || header.num_timesteps == 0 || header.num_channels == 0
+        || header.counts_offset < sizeof(header)
+        || header.counts_offset % sizeof(int16_t) != 0
+        || header.source_offsets_offset % sizeof(uint64_t) != 0
+        || header.sources_offset % sizeof(int32_t) != 0) {
+        return false;
+    }
+    // The size of one dye-track is checked against the file before it is used
+    // in the other checks, so that computing it can't overflow. Each dye-track
+    // takes at least two bytes, so num_dye_tracks + 1 can't overflow either.
+    uint64_t track_size = (uint64_t)header.num_timesteps * header.num_channels;
+    return mapped_file.has_room(0, track_size, sizeof(int16_t))
+           && mapped_file.has_room(header.counts_offset,
+                                   header.num_dye_tracks,
+                                   track_size * sizeof(int16_t))
+           && mapped_file.has_room(header.source_offsets_offset,
+                                   header.num_dye_tracks + 1,
+                                   sizeof(uint64_t))
+           && mapped_file.has_room(header.sources_offset,
+                                   header.num_sources,
+                                   sizeof(SourceCountHits<int>));
+}
+
+// Returns false, having added no dye-tracks, if the file is not valid.
+bool read_dye_tracks_binary(
+        const MappedFile& mapped_file,
+        unsigned int* num_timesteps,
+        unsigned int* num_channels,
+        vector<SourcedData<DyeTrack, SourceCountHitsList<int>>>* dye_tracks) {
+    BinaryHeader header;
+    memcpy(&header, mapped_file.data, sizeof(header));
+    if (!is_valid_header(header, mapped_file)) {
+        return false;
+    }
+    // The mapping is page aligned and every block starts at an offset which is
+    // a multiple of its element size, so these casts are to properly aligned
+    // memory. The mapping is read-only, so nothing may write through them.
+    short* counts = (short*)(mapped_file.data + header.counts_offset);
+    const uint64_t* source_offsets =
+            (const uint64_t*)(mapped_file.data + header.source_offsets_offset);
+    SourceCountHits<int>* sources =
+            (SourceCountHits<int>*)(mapped_file.data + header.sources_offset);
+    // The sources of each dye-track must be a run of the sources, in order.
+    if (source_offsets[0] != 0
+        || source_offsets[header.num_dye_tracks] != header.num_sources) {
+        return false;
+    }
+    for (size_t i = 0; i < header.num_dye_tracks; i++) {
+        if (source_offsets[i + 1] < source_offsets[i]
+            || source_offsets[i + 1] - source_offsets[i]
+                       > (uint64_t)numeric_limits<int>::max()) {
+            return false;
+        }
+    }
+    *num_timesteps = header.num_timesteps;
+    *num_channels = header.num_channels;
+    unsigned int track_size = header.num_timesteps * header.num_channels;
+    dye_tracks->reserve(header.num_dye_tracks);
+    for (size_t i = 0; i < header.num_dye_tracks; i++) {
+        int num_sources = source_offsets[i + 1] - source_offsets[i];
+        dye_tracks->push_back(SourcedData<DyeTrack, SourceCountHitsList<int>>(
+                DyeTrack(*num_timesteps,
+                         *num_channels,
+                         &counts[i * track_size]),
+                SourceCountHitsList<int>(num_sources,
+                                         &sources[source_offsets[i]],
+                                         false)));  // owns_sources
+    }
+    return true;
+}
 }  // namespace
 
 void read_dye_tracks(
         const string& filename,
         unsigned int* num_timesteps,
         unsigned int* num_channels,
+        MappedFile** mapped_file,
         vector<SourcedData<DyeTrack, SourceCountHitsList<int>>>* dye_tracks) {
+    *mapped_file = new MappedFile(filename);
+    if ((*mapped_file)->size >= sizeof(BinaryHeader)
+        && 0 == memcmp((*mapped_file)->data, DYE_TRACKS_BINARY_MAGIC, 8)) {
+        if (!read_dye_tracks_binary(
+                    **mapped_file, num_timesteps, num_channels, dye_tracks)) {
+            delete *mapped_file;
+            *mapped_file = NULL;
+            *num_timesteps = 0;
+            *num_channels = 0;
+        }
+        return;
+    }
+    delete *mapped_file;
+    *mapped_file = NULL;
     unsigned int num_dye_tracks;
     ifstream f(filename);
     f >> *num_timesteps;
@@ -47,15 +178,11 @@ void read_dye_tracks(
         }
         int num_sources;
         f >> num_sources;
-        SourceCountHits<int>** sources = new SourceCountHits<int>*[num_sources];
+        SourceCountHits<int>* sources = new SourceCountHits<int>[num_sources];
         for (int j = 0; j < num_sources; j++) {
-            int id;
-            f >> id;
-            int count;
-            f >> count;
-            int hits;
-            f >> hits;
-            sources[j] = new SourceCountHits<int>(id, count, hits);
+            f >> sources[j].source;
+            f >> sources[j].count;
+            f >> sources[j].hits;
         }
         dye_tracks->push_back(SourcedData<DyeTrack, SourceCountHitsList<int>>(
                 dye_track, SourceCountHitsList<int>(num_sources, sources)));
@@ -75,6 +202,52 @@ void write_dye_tracks(
             filename, num_timesteps, num_channels, new_dye_tracks);
 }
 
+void write_dye_tracks_binary(
+        const string& filename,
+        unsigned int num_timesteps,
+        unsigned int num_channels,
+        const vector<SourcedData<DyeTrack, SourceCountHitsList<int>>>&
+                dye_tracks) {
+    unsigned int track_size = num_timesteps * num_channels;
+    vector<uint64_t> source_offsets(dye_tracks.size() + 1);
+    source_offsets[0] = 0;
+    for (size_t i = 0; i < dye_tracks.size(); i++) {
+        source_offsets[i + 1] =
+                source_offsets[i] + dye_tracks[i].source.num_sources;
+    }
+    BinaryHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, DYE_TRACKS_BINARY_MAGIC, 8);
+    header.version = DYE_TRACKS_BINARY_VERSION;
+    header.num_timesteps = num_timesteps;
+    header.num_channels = num_channels;
+    header.num_dye_tracks = dye_tracks.size();
+    header.num_sources = source_offsets.back();
+    header.counts_offset = sizeof(header);
+    header.source_offsets_offset = align_offset(
+            header.counts_offset
+            + header.num_dye_tracks * track_size * sizeof(int16_t));
+    header.sources_offset = header.source_offsets_offset
+                            + source_offsets.size() * sizeof(uint64_t);
+    ofstream f(filename, ofstream::binary);
+    f.write((const char*)&header, sizeof(header));
+    for (const auto& dye_track : dye_tracks) {
+        f.write((const char*)&dye_track.value.counts[0],
+                track_size * sizeof(int16_t));
+    }
+    uint64_t padding = 0;
+    f.write((const char*)&padding,
+            header.source_offsets_offset - header.counts_offset
+                    - header.num_dye_tracks * track_size * sizeof(int16_t));
+    f.write((const char*)&source_offsets[0],
+            source_offsets.size() * sizeof(uint64_t));
+    for (const auto& dye_track : dye_tracks) {
+        f.write((const char*)dye_track.source.sources,
+                dye_track.source.num_sources * sizeof(SourceCountHits<int>));
+    }
+    f.close();
+}
+
 void write_dye_tracks_helper(
         const string& filename,
         unsigned int num_timesteps,
@@ -91,9 +264,9 @@ void write_dye_tracks_helper(
         }
         f << dye_track.source.num_sources << "\t";
         for (int i = 0; i < dye_track.source.num_sources; i++) {
-            f << dye_track.source.sources[i]->source << "\t";
-            f << dye_track.source.sources[i]->count << "\t";
-            f << dye_track.source.sources[i]->hits;
+            f << dye_track.source.sources[i].source << "\t";
+            f << dye_track.source.sources[i].count << "\t";
+            f << dye_track.source.sources[i].hits;
             if (i < dye_track.source.num_sources - 1) {
                 f << "\t";
             }
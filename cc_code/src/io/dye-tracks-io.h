@@ -16,13 +16,45 @@
 // Local project headers:
 #include "common/dye-track.h"
 #include "common/sourced-data.h"
+#include "util/mapped-file.h"
 
 namespace whatprot {
 
+// Dye-tracks can be stored either as tab-separated text, or in a binary format
+// which is much faster to load. The binary format is laid out as columns, each
+// contiguous, in native byte order:
+//   - A header of DYE_TRACKS_BINARY_HEADER_SIZE bytes: the eight characters of
+//     DYE_TRACKS_BINARY_MAGIC, then as uint32s the version, num_timesteps,
+//     num_channels, and a zero, then as uint64s num_dye_tracks, the total
+//     number of sources over all dye-tracks, and the byte offsets of the
+//     counts, the source offsets, and the sources.
+//   - The counts as int16s, one dye-track after another, ordered as in
+//     DyeTrack::counts.
+//   - The source offsets, as num_dye_tracks + 1 uint64s. The sources of
+//     dye-track i are entries offsets[i] up to offsets[i + 1] of the sources.
+//   - The sources, each as the int32s source, count, and hits of a
+//     SourceCountHits<int>.
+// read_dye_tracks() recognizes the binary format by its magic, so either
+// format can be given.
+const char DYE_TRACKS_BINARY_MAGIC[] = "WPDTKBIN";
+const unsigned int DYE_TRACKS_BINARY_HEADER_SIZE = 64;
+const unsigned int DYE_TRACKS_BINARY_VERSION = 1;
+
+// If the file is in the binary format, it is left mapped in *mapped_file, and
+// the sources of the dye-tracks are views into that mapping rather than
+// copies; *mapped_file must then not be deleted while the sources of the
+// dye-tracks (or of anything they are moved into) are still in use. For a text
+// file *mapped_file is set to NULL.
+//
+// The header of a binary file is checked against the size of the file, as are
+// the source offsets against the sources. If the file is of another version,
+// or is damaged or cut short, *num_timesteps is set to zero, *mapped_file to
+// NULL, and no dye-tracks are read.
 void read_dye_tracks(
         const std::string& filename,
         unsigned int* num_timesteps,
         unsigned int* num_channels,
+        MappedFile** mapped_file,
         std::vector<SourcedData<DyeTrack, SourceCountHitsList<int>>>*
                 dye_tracks);
 
@@ -48,6 +80,13 @@ void write_dye_tracks(
         const std::vector<SourcedData<DyeTrack, SourceCountHitsList<int>>>&
                 dye_tracks);
 
+void write_dye_tracks_binary(
+        const std::string& filename,
+        unsigned int num_timesteps,
+        unsigned int num_channels,
+        const std::vector<SourcedData<DyeTrack, SourceCountHitsList<int>>>&
+                dye_tracks);
+
 void write_dye_tracks_helper(
         const string& filename,
         unsigned int num_timesteps,
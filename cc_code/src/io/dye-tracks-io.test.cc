@@ -0,0 +1,228 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+// Boost unit test framework (recommended to be the first include):
+#include <boost/test/unit_test.hpp>
+
+// File under test:
+#include "dye-tracks-io.h"
+
+// Standard C++ library headers:
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Local project headers:
+#include "common/dye-track.h"
+#include "common/sourced-data.h"
+#include "util/mapped-file.h"
+
+namespace whatprot {
+
+namespace {
+using std::ifstream;
+using std::istreambuf_iterator;
+using std::ofstream;
+using std::remove;
+using std::string;
+using std::uint32_t;
+using std::uint64_t;
+using std::vector;
+
+// Offsets of some fields of the binary header, as documented in the header.
+const unsigned int VERSION_POS = 8;
+const unsigned int SOURCE_OFFSETS_OFFSET_POS = 48;
+
+// Three dye-tracks of two timesteps and two channels. Dye-track i has counts
+// of i + j for j from 0 to 3, and i + 1 sources, where source j has a source
+// of 10 * i + j, a count of j + 1, and j + 2 hits.
+void make_dye_tracks(
+        vector<SourcedData<DyeTrack, SourceCountHitsList<int>>>* dye_tracks) {
+    for (int i = 0; i < 3; i++) {
+        DyeTrack dye_track(2, 2);
+        for (int j = 0; j < 4; j++) {
+            dye_track.counts[j] = i + j;
+        }
+        SourceCountHits<int>* sources = new SourceCountHits<int>[i + 1];
+        for (int j = 0; j < i + 1; j++) {
+            sources[j] = SourceCountHits<int>(10 * i + j, j + 1, j + 2);
+        }
+        dye_tracks->push_back(SourcedData<DyeTrack, SourceCountHitsList<int>>(
+                dye_track, SourceCountHitsList<int>(i + 1, sources)));
+    }
+}
+
+string read_file(const string& filename) {
+    ifstream f(filename, ifstream::binary);
+    return string(istreambuf_iterator<char>(f), istreambuf_iterator<char>());
+}
+
+void write_file(const string& filename, const string& contents) {
+    ofstream f(filename, ofstream::binary);
+    f.write(contents.data(), contents.size());
+}
+
+// Writes a valid binary file of the dye-tracks from make_dye_tracks(), and
+// returns its contents.
+string valid_binary_contents(const string& filename) {
+    vector<SourcedData<DyeTrack, SourceCountHitsList<int>>> dye_tracks;
+    make_dye_tracks(&dye_tracks);
+    write_dye_tracks_binary(filename, 2, 2, dye_tracks);
+    return read_file(filename);
+}
+
+bool reader_accepts(const string& filename, const string& contents) {
+    write_file(filename, contents);
+    unsigned int num_timesteps;
+    unsigned int num_channels;
+    MappedFile* mapped_file;
+    vector<SourcedData<DyeTrack, SourceCountHitsList<int>>> dye_tracks;
+    read_dye_tracks(
+            filename, &num_timesteps, &num_channels, &mapped_file, &dye_tracks);
+    bool accepted = num_timesteps != 0;
+    if (!accepted) {
+        BOOST_TEST(mapped_file == (MappedFile*)NULL);
+        BOOST_TEST(dye_tracks.empty());
+    }
+    // The sources are views into the mapping, so they must go first.
+    dye_tracks.clear();
+    delete mapped_file;
+    return accepted;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(io_suite)
+BOOST_AUTO_TEST_SUITE(dye_tracks_io_suite)
+
+BOOST_AUTO_TEST_CASE(binary_round_trip_test) {
+    string filename = "dye-tracks-io-test.tmp";
+    vector<SourcedData<DyeTrack, SourceCountHitsList<int>>> written;
+    make_dye_tracks(&written);
+    write_dye_tracks_binary(filename, 2, 2, written);
+    unsigned int num_timesteps;
+    unsigned int num_channels;
+    MappedFile* mapped_file;
+    vector<SourcedData<DyeTrack, SourceCountHitsList<int>>> read;
+    read_dye_tracks(
+            filename, &num_timesteps, &num_channels, &mapped_file, &read);
+    BOOST_REQUIRE(mapped_file != (MappedFile*)NULL);
+    BOOST_TEST(num_timesteps == 2u);
+    BOOST_TEST(num_channels == 2u);
+    BOOST_REQUIRE(read.size() == 3u);
+    for (int i = 0; i < 3; i++) {
+        BOOST_TEST(read[i].value.num_timesteps == 2u);
+        BOOST_TEST(read[i].value.num_channels == 2u);
+        BOOST_TEST((read[i].value == written[i].value));
+        BOOST_TEST(read[i].source.owns_sources == false);
+        BOOST_REQUIRE(read[i].source.num_sources == i + 1);
+        for (int j = 0; j < i + 1; j++) {
+            BOOST_TEST(read[i].source.sources[j].source == 10 * i + j);
+            BOOST_TEST(read[i].source.sources[j].count == j + 1);
+            BOOST_TEST(read[i].source.sources[j].hits == j + 2);
+        }
+        // The sources are views into the mapping, not copies.
+        const char* sources = (const char*)read[i].source.sources;
+        BOOST_TEST((sources >= mapped_file->data));
+        BOOST_TEST((sources < mapped_file->data + mapped_file->size));
+    }
+    read.clear();
+    delete mapped_file;
+    remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(text_round_trip_test) {
+    string filename = "dye-tracks-io-test.tmp";
+    vector<SourcedData<DyeTrack, SourceCountHitsList<int>>> written;
+    make_dye_tracks(&written);
+    write_dye_tracks(filename, 2, 2, written);
+    unsigned int num_timesteps;
+    unsigned int num_channels;
+    MappedFile* mapped_file;
+    vector<SourcedData<DyeTrack, SourceCountHitsList<int>>> read;
+    read_dye_tracks(
+            filename, &num_timesteps, &num_channels, &mapped_file, &read);
+    BOOST_TEST(mapped_file == (MappedFile*)NULL);
+    BOOST_TEST(num_timesteps == 2u);
+    BOOST_REQUIRE(read.size() == 3u);
+    for (int i = 0; i < 3; i++) {
+        BOOST_TEST((read[i].value == written[i].value));
+        BOOST_TEST(read[i].source.owns_sources == true);
+        BOOST_REQUIRE(read[i].source.num_sources == i + 1);
+        BOOST_TEST(read[i].source.sources[i].source == 10 * i + i);
+    }
+    remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(binary_valid_test) {
+    string filename = "dye-tracks-io-test.tmp";
+    string contents = valid_binary_contents(filename);
+    BOOST_TEST(reader_accepts(filename, contents));
+    remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(binary_truncated_test) {
+    string filename = "dye-tracks-io-test.tmp";
+    string contents = valid_binary_contents(filename);
+    // Cut into the sources, the source offsets, and the counts.
+    string cut = contents.substr(0, contents.size() - 1);
+    BOOST_TEST(!reader_accepts(filename, cut));
+    cut = contents.substr(0, contents.size() - 6 * 12 - 8);
+    BOOST_TEST(!reader_accepts(filename, cut));
+    cut = contents.substr(0, 64 + 2);
+    BOOST_TEST(!reader_accepts(filename, cut));
+    remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(binary_bad_version_test) {
+    string filename = "dye-tracks-io-test.tmp";
+    string contents = valid_binary_contents(filename);
+    uint32_t version = DYE_TRACKS_BINARY_VERSION + 1;
+    contents.replace(VERSION_POS,
+                     sizeof(version),
+                     (const char*)&version,
+                     sizeof(version));
+    BOOST_TEST(!reader_accepts(filename, contents));
+    remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(binary_bad_offset_test) {
+    string filename = "dye-tracks-io-test.tmp";
+    string contents = valid_binary_contents(filename);
+    uint64_t offset = contents.size();
+    contents.replace(SOURCE_OFFSETS_OFFSET_POS,
+                     sizeof(offset),
+                     (const char*)&offset,
+                     sizeof(offset));
+    BOOST_TEST(!reader_accepts(filename, contents));
+    remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(binary_decreasing_source_offsets_test) {
+    string filename = "dye-tracks-io-test.tmp";
+    string contents = valid_binary_contents(filename);
+    uint64_t source_offsets_offset;
+    contents.copy((char*)&source_offsets_offset,
+                  sizeof(source_offsets_offset),
+                  SOURCE_OFFSETS_OFFSET_POS);
+    // The offsets are 0, 1, 3, 6. Making the second one 4 keeps every offset
+    // in range, but gives the second dye-track a negative number of sources.
+    uint64_t offset = 4;
+    contents.replace(source_offsets_offset + sizeof(uint64_t),
+                     sizeof(offset),
+                     (const char*)&offset,
+                     sizeof(offset));
+    BOOST_TEST(!reader_accepts(filename, contents));
+    remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // dye_tracks_io_suite
+BOOST_AUTO_TEST_SUITE_END()  // io_suite
+
+}  // namespace whatprot
@@ -0,0 +1,301 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+
+// Defining symbols from header:
+#include "kd-tree-index-io.h"
+
+// Standard C++ library headers:
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+
+// Local project headers:
+#include "common/sourced-data.h"
+#include "kd-tree/flat-kd-tree.h"
+#include "parameterization/model/channel-model.h"
+#include "parameterization/model/sequencing-model.h"
+#include "util/mapped-file.h"
+
+namespace whatprot {
+
+namespace {
+using std::int32_t;
+using std::memcmp;
+using std::memcpy;
+using std::memset;
+using std::numeric_limits;
+using std::ofstream;
+using std::size_t;
+using std::string;
+using std::uint32_t;
+using std::uint64_t;
+using std::vector;
+
+// Header of the index, exactly as it is laid out in the file.
+class IndexHeader {
+public:
+    char magic[8];
+    uint32_t version;
+    uint32_t num_timesteps;
+    uint32_t num_channels;
+    uint32_t d;
+    uint32_t k;
+    uint32_t reserved;
+    uint64_t num_nodes;
+    uint64_t num_entries;
+    uint64_t num_sources;
+    uint64_t nodes_offset;
+    uint64_t coordinates_offset;
+    uint64_t entries_offset;
+    uint64_t source_offsets_offset;
+    uint64_t sources_offset;
+    uint64_t seq_model_fingerprint;
+    char padding[KD_TREE_INDEX_HEADER_SIZE - 104];
+};
+static_assert(sizeof(IndexHeader) == KD_TREE_INDEX_HEADER_SIZE,
+              "IndexHeader must match the layout of the file.");
+static_assert(sizeof(kd_tree::FlatNode) == 40
+                      && sizeof(kd_tree::FlatEntry) == sizeof(int32_t)
+                      && sizeof(SourceCountHits<int>) == 3 * sizeof(int32_t),
+              "KD-tree index layout does not match the in-memory one.");
+
+// Rounds offset up to a multiple of eight bytes, so that whatever follows it
+// is aligned.
+uint64_t align_offset(uint64_t offset) {
+    return (offset + 7) / 8 * 8;
+}
+
+void write_padding(ofstream* f, uint64_t size) {
+    uint64_t zero = 0;
+    f->write((const char*)&zero, size);
+}
+
+// Folds the bytes of value into hash, as in 64 bit FNV-1a.
+template <typename T>
+void fingerprint_add(const T& value, uint64_t* hash) {
+    const unsigned char* bytes = (const unsigned char*)&value;
+    for (size_t i = 0; i < sizeof(T); i++) {
+        *hash ^= bytes[i];
+        *hash *= 0x100000001b3ull;
+    }
+}
+
+// A fingerprint of everything in seq_model that the coordinates of the entries
+// depend on (see KDTEntry and ChannelModel::adjusted_mu()).
+uint64_t seq_model_fingerprint(const SequencingModel& seq_model) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    fingerprint_add((uint64_t)seq_model.channel_models.size(), &hash);
+    for (const ChannelModel* channel_model : seq_model.channel_models) {
+        fingerprint_add(channel_model->mu, &hash);
+        fingerprint_add((uint64_t)channel_model->interactions.size(), &hash);
+        for (double interaction : channel_model->interactions) {
+            fingerprint_add(interaction, &hash);
+        }
+        fingerprint_add((uint64_t)channel_model->flat_interactions.size(),
+                        &hash);
+        for (double interaction : channel_model->flat_interactions) {
+            fingerprint_add(interaction, &hash);
+        }
+    }
+    return hash;
+}
+
+// Whether the header describes an index of this version, which fits in the
+// mapping, with every block aligned for what it holds.
+bool is_valid_header(const IndexHeader& header,
+                     const MappedFile& mapped_file) {
+    if (header.version != KD_TREE_INDEX_VERSION
+        || header.num_timesteps == 0 || header.num_channels == 0
+        || (uint64_t)header.d
+                   != (uint64_t)header.num_timesteps * header.num_channels
+        || header.d > (uint32_t)numeric_limits<int>::max()
+        || header.num_nodes == 0
+        || header.num_nodes > numeric_limits<unsigned int>::max()
+        || header.num_entries > numeric_limits<unsigned int>::max()
+        || header.nodes_offset < sizeof(header)
+        || header.nodes_offset % sizeof(double) != 0
+        || header.coordinates_offset % sizeof(double) != 0
+        || header.entries_offset % sizeof(int32_t) != 0
+        || header.source_offsets_offset % sizeof(uint64_t) != 0
+        || header.sources_offset % sizeof(int32_t) != 0) {
+        return false;
+    }
+    // The size of the coordinates of one entry is checked against the file
+    // before it is used in the other checks, so that computing it can't
+    // overflow.
+    return mapped_file.has_room(
+                   header.nodes_offset,
+                   header.num_nodes,
+                   sizeof(kd_tree::FlatNode))
+           && mapped_file.has_room(0, header.d, sizeof(double))
+           && mapped_file.has_room(header.coordinates_offset,
+                                   header.num_entries,
+                                   header.d * sizeof(double))
+           && mapped_file.has_room(header.entries_offset,
+                                   header.num_entries,
+                                   sizeof(kd_tree::FlatEntry))
+           && mapped_file.has_room(header.source_offsets_offset,
+                                   header.num_entries + 1,
+                                   sizeof(uint64_t))
+           && mapped_file.has_room(header.sources_offset,
+                                   header.num_sources,
+                                   sizeof(SourceCountHits<int>));
+}
+
+// Whether every node is consistent with the rest of the tree. Each internal
+// node must have its children after it, as in breadth-first order, so a search
+// can't loop, and each leaf must have its entries within the entries.
+bool are_valid_nodes(const IndexHeader& header,
+                     const kd_tree::FlatNode* nodes) {
+    for (uint64_t i = 0; i < header.num_nodes; i++) {
+        const kd_tree::FlatNode& node = nodes[i];
+        if (node.begin > node.end || node.end > header.num_entries) {
+            return false;
+        }
+        if (node.s == -1) {
+            continue;
+        }
+        if (node.s < 0 || (uint32_t)node.s >= header.d
+            || node.left_child <= i
+            || (uint64_t)node.left_child + 1 >= header.num_nodes) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Whether the sources of each entry are a run of the sources, in order.
+bool are_valid_source_offsets(const IndexHeader& header,
+                              const uint64_t* source_offsets) {
+    if (source_offsets[0] != 0
+        || source_offsets[header.num_entries] != header.num_sources) {
+        return false;
+    }
+    for (uint64_t i = 0; i < header.num_entries; i++) {
+        if (source_offsets[i + 1] < source_offsets[i]
+            || source_offsets[i + 1] - source_offsets[i]
+                       > (uint64_t)numeric_limits<int>::max()) {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace
+
+void read_kd_tree_index(const string& filename,
+                        const SequencingModel& seq_model,
+                        unsigned int* num_timesteps,
+                        unsigned int* num_channels,
+                        MappedFile** mapped_file,
+                        FlatKDTree** kd_tree,
+                        vector<SourceCountHitsList<int>>* entry_sources) {
+    *mapped_file = new MappedFile(filename);
+    IndexHeader header;
+    if ((*mapped_file)->size < sizeof(header)
+        || 0 != memcmp((*mapped_file)->data, KD_TREE_INDEX_MAGIC, 8)) {
+        *kd_tree = NULL;
+        return;
+    }
+    const char* data = (*mapped_file)->data;
+    memcpy(&header, data, sizeof(header));
+    if (!is_valid_header(header, **mapped_file)
+        || header.seq_model_fingerprint != seq_model_fingerprint(seq_model)) {
+        *kd_tree = NULL;
+        return;
+    }
+    // The mapping is page aligned and every block starts at an offset which is
+    // a multiple of its alignment, so these casts are to properly aligned
+    // memory. The mapping is read-only, so nothing may write through them.
+    const kd_tree::FlatNode* nodes =
+            (const kd_tree::FlatNode*)(data + header.nodes_offset);
+    const uint64_t* source_offsets =
+            (const uint64_t*)(data + header.source_offsets_offset);
+    if (!are_valid_nodes(header, nodes)
+        || !are_valid_source_offsets(header, source_offsets)) {
+        *kd_tree = NULL;
+        return;
+    }
+    *num_timesteps = header.num_timesteps;
+    *num_channels = header.num_channels;
+    *kd_tree = new FlatKDTree(
+            header.d,
+            header.num_nodes,
+            header.num_entries,
+            nodes,
+            (const double*)(data + header.coordinates_offset),
+            (const kd_tree::FlatEntry*)(data + header.entries_offset));
+    SourceCountHits<int>* sources =
+            (SourceCountHits<int>*)(data + header.sources_offset);
+    entry_sources->clear();
+    entry_sources->reserve(header.num_entries);
+    for (size_t i = 0; i < header.num_entries; i++) {
+        entry_sources->push_back(SourceCountHitsList<int>(
+                source_offsets[i + 1] - source_offsets[i],
+                &sources[source_offsets[i]],
+                false));  // owns_sources
+    }
+}
+
+void write_kd_tree_index(
+        const string& filename,
+        const SequencingModel& seq_model,
+        unsigned int num_timesteps,
+        unsigned int num_channels,
+        int k,
+        const FlatKDTree& kd_tree,
+        const vector<SourceCountHitsList<int>>& entry_sources) {
+    vector<uint64_t> source_offsets(entry_sources.size() + 1);
+    source_offsets[0] = 0;
+    for (size_t i = 0; i < entry_sources.size(); i++) {
+        source_offsets[i + 1] =
+                source_offsets[i] + entry_sources[i].num_sources;
+    }
+    IndexHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, KD_TREE_INDEX_MAGIC, 8);
+    header.version = KD_TREE_INDEX_VERSION;
+    header.num_timesteps = num_timesteps;
+    header.num_channels = num_channels;
+    header.d = kd_tree.d;
+    header.k = k;
+    header.num_nodes = kd_tree.num_nodes;
+    header.num_entries = kd_tree.num_entries;
+    header.num_sources = source_offsets.back();
+    header.seq_model_fingerprint = seq_model_fingerprint(seq_model);
+    uint64_t nodes_size = header.num_nodes * sizeof(kd_tree::FlatNode);
+    uint64_t coordinates_size = header.num_entries * header.d * sizeof(double);
+    uint64_t entries_size = header.num_entries * sizeof(kd_tree::FlatEntry);
+    header.nodes_offset = sizeof(header);
+    header.coordinates_offset = header.nodes_offset + nodes_size;
+    header.entries_offset = header.coordinates_offset + coordinates_size;
+    header.source_offsets_offset =
+            align_offset(header.entries_offset + entries_size);
+    header.sources_offset = header.source_offsets_offset
+                            + source_offsets.size() * sizeof(uint64_t);
+    ofstream f(filename, ofstream::binary);
+    f.write((const char*)&header, sizeof(header));
+    f.write((const char*)kd_tree.nodes, nodes_size);
+    f.write((const char*)kd_tree.coordinates, coordinates_size);
+    f.write((const char*)kd_tree.entries, entries_size);
+    write_padding(&f,
+                  header.source_offsets_offset - header.entries_offset
+                          - entries_size);
+    f.write((const char*)&source_offsets[0],
+            source_offsets.size() * sizeof(uint64_t));
+    for (const auto& sources : entry_sources) {
+        f.write((const char*)sources.sources,
+                sources.num_sources * sizeof(SourceCountHits<int>));
+    }
+    f.close();
+}
+
+}  // namespace whatprot
@@ -0,0 +1,78 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+
+#ifndef WHATPROT_IO_KD_TREE_INDEX_IO_H
+#define WHATPROT_IO_KD_TREE_INDEX_IO_H
+
+// Standard C++ library headers:
+#include <string>
+#include <vector>
+
+// Local project headers:
+#include "common/sourced-data.h"
+#include "kd-tree/flat-kd-tree.h"
+#include "parameterization/model/sequencing-model.h"
+#include "util/mapped-file.h"
+
+namespace whatprot {
+
+// A KD-tree index holds everything NNClassifier needs to classify against a
+// set of dye-tracks: the FlatKDTree built from them, and the sources of the
+// dye-track behind each entry of that tree. Building the tree needs the
+// sequencing parameters, so an index must only be used with the same
+// parameters it was built with. To check this, the header holds a fingerprint
+// of the parameters which the coordinates depend on: the mu and the
+// interactions of each channel. It is laid out as follows, in native byte
+// order:
+//   - A header of KD_TREE_INDEX_HEADER_SIZE bytes: the eight characters of
+//     KD_TREE_INDEX_MAGIC, then as uint32s the version, num_timesteps,
+//     num_channels, d, the k the tree was built with, and a zero, then as
+//     uint64s the number of nodes, the number of entries, the total number of
+//     sources, the byte offsets of the nodes, the coordinates, the entries,
+//     the source offsets, and the sources, and the fingerprint of the
+//     sequencing parameters. The remainder is zero padding.
+//   - The nodes, each a kd_tree::FlatNode, in breadth-first order.
+//   - The coordinates, as doubles, laid out as in FlatKDTree::coordinates.
+//   - The entries, each a kd_tree::FlatEntry.
+//   - The source offsets, as (number of entries + 1) uint64s. The sources of
+//     entry i are sources offsets[i] up to offsets[i + 1].
+//   - The sources, each a SourceCountHits<int>.
+const char KD_TREE_INDEX_MAGIC[] = "WPKDTIDX";
+const unsigned int KD_TREE_INDEX_HEADER_SIZE = 128;
+const unsigned int KD_TREE_INDEX_VERSION = 2;
+
+// Maps the index into memory, and leaves it mapped in *mapped_file, which must
+// not be deleted while *kd_tree or the entry_sources are still in use. Neither
+// is copied out of the mapping. The layout of the index is checked against the
+// size of the file, and every node against the rest of the tree, so that a
+// damaged index can't send a search outside of the mapping. If the file is
+// not an index, is an index of another version, is damaged or cut short, or
+// was built with other sequencing parameters than seq_model, *kd_tree is set
+// to NULL.
+void read_kd_tree_index(const std::string& filename,
+                        const SequencingModel& seq_model,
+                        unsigned int* num_timesteps,
+                        unsigned int* num_channels,
+                        MappedFile** mapped_file,
+                        FlatKDTree** kd_tree,
+                        std::vector<SourceCountHitsList<int>>* entry_sources);
+
+// The seq_model must be the one kd_tree was built with.
+void write_kd_tree_index(
+        const std::string& filename,
+        const SequencingModel& seq_model,
+        unsigned int num_timesteps,
+        unsigned int num_channels,
+        int k,
+        const FlatKDTree& kd_tree,
+        const std::vector<SourceCountHitsList<int>>& entry_sources);
+
+}  // namespace whatprot
+
+#endif  // WHATPROT_IO_KD_TREE_INDEX_IO_H
@@ -0,0 +1,260 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+// Boost unit test framework (recommended to be the first include):
+#include <boost/test/unit_test.hpp>
+
+// File under test:
+#include "kd-tree-index-io.h"
+
+// Standard C++ library headers:
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Local project headers:
+#include "classifiers/nn-classifier.h"
+#include "common/dye-track.h"
+#include "common/sourced-data.h"
+#include "kd-tree/flat-kd-tree.h"
+#include "parameterization/model/sequencing-model.h"
+#include "util/mapped-file.h"
+
+namespace whatprot {
+
+namespace {
+using std::ifstream;
+using std::istreambuf_iterator;
+using std::ofstream;
+using std::remove;
+using std::string;
+using std::uint32_t;
+using std::vector;
+
+// Offset of the version in the header, as documented in the header.
+const unsigned int VERSION_POS = 8;
+
+// Two channels, with mu as one, as when building an index.
+SequencingModel test_seq_model() {
+    SequencingModel seq_model(2);
+    for (unsigned int c = 0; c < 2; c++) {
+        seq_model.channel_models[c]->mu = 1.0;
+        seq_model.channel_models[c]->flat_interactions.resize(2, 1.0);
+    }
+    return seq_model;
+}
+
+// Forty distinct dye-tracks of three timesteps and two channels. The counts of
+// dye-track i are the base 3 digits of i, and it has one source, of i, with i
+// hits.
+void make_dye_tracks(
+        vector<SourcedData<DyeTrack, SourceCountHitsList<int>>>* dye_tracks) {
+    for (int i = 0; i < 40; i++) {
+        DyeTrack dye_track(3, 2);
+        int digits = i;
+        for (int j = 0; j < 6; j++) {
+            dye_track.counts[j] = digits % 3;
+            digits /= 3;
+        }
+        SourceCountHits<int>* sources = new SourceCountHits<int>[1];
+        sources[0] = SourceCountHits<int>(i, 1, i + 1);
+        dye_tracks->push_back(SourcedData<DyeTrack, SourceCountHitsList<int>>(
+                dye_track, SourceCountHitsList<int>(1, sources)));
+    }
+}
+
+// Builds a tree from the dye-tracks of make_dye_tracks(), with small leaves so
+// that it has several levels.
+FlatKDTree* build_test_tree(const SequencingModel& seq_model,
+                            vector<SourceCountHitsList<int>>* entry_sources) {
+    vector<SourcedData<DyeTrack, SourceCountHitsList<int>>> dye_tracks;
+    make_dye_tracks(&dye_tracks);
+    return build_kd_tree(3,  // num_timesteps
+                         2,  // num_channels
+                         seq_model,
+                         5,  // k
+                         2,  // leaf_size
+                         &dye_tracks,
+                         entry_sources);
+}
+
+string read_file(const string& filename) {
+    ifstream f(filename, ifstream::binary);
+    return string(istreambuf_iterator<char>(f), istreambuf_iterator<char>());
+}
+
+void write_file(const string& filename, const string& contents) {
+    ofstream f(filename, ofstream::binary);
+    f.write(contents.data(), contents.size());
+}
+
+// Writes a valid index of the tree from build_test_tree(), and returns its
+// contents.
+string valid_index_contents(const string& filename) {
+    SequencingModel seq_model = test_seq_model();
+    vector<SourceCountHitsList<int>> entry_sources;
+    FlatKDTree* kd_tree = build_test_tree(seq_model, &entry_sources);
+    write_kd_tree_index(filename, seq_model, 3, 2, 5, *kd_tree, entry_sources);
+    delete kd_tree;
+    return read_file(filename);
+}
+
+bool reader_accepts(const string& filename,
+                    const SequencingModel& seq_model,
+                    const string& contents) {
+    write_file(filename, contents);
+    unsigned int num_timesteps;
+    unsigned int num_channels;
+    MappedFile* mapped_file;
+    FlatKDTree* kd_tree;
+    vector<SourceCountHitsList<int>> entry_sources;
+    read_kd_tree_index(filename,
+                       seq_model,
+                       &num_timesteps,
+                       &num_channels,
+                       &mapped_file,
+                       &kd_tree,
+                       &entry_sources);
+    bool accepted = kd_tree != NULL;
+    // The tree and the sources are views into the mapping, so they must go
+    // first.
+    delete kd_tree;
+    entry_sources.clear();
+    delete mapped_file;
+    return accepted;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(io_suite)
+BOOST_AUTO_TEST_SUITE(kd_tree_index_io_suite)
+
+BOOST_AUTO_TEST_CASE(round_trip_test) {
+    string filename = "kd-tree-index-io-test.tmp";
+    SequencingModel seq_model = test_seq_model();
+    vector<SourceCountHitsList<int>> built_sources;
+    FlatKDTree* built = build_test_tree(seq_model, &built_sources);
+    write_kd_tree_index(filename, seq_model, 3, 2, 5, *built, built_sources);
+    unsigned int num_timesteps;
+    unsigned int num_channels;
+    MappedFile* mapped_file;
+    FlatKDTree* read;
+    vector<SourceCountHitsList<int>> read_sources;
+    read_kd_tree_index(filename,
+                       seq_model,
+                       &num_timesteps,
+                       &num_channels,
+                       &mapped_file,
+                       &read,
+                       &read_sources);
+    BOOST_REQUIRE(read != (FlatKDTree*)NULL);
+    BOOST_TEST(num_timesteps == 3u);
+    BOOST_TEST(num_channels == 2u);
+    BOOST_TEST(read->num_nodes == built->num_nodes);
+    BOOST_REQUIRE(read->num_entries == built->num_entries);
+    BOOST_REQUIRE(read_sources.size() == built_sources.size());
+    for (unsigned int i = 0; i < read_sources.size(); i++) {
+        BOOST_TEST(read_sources[i].owns_sources == false);
+        BOOST_REQUIRE(read_sources[i].num_sources == 1);
+        BOOST_TEST(read_sources[i].sources[0].source
+                   == built_sources[i].sources[0].source);
+        BOOST_TEST(read_sources[i].sources[0].hits
+                   == built_sources[i].sources[0].hits);
+    }
+    // Queries between and beyond the dye-tracks, including some ties.
+    for (int q = 0; q < 30; q++) {
+        vector<double> query(6);
+        for (int j = 0; j < 6; j++) {
+            query[j] = 0.37 * ((q * (j + 3)) % 11) - 0.5;
+        }
+        vector<const kd_tree::FlatEntry*> built_nearest;
+        vector<double> built_dists_sq;
+        built->search(query, 5, 0.0, &built_nearest, &built_dists_sq);
+        vector<const kd_tree::FlatEntry*> read_nearest;
+        vector<double> read_dists_sq;
+        read->search(query, 5, 0.0, &read_nearest, &read_dists_sq);
+        BOOST_REQUIRE(read_nearest.size() == built_nearest.size());
+        for (unsigned int i = 0; i < read_nearest.size(); i++) {
+            BOOST_TEST(read->index(read_nearest[i])
+                       == built->index(built_nearest[i]));
+            BOOST_TEST(read_nearest[i]->hits == built_nearest[i]->hits);
+            BOOST_TEST(read_dists_sq[i] == built_dists_sq[i]);
+        }
+    }
+    delete read;
+    read_sources.clear();
+    delete mapped_file;
+    delete built;
+    remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(valid_test) {
+    string filename = "kd-tree-index-io-test.tmp";
+    string contents = valid_index_contents(filename);
+    BOOST_TEST(reader_accepts(filename, test_seq_model(), contents));
+    remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(seq_model_mismatch_test) {
+    string filename = "kd-tree-index-io-test.tmp";
+    string contents = valid_index_contents(filename);
+    SequencingModel seq_model = test_seq_model();
+    seq_model.channel_models[1]->interactions[0] = 0.9;
+    BOOST_TEST(!reader_accepts(filename, seq_model, contents));
+    seq_model = test_seq_model();
+    seq_model.channel_models[0]->flat_interactions[1] = 0.9;
+    BOOST_TEST(!reader_accepts(filename, seq_model, contents));
+    BOOST_TEST(!reader_accepts(filename, SequencingModel(3), contents));
+    remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(truncated_test) {
+    string filename = "kd-tree-index-io-test.tmp";
+    string contents = valid_index_contents(filename);
+    // Cut into the sources, somewhere in the middle, and into the nodes.
+    SequencingModel seq_model = test_seq_model();
+    string cut = contents.substr(0, contents.size() - 1);
+    BOOST_TEST(!reader_accepts(filename, seq_model, cut));
+    cut = contents.substr(0, contents.size() / 2);
+    BOOST_TEST(!reader_accepts(filename, seq_model, cut));
+    cut = contents.substr(0, KD_TREE_INDEX_HEADER_SIZE + 8);
+    BOOST_TEST(!reader_accepts(filename, seq_model, cut));
+    remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(bad_version_test) {
+    string filename = "kd-tree-index-io-test.tmp";
+    string contents = valid_index_contents(filename);
+    uint32_t version = KD_TREE_INDEX_VERSION - 1;
+    contents.replace(VERSION_POS,
+                     sizeof(version),
+                     (const char*)&version,
+                     sizeof(version));
+    BOOST_TEST(!reader_accepts(filename, test_seq_model(), contents));
+    remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(bad_node_test) {
+    string filename = "kd-tree-index-io-test.tmp";
+    string contents = valid_index_contents(filename);
+    // The root is the first node. Pointing it back at itself would make a
+    // search loop forever.
+    unsigned int left_child = 0;
+    contents.replace(KD_TREE_INDEX_HEADER_SIZE + sizeof(int),
+                     sizeof(left_child),
+                     (const char*)&left_child,
+                     sizeof(left_child));
+    BOOST_TEST(!reader_accepts(filename, test_seq_model(), contents));
+    remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // kd_tree_index_io_suite
+BOOST_AUTO_TEST_SUITE_END()  // io_suite
+
+}  // namespace whatprot
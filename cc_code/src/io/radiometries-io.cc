@@ -10,8 +10,12 @@
 #include "radiometries-io.h"
 
 // Standard C++ library headers:
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
-#include <iomanip>  // for std::setprecision
+#include <iomanip>  // for std::setprecision and std::setw
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -19,32 +23,196 @@
 #include "common/radiometry.h"
 #include "parameterization/model/channel-model.h"
 #include "parameterization/model/sequencing-model.h"
+#include "util/mapped-file.h"
 
 namespace whatprot {
 
 namespace {
 using std::ifstream;
+using std::int32_t;
+using std::memcmp;
+using std::memcpy;
+using std::memset;
+using std::numeric_limits;
 using std::ofstream;
+using std::remove;
 using std::setprecision;
+using std::setw;
+using std::size_t;
+using std::snprintf;
+using std::streampos;
 using std::string;
+using std::uint32_t;
+using std::uint64_t;
 using std::vector;
+
+// Enough characters for any unsigned int, for the number of radiometries
+// written by a RadiometriesWriter.
+const int NUM_RADIOMETRIES_WIDTH = 10;
+
+// Radiometries are formatted by a RadiometriesWriter in pieces of this many,
+// one piece to a thread at a time.
+const unsigned int FORMAT_PIECE_SIZE = 1024;
+
+// Header of the binary format, exactly as it is laid out in the file.
+class BinaryHeader {
+public:
+    char magic[8];
+    uint32_t version;
+    uint32_t num_timesteps;
+    uint32_t num_channels;
+    uint32_t bytes_per_intensity;
+    uint64_t num_radiometries;
+    uint64_t intensities_offset;
+    uint64_t sources_offset;
+    char padding[RADIOMETRIES_BINARY_HEADER_SIZE - 48];
+};
+static_assert(sizeof(BinaryHeader) == RADIOMETRIES_BINARY_HEADER_SIZE,
+              "BinaryHeader must match the layout of the file.");
+
+// Header of a binary file with sources, which follow the intensities.
+BinaryHeader binary_header(unsigned int num_timesteps,
+                           unsigned int num_channels,
+                           unsigned int bytes_per_intensity,
+                           uint64_t num_radiometries) {
+    BinaryHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, RADIOMETRIES_BINARY_MAGIC, 8);
+    header.version = RADIOMETRIES_BINARY_VERSION;
+    header.num_timesteps = num_timesteps;
+    header.num_channels = num_channels;
+    header.bytes_per_intensity = bytes_per_intensity;
+    header.num_radiometries = num_radiometries;
+    header.intensities_offset = sizeof(header);
+    header.sources_offset = header.intensities_offset
+                            + num_radiometries * num_timesteps * num_channels
+                                      * bytes_per_intensity;
+    return header;
+}
+
+// T is the type the intensities are stored as in the file.
+template <typename T>
+void normalize_intensities(const T* raw,
+                           const SequencingModel& seq_model,
+                           Radiometry* radiometry) {
+    unsigned int num_channels = radiometry->num_channels;
+    for (unsigned int t = 0; t < radiometry->num_timesteps; t++) {
+        for (unsigned int c = 0; c < num_channels; c++) {
+            (*radiometry)(t, c) = (double)raw[t * num_channels + c]
+                                  / seq_model.channel_models[c]->mu;
+        }
+    }
+}
+
+template <typename T>
+void write_intensities(
+        ofstream* f,
+        const SequencingModel& seq_model,
+        unsigned int num_timesteps,
+        unsigned int num_channels,
+        const vector<SourcedData<Radiometry, SourceCount<int>>>& radiometries) {
+    vector<T> buffer(num_timesteps * num_channels);
+    for (unsigned int i = 0; i < radiometries.size(); i++) {
+        for (unsigned int t = 0; t < num_timesteps; t++) {
+            for (unsigned int c = 0; c < num_channels; c++) {
+                buffer[t * num_channels + c] =
+                        (T)(seq_model.channel_models[c]->mu
+                            * radiometries[i].value(t, c));
+            }
+        }
+        f->write((const char*)&buffer[0], buffer.size() * sizeof(T));
+    }
+}
 }  // namespace
 
-void read_radiometries(const string& filename,
-                       const SequencingModel& seq_model,
-                       unsigned int* num_timesteps,
-                       unsigned int* num_channels,
-                       unsigned int* num_radiometries,
-                       vector<Radiometry>* radiometries) {
-    ifstream f(filename);
-    f >> *num_timesteps;
-    f >> *num_channels;
-    f >> *num_radiometries;
-    radiometries->reserve(*num_radiometries);
-    for (unsigned int i = 0; i < (*num_radiometries); i++) {
-        radiometries->push_back(Radiometry(*num_timesteps, *num_channels));
-        for (unsigned int t = 0; t < (*num_timesteps); t++) {
-            for (unsigned int c = 0; c < (*num_channels); c++) {
+RadiometriesReader::RadiometriesReader(const string& filename,
+                                       const SequencingModel& seq_model)
+        : valid(true),
+          mapped_file(NULL),
+          binary_intensities(NULL),
+          bytes_per_intensity(0),
+          seq_model(seq_model),
+          num_read(0) {
+    mapped_file = new MappedFile(filename);
+    BinaryHeader header;
+    if (mapped_file->size < sizeof(header)
+        || 0 != memcmp(mapped_file->data, RADIOMETRIES_BINARY_MAGIC, 8)) {
+        delete mapped_file;
+        mapped_file = NULL;
+        f.open(filename);
+        f >> num_timesteps;
+        f >> num_channels;
+        f >> num_radiometries;
+        return;
+    }
+    memcpy(&header, mapped_file->data, sizeof(header));
+    num_timesteps = header.num_timesteps;
+    num_channels = header.num_channels;
+    num_radiometries = 0;
+    bytes_per_intensity = header.bytes_per_intensity;
+    // The size of one radiometry is checked against the file before it is used
+    // in the other checks, so that computing it can't overflow. The
+    // intensities offset must keep the intensities aligned.
+    valid = header.version == RADIOMETRIES_BINARY_VERSION
+            && (bytes_per_intensity == sizeof(float)
+                || bytes_per_intensity == sizeof(double))
+            && num_timesteps > 0 && num_channels > 0
+            && header.num_radiometries <= numeric_limits<unsigned int>::max()
+            && header.intensities_offset >= sizeof(header)
+            && header.intensities_offset % bytes_per_intensity == 0
+            && mapped_file->has_room(0,
+                                     (uint64_t)num_timesteps * num_channels,
+                                     bytes_per_intensity);
+    if (valid) {
+        uint64_t radiometry_size =
+                (uint64_t)num_timesteps * num_channels * bytes_per_intensity;
+        valid = mapped_file->has_room(header.intensities_offset,
+                                      header.num_radiometries,
+                                      radiometry_size)
+                && (header.sources_offset == 0
+                    || mapped_file->has_room(header.sources_offset,
+                                             header.num_radiometries,
+                                             sizeof(int32_t)));
+    }
+    if (!valid) {
+        return;
+    }
+    num_radiometries = header.num_radiometries;
+    binary_intensities = mapped_file->data + header.intensities_offset;
+}
+
+RadiometriesReader::~RadiometriesReader() {
+    delete mapped_file;
+}
+
+unsigned int RadiometriesReader::read(unsigned int max_num_radiometries,
+                                      vector<Radiometry>* radiometries) {
+    radiometries->clear();
+    unsigned int num_to_read = num_radiometries - num_read;
+    if (num_to_read > max_num_radiometries) {
+        num_to_read = max_num_radiometries;
+    }
+    radiometries->reserve(num_to_read);
+    for (unsigned int i = 0; i < num_to_read; i++) {
+        radiometries->push_back(Radiometry(num_timesteps, num_channels));
+        if (mapped_file != NULL) {
+            // The header and every radiometry are a multiple of the intensity
+            // size, and the mapping is page aligned, so these casts are to
+            // properly aligned memory.
+            const char* raw = binary_intensities
+                              + (size_t)(num_read + i) * num_timesteps
+                                        * num_channels * bytes_per_intensity;
+            if (bytes_per_intensity == sizeof(float)) {
+                normalize_intensities(
+                        (const float*)raw, seq_model, &radiometries->back());
+            } else {
+                normalize_intensities(
+                        (const double*)raw, seq_model, &radiometries->back());
+            }
+            continue;
+        }
+        for (unsigned int t = 0; t < num_timesteps; t++) {
+            for (unsigned int c = 0; c < num_channels; c++) {
                 double intensity;
                 f >> intensity;
                 radiometries->back()(t, c) =
@@ -52,7 +220,164 @@ void read_radiometries(const string& filename,
             }
         }
     }
+    num_read += num_to_read;
+    return num_to_read;
+}
+
+RadiometriesWriter::RadiometriesWriter(const string& radiometries_filename,
+                                       const string& ys_filename,
+                                       const SequencingModel& seq_model,
+                                       unsigned int num_timesteps,
+                                       unsigned int num_channels,
+                                       const string& format)
+        : ys_f(ys_filename),
+          seq_model(seq_model),
+          num_timesteps(num_timesteps),
+          num_channels(num_channels),
+          bytes_per_intensity(0),
+          num_written(0) {
+    if (0 == format.compare("bin64")) {
+        bytes_per_intensity = sizeof(double);
+    } else if (0 == format.compare("bin32")) {
+        bytes_per_intensity = sizeof(float);
+    }
+    if (bytes_per_intensity == 0) {
+        f.open(radiometries_filename);
+        f << num_timesteps << "\n";
+        f << num_channels << "\n";
+        num_radiometries_pos = f.tellp();
+        f << string(NUM_RADIOMETRIES_WIDTH, ' ') << "\n";
+    } else {
+        f.open(radiometries_filename, ofstream::binary);
+        BinaryHeader header = binary_header(
+                num_timesteps, num_channels, bytes_per_intensity, 0);
+        f.write((const char*)&header, sizeof(header));
+        sources_filename = radiometries_filename + ".sources";
+        sources_f.open(sources_filename, ofstream::binary);
+    }
+    ys_f << string(NUM_RADIOMETRIES_WIDTH, ' ') << "\n";
+}
+
+void RadiometriesWriter::format(
+        const vector<SourcedData<Radiometry, SourceCount<int>>>& radiometries,
+        FormattedRadiometries* formatted) const {
+    int num_pieces =
+            (radiometries.size() + FORMAT_PIECE_SIZE - 1) / FORMAT_PIECE_SIZE;
+    vector<FormattedRadiometries> pieces(num_pieces);
+#pragma omp parallel for schedule(dynamic)
+    for (int p = 0; p < num_pieces; p++) {
+        unsigned int begin = p * FORMAT_PIECE_SIZE;
+        unsigned int end = begin + FORMAT_PIECE_SIZE;
+        if (end > radiometries.size()) {
+            end = radiometries.size();
+        }
+        format_range(radiometries, begin, end, &pieces[p]);
+    }
+    formatted->intensities.clear();
+    formatted->ys.clear();
+    formatted->sources.clear();
+    formatted->num_radiometries = 0;
+    for (int p = 0; p < num_pieces; p++) {
+        formatted->intensities += pieces[p].intensities;
+        formatted->ys += pieces[p].ys;
+        formatted->sources.insert(formatted->sources.end(),
+                                  pieces[p].sources.begin(),
+                                  pieces[p].sources.end());
+        formatted->num_radiometries += pieces[p].num_radiometries;
+    }
+}
+
+void RadiometriesWriter::format_range(
+        const vector<SourcedData<Radiometry, SourceCount<int>>>& radiometries,
+        unsigned int begin,
+        unsigned int end,
+        FormattedRadiometries* formatted) const {
+    // Formatted with snprintf() rather than a stream because it is much
+    // faster; %.17g gives the same text as setprecision(17).
+    char buffer[32];
+    for (unsigned int i = begin; i < end; i++) {
+        for (unsigned int t = 0; t < num_timesteps; t++) {
+            for (unsigned int c = 0; c < num_channels; c++) {
+                double intensity = seq_model.channel_models[c]->mu
+                                   * radiometries[i].value(t, c);
+                if (bytes_per_intensity == sizeof(double)) {
+                    formatted->intensities.append((const char*)&intensity,
+                                                  sizeof(double));
+                } else if (bytes_per_intensity == sizeof(float)) {
+                    float single = (float)intensity;
+                    formatted->intensities.append((const char*)&single,
+                                                  sizeof(float));
+                } else {
+                    if (t != 0 || c != 0) {
+                        formatted->intensities += '\t';
+                    }
+                    int length = snprintf(
+                            buffer, sizeof(buffer), "%.17g", intensity);
+                    formatted->intensities.append(buffer, length);
+                }
+            }
+        }
+        if (bytes_per_intensity == 0) {
+            formatted->intensities += '\n';
+        } else {
+            formatted->sources.push_back(radiometries[i].source.source);
+        }
+        int length = snprintf(
+                buffer, sizeof(buffer), "%d\n", radiometries[i].source.source);
+        formatted->ys.append(buffer, length);
+    }
+    formatted->num_radiometries += end - begin;
+}
+
+void RadiometriesWriter::write(const FormattedRadiometries& formatted) {
+    f.write(formatted.intensities.data(), formatted.intensities.size());
+    ys_f.write(formatted.ys.data(), formatted.ys.size());
+    if (!formatted.sources.empty()) {
+        sources_f.write((const char*)&formatted.sources[0],
+                        formatted.sources.size() * sizeof(int32_t));
+    }
+    num_written += formatted.num_radiometries;
+}
+
+void RadiometriesWriter::close() {
+    if (bytes_per_intensity == 0) {
+        f.seekp(num_radiometries_pos);
+        f << setw(NUM_RADIOMETRIES_WIDTH) << num_written;
+    } else {
+        sources_f.close();
+        if (num_written > 0) {
+            ifstream sources_in(sources_filename, ifstream::binary);
+            f << sources_in.rdbuf();
+        }
+        remove(sources_filename.c_str());
+        BinaryHeader header = binary_header(
+                num_timesteps, num_channels, bytes_per_intensity, num_written);
+        f.seekp(0);
+        f.write((const char*)&header, sizeof(header));
+    }
     f.close();
+    ys_f.seekp(0);
+    ys_f << setw(NUM_RADIOMETRIES_WIDTH) << num_written;
+    ys_f.close();
+}
+
+void read_radiometries(const string& filename,
+                       const SequencingModel& seq_model,
+                       unsigned int* num_timesteps,
+                       unsigned int* num_channels,
+                       unsigned int* num_radiometries,
+                       vector<Radiometry>* radiometries) {
+    RadiometriesReader reader(filename, seq_model);
+    if (!reader.valid) {
+        *num_timesteps = 0;
+        *num_channels = 0;
+        *num_radiometries = 0;
+        return;
+    }
+    *num_timesteps = reader.num_timesteps;
+    *num_channels = reader.num_channels;
+    *num_radiometries = reader.num_radiometries;
+    reader.read(reader.num_radiometries, radiometries);
 }
 
 void write_radiometries(
@@ -81,6 +406,37 @@ void write_radiometries(
     f.close();
 }
 
+void write_radiometries_binary(
+        const string& filename,
+        const SequencingModel& seq_model,
+        unsigned int num_timesteps,
+        unsigned int num_channels,
+        bool single_precision,
+        const vector<SourcedData<Radiometry, SourceCount<int>>>& radiometries) {
+    BinaryHeader header = binary_header(
+            num_timesteps,
+            num_channels,
+            single_precision ? sizeof(float) : sizeof(double),
+            radiometries.size());
+    ofstream f(filename, ofstream::binary);
+    f.write((const char*)&header, sizeof(header));
+    if (single_precision) {
+        write_intensities<float>(
+                &f, seq_model, num_timesteps, num_channels, radiometries);
+    } else {
+        write_intensities<double>(
+                &f, seq_model, num_timesteps, num_channels, radiometries);
+    }
+    vector<int32_t> sources(radiometries.size());
+    for (unsigned int i = 0; i < radiometries.size(); i++) {
+        sources[i] = radiometries[i].source.source;
+    }
+    if (!sources.empty()) {
+        f.write((const char*)&sources[0], sources.size() * sizeof(int32_t));
+    }
+    f.close();
+}
+
 void write_ys(
         const string& filename,
         const vector<SourcedData<Radiometry, SourceCount<int>>>& radiometries) {
@@ -10,6 +10,8 @@
 #define WHATPROT_IO_RADIOMETRIES_IO_H
 
 // Standard C++ library headers:
+#include <cstdint>
+#include <fstream>
 #include <string>
 #include <vector>
 
@@ -17,9 +19,130 @@
 #include "common/radiometry.h"
 #include "common/sourced-data.h"
 #include "parameterization/model/sequencing-model.h"
+#include "util/mapped-file.h"
 
 namespace whatprot {
 
+// Radiometries can be stored either as tab-separated text, or in a binary
+// format which is much faster to load. The binary format is laid out as
+// columns, each contiguous, in native byte order:
+//   - A header of RADIOMETRIES_BINARY_HEADER_SIZE bytes: the eight characters
+//     of RADIOMETRIES_BINARY_MAGIC, then as uint32s the version, num_timesteps,
+//     num_channels, and bytes per intensity (4 for float, 8 for double), then
+//     as uint64s num_radiometries, the byte offset of the intensities, and the
+//     byte offset of the sources (zero if there are none). The remainder is
+//     zero padding.
+//   - The intensities, unnormalized as in the text format, one radiometry
+//     after another, each with its timesteps in order and the channels of a
+//     timestep together.
+//   - Optionally, the int32 source (true dye seq index) of each radiometry.
+// Readers recognize the binary format by its magic, so either format can be
+// given wherever radiometries are read.
+const char RADIOMETRIES_BINARY_MAGIC[] = "WPRADBIN";
+const unsigned int RADIOMETRIES_BINARY_HEADER_SIZE = 64;
+const unsigned int RADIOMETRIES_BINARY_VERSION = 1;
+
+// Reads a radiometries file a chunk at a time, so that a file which is too
+// big to fit in memory can still be processed. The header is read by the
+// constructor. A binary file is mapped into memory rather than read, and each
+// chunk is normalized as it is handed out. The header of a binary file is
+// checked against the size of the file, so that a file which was cut short
+// (e.g., by an interrupted simulation) is rejected rather than read past its
+// end.
+class RadiometriesReader {
+public:
+    RadiometriesReader(const std::string& filename,
+                       const SequencingModel& seq_model);
+    ~RadiometriesReader();
+    // Clears radiometries, then reads up to max_num_radiometries more
+    // radiometries from the file into it. Returns the number read, which is
+    // zero once the whole file has been read.
+    unsigned int read(unsigned int max_num_radiometries,
+                      std::vector<Radiometry>* radiometries);
+    // False if the file is in the binary format but is not a file this version
+    // can read, or is too short for what its header describes. Nothing can be
+    // read then, and num_radiometries is zero.
+    bool valid;
+    std::ifstream f;
+    // NULL unless the file is in the binary format.
+    MappedFile* mapped_file;
+    const char* binary_intensities;
+    unsigned int bytes_per_intensity;
+    const SequencingModel& seq_model;
+    unsigned int num_timesteps;
+    unsigned int num_channels;
+    unsigned int num_radiometries;
+    // Number of radiometries read so far.
+    unsigned int num_read;
+};
+
+// Radiometries and their ys, formatted by a RadiometriesWriter and ready to be
+// written.
+class FormattedRadiometries {
+public:
+    // Text, or the raw intensities for the binary format.
+    std::string intensities;
+    std::string ys;
+    // Only for the binary format.
+    std::vector<std::int32_t> sources;
+    unsigned int num_radiometries;
+
+    FormattedRadiometries() : num_radiometries(0) {}
+};
+
+// Writes radiometries to a file a chunk at a time, in the same format as
+// write_radiometries() or write_radiometries_binary(), and their ys in the
+// same format as write_ys(). The number of radiometries is not known until the
+// end, so the constructor leaves room for it in each header, and close() fills
+// it in. In the text formats the number is padded on the left with spaces,
+// which readers skip. The sources of the binary format go after all of the
+// intensities, so until then they are kept in a temporary file next to it.
+//
+// Formatting is the slow part of writing text, so format() uses all of the
+// OpenMP threads, and can be run while write() writes what was formatted
+// before.
+class RadiometriesWriter {
+public:
+    // The format is one of tsv, bin64, or bin32, as for simulate rad.
+    RadiometriesWriter(const std::string& radiometries_filename,
+                       const std::string& ys_filename,
+                       const SequencingModel& seq_model,
+                       unsigned int num_timesteps,
+                       unsigned int num_channels,
+                       const std::string& format);
+    // Formats radiometries for write(), replacing what formatted held.
+    void format(const std::vector<SourcedData<Radiometry, SourceCount<int>>>&
+                        radiometries,
+                FormattedRadiometries* formatted) const;
+    // Appends formatted radiometries to the files.
+    void write(const FormattedRadiometries& formatted);
+    // Fills in the headers and closes the files.
+    void close();
+    // Formats radiometries [begin, end) on to the end of formatted.
+    void format_range(
+            const std::vector<SourcedData<Radiometry, SourceCount<int>>>&
+                    radiometries,
+            unsigned int begin,
+            unsigned int end,
+            FormattedRadiometries* formatted) const;
+    std::ofstream f;
+    std::ofstream ys_f;
+    // Only for the binary format.
+    std::ofstream sources_f;
+    std::string sources_filename;
+    const SequencingModel& seq_model;
+    unsigned int num_timesteps;
+    unsigned int num_channels;
+    // 0 for text, or the size of each intensity in the binary format.
+    unsigned int bytes_per_intensity;
+    // Where the number of radiometries goes in the text format.
+    std::streampos num_radiometries_pos;
+    // Number of radiometries written so far.
+    unsigned int num_written;
+};
+
+// If the file is not valid (see RadiometriesReader::valid), *num_timesteps is
+// set to zero and no radiometries are read.
 void read_radiometries(const std::string& filename,
                        const SequencingModel& seq_model,
                        unsigned int* num_timesteps,
@@ -35,6 +158,17 @@ void write_radiometries(
         const std::vector<SourcedData<Radiometry, SourceCount<int>>>&
                 radiometries);
 
+// The sources are stored as well. If single_precision is true, intensities are
+// stored as floats rather than doubles, which halves the size of the file.
+void write_radiometries_binary(
+        const std::string& filename,
+        const SequencingModel& seq_model,
+        unsigned int num_timesteps,
+        unsigned int num_channels,
+        bool single_precision,
+        const std::vector<SourcedData<Radiometry, SourceCount<int>>>&
+                radiometries);
+
 void write_ys(const std::string& filename,
               const std::vector<SourcedData<Radiometry, SourceCount<int>>>&
                       radiometries);
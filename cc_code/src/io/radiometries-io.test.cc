@@ -0,0 +1,382 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+// Boost unit test framework (recommended to be the first include):
+#include <boost/test/unit_test.hpp>
+
+// File under test:
+#include "radiometries-io.h"
+
+// Standard C++ library headers:
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Local project headers:
+#include "common/radiometry.h"
+#include "common/sourced-data.h"
+#include "parameterization/model/sequencing-model.h"
+
+namespace whatprot {
+
+namespace {
+using boost::unit_test::tolerance;
+using std::ifstream;
+using std::istreambuf_iterator;
+using std::ofstream;
+using std::remove;
+using std::string;
+using std::uint32_t;
+using std::vector;
+const double TOL = 0.000000001;
+// Loose enough for intensities stored as floats.
+const double FLOAT_TOL = 0.0000001;
+
+// Offsets of some fields of the binary header, as documented in the header.
+const unsigned int VERSION_POS = 8;
+const unsigned int BYTES_PER_INTENSITY_POS = 20;
+
+// Two channels, with mu of 2.0 and 4.0.
+SequencingModel test_seq_model() {
+    SequencingModel seq_model(2);
+    seq_model.channel_models[0]->mu = 2.0;
+    seq_model.channel_models[1]->mu = 4.0;
+    return seq_model;
+}
+
+// Normalized radiometries (i.e., with mu as one), of three timesteps and two
+// channels, numbered from begin to end. The value at (t, c) of radiometry i is
+// i + 0.1 * t + 0.01 * c, and the source is 10 * i.
+void make_radiometries_range(
+        unsigned int begin,
+        unsigned int end,
+        vector<SourcedData<Radiometry, SourceCount<int>>>* radiometries) {
+    for (unsigned int i = begin; i < end; i++) {
+        Radiometry radiometry(3, 2);
+        for (unsigned int t = 0; t < 3; t++) {
+            for (unsigned int c = 0; c < 2; c++) {
+                radiometry(t, c) = i + 0.1 * t + 0.01 * c;
+            }
+        }
+        radiometries->push_back(SourcedData<Radiometry, SourceCount<int>>(
+                radiometry, SourceCount<int>(10 * i, 1)));
+    }
+}
+
+void make_radiometries(
+        unsigned int num_radiometries,
+        vector<SourcedData<Radiometry, SourceCount<int>>>* radiometries) {
+    make_radiometries_range(0, num_radiometries, radiometries);
+}
+
+string read_file(const string& filename) {
+    ifstream f(filename, ifstream::binary);
+    return string(istreambuf_iterator<char>(f), istreambuf_iterator<char>());
+}
+
+void write_file(const string& filename, const string& contents) {
+    ofstream f(filename, ofstream::binary);
+    f.write(contents.data(), contents.size());
+}
+
+// The test case calling this must set a tolerance for the intensities.
+void check_binary_round_trip(bool single_precision) {
+    string filename = "radiometries-io-test.tmp";
+    SequencingModel seq_model = test_seq_model();
+    vector<SourcedData<Radiometry, SourceCount<int>>> radiometries;
+    make_radiometries(5, &radiometries);
+    write_radiometries_binary(
+            filename, seq_model, 3, 2, single_precision, radiometries);
+    {
+        RadiometriesReader reader(filename, seq_model);
+        BOOST_TEST(reader.valid);
+        BOOST_TEST(reader.mapped_file != (MappedFile*)NULL);
+        BOOST_TEST(reader.num_timesteps == 3u);
+        BOOST_TEST(reader.num_channels == 2u);
+        BOOST_TEST(reader.num_radiometries == 5u);
+        // Read in two chunks, the second one short, to check the offsets.
+        vector<Radiometry> chunk;
+        vector<Radiometry> read;
+        while (reader.read(3, &chunk) > 0) {
+            for (const Radiometry& radiometry : chunk) {
+                read.push_back(radiometry);
+            }
+        }
+        BOOST_REQUIRE(read.size() == 5u);
+        for (unsigned int i = 0; i < 5; i++) {
+            for (unsigned int t = 0; t < 3; t++) {
+                for (unsigned int c = 0; c < 2; c++) {
+                    BOOST_TEST(read[i](t, c) == radiometries[i].value(t, c));
+                }
+            }
+        }
+    }
+    remove(filename.c_str());
+}
+
+// Writes a valid bin64 file of two radiometries, and returns its contents.
+string valid_binary_contents(const string& filename) {
+    vector<SourcedData<Radiometry, SourceCount<int>>> radiometries;
+    make_radiometries(2, &radiometries);
+    write_radiometries_binary(filename,
+                              test_seq_model(),
+                              3,
+                              2,
+                              false,  // single precision
+                              radiometries);
+    return read_file(filename);
+}
+
+// Writes the radiometries of make_radiometries() with a RadiometriesWriter, in
+// blocks of the given sizes.
+void write_in_blocks(const string& filename,
+                     const string& ys_filename,
+                     const string& format,
+                     const vector<unsigned int>& block_sizes) {
+    SequencingModel seq_model = test_seq_model();
+    RadiometriesWriter writer(filename, ys_filename, seq_model, 3, 2, format);
+    FormattedRadiometries formatted;
+    unsigned int begin = 0;
+    for (unsigned int block_size : block_sizes) {
+        vector<SourcedData<Radiometry, SourceCount<int>>> block;
+        make_radiometries_range(begin, begin + block_size, &block);
+        writer.format(block, &formatted);
+        writer.write(formatted);
+        begin += block_size;
+    }
+    writer.close();
+}
+
+// There is no reader for ys files, so they are parsed here. The number at the
+// top must match the number of ys.
+vector<int> parse_ys(const string& filename) {
+    ifstream f(filename);
+    unsigned int num_ys;
+    f >> num_ys;
+    vector<int> ys;
+    int y;
+    while (f >> y) {
+        ys.push_back(y);
+    }
+    BOOST_TEST(ys.size() == num_ys);
+    return ys;
+}
+
+// Blocks for write_in_blocks(), with an empty one, and one which is formatted
+// in more than one piece.
+vector<unsigned int> test_block_sizes() {
+    return vector<unsigned int>({1000, 0, 1300, 200});
+}
+
+// Checks that a RadiometriesWriter writing in blocks gives the same binary
+// file as write_radiometries_binary(), and the same ys as write_ys(). The test
+// case calling this must set a tolerance for the intensities.
+void check_writer_binary(const string& format, bool single_precision) {
+    string filename = "radiometries-io-test.tmp";
+    string ys_filename = "radiometries-io-test-ys.tmp";
+    SequencingModel seq_model = test_seq_model();
+    vector<SourcedData<Radiometry, SourceCount<int>>> radiometries;
+    make_radiometries(2500, &radiometries);
+    write_radiometries_binary(
+            filename, seq_model, 3, 2, single_precision, radiometries);
+    string expected = read_file(filename);
+    write_ys(ys_filename, radiometries);
+    vector<int> expected_ys = parse_ys(ys_filename);
+    write_in_blocks(filename, ys_filename, format, test_block_sizes());
+    BOOST_TEST((read_file(filename) == expected));
+    BOOST_TEST(parse_ys(ys_filename) == expected_ys);
+    // The temporary file of sources is gone.
+    BOOST_TEST(!ifstream(filename + ".sources").good());
+    {
+        RadiometriesReader reader(filename, seq_model);
+        BOOST_TEST(reader.valid);
+        BOOST_TEST(reader.num_radiometries == 2500u);
+        vector<Radiometry> read;
+        BOOST_TEST(reader.read(2500, &read) == 2500u);
+        BOOST_REQUIRE(read.size() == 2500u);
+        // The first, across the first blocks, and the last.
+        unsigned int checked[] = {0, 999, 1000, 2299, 2300, 2499};
+        for (unsigned int i : checked) {
+            BOOST_TEST(read[i](2, 1) == i + 0.21);
+        }
+    }
+    remove(filename.c_str());
+    remove(ys_filename.c_str());
+}
+
+bool reader_accepts(const string& filename, const string& contents) {
+    write_file(filename, contents);
+    SequencingModel seq_model = test_seq_model();
+    RadiometriesReader reader(filename, seq_model);
+    if (!reader.valid) {
+        BOOST_TEST(reader.num_radiometries == 0u);
+        vector<Radiometry> radiometries;
+        BOOST_TEST(reader.read(10, &radiometries) == 0u);
+        BOOST_TEST(radiometries.empty());
+    }
+    return reader.valid;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(io_suite)
+BOOST_AUTO_TEST_SUITE(radiometries_io_suite)
+
+BOOST_AUTO_TEST_CASE(binary_round_trip_double_test, *tolerance(TOL)) {
+    check_binary_round_trip(false);  // single precision
+}
+
+BOOST_AUTO_TEST_CASE(binary_round_trip_float_test, *tolerance(FLOAT_TOL)) {
+    check_binary_round_trip(true);  // single precision
+}
+
+BOOST_AUTO_TEST_CASE(binary_sources_test) {
+    string filename = "radiometries-io-test.tmp";
+    string contents = valid_binary_contents(filename);
+    // The int32 sources follow the 64 byte header and 2 * 3 * 2 doubles.
+    BOOST_REQUIRE(contents.size() == 64u + 12u * 8u + 2u * 4u);
+    const int* sources = (const int*)(contents.data() + 64 + 12 * 8);
+    BOOST_TEST(sources[0] == 0);
+    BOOST_TEST(sources[1] == 10);
+    remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(binary_valid_test) {
+    string filename = "radiometries-io-test.tmp";
+    string contents = valid_binary_contents(filename);
+    BOOST_TEST(reader_accepts(filename, contents));
+    remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(binary_truncated_test) {
+    string filename = "radiometries-io-test.tmp";
+    string contents = valid_binary_contents(filename);
+    // Cut into the sources, into the intensities, and into the header.
+    string cut = contents.substr(0, contents.size() - 1);
+    BOOST_TEST(!reader_accepts(filename, cut));
+    BOOST_TEST(!reader_accepts(filename, contents.substr(0, 64 + 8 * 8)));
+    BOOST_TEST(!reader_accepts(filename, contents.substr(0, 64)));
+    remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(binary_bad_version_test) {
+    string filename = "radiometries-io-test.tmp";
+    string contents = valid_binary_contents(filename);
+    uint32_t version = RADIOMETRIES_BINARY_VERSION + 1;
+    contents.replace(VERSION_POS,
+                     sizeof(version),
+                     (const char*)&version,
+                     sizeof(version));
+    BOOST_TEST(!reader_accepts(filename, contents));
+    remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(binary_bad_bytes_per_intensity_test) {
+    string filename = "radiometries-io-test.tmp";
+    string contents = valid_binary_contents(filename);
+    // Two bytes per intensity would make the file look big enough, but is not
+    // a size we can read.
+    uint32_t bytes_per_intensity = 2;
+    contents.replace(BYTES_PER_INTENSITY_POS,
+                     sizeof(bytes_per_intensity),
+                     (const char*)&bytes_per_intensity,
+                     sizeof(bytes_per_intensity));
+    BOOST_TEST(!reader_accepts(filename, contents));
+    remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(read_radiometries_invalid_test) {
+    string filename = "radiometries-io-test.tmp";
+    string contents = valid_binary_contents(filename);
+    write_file(filename, contents.substr(0, contents.size() - 1));
+    unsigned int num_timesteps;
+    unsigned int num_channels;
+    unsigned int num_radiometries;
+    vector<Radiometry> radiometries;
+    read_radiometries(filename,
+                      test_seq_model(),
+                      &num_timesteps,
+                      &num_channels,
+                      &num_radiometries,
+                      &radiometries);
+    BOOST_TEST(num_timesteps == 0u);
+    BOOST_TEST(num_radiometries == 0u);
+    BOOST_TEST(radiometries.empty());
+    remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(writer_tsv_test) {
+    string filename = "radiometries-io-test.tmp";
+    string ys_filename = "radiometries-io-test-ys.tmp";
+    SequencingModel seq_model = test_seq_model();
+    vector<SourcedData<Radiometry, SourceCount<int>>> radiometries;
+    make_radiometries(2500, &radiometries);
+    write_radiometries(filename, seq_model, 3, 2, radiometries);
+    string expected = read_file(filename);
+    write_ys(ys_filename, radiometries);
+    vector<int> expected_ys = parse_ys(ys_filename);
+    write_in_blocks(filename, ys_filename, "tsv", test_block_sizes());
+    string written = read_file(filename);
+    // The number of radiometries, on the third line, is padded on the left,
+    // but everything else is the same.
+    string::size_type expected_end = expected.find('\n', 4);
+    string::size_type written_end = written.find('\n', 4);
+    BOOST_REQUIRE(expected_end != string::npos);
+    BOOST_REQUIRE(written_end != string::npos);
+    BOOST_TEST(written.substr(0, 4) == expected.substr(0, 4));
+    BOOST_TEST(written.substr(4, written_end - 4) == "      2500");
+    BOOST_TEST((written.substr(written_end) == expected.substr(expected_end)));
+    BOOST_TEST(parse_ys(ys_filename) == expected_ys);
+    unsigned int num_timesteps;
+    unsigned int num_channels;
+    unsigned int num_radiometries;
+    vector<Radiometry> read;
+    read_radiometries(filename,
+                      seq_model,
+                      &num_timesteps,
+                      &num_channels,
+                      &num_radiometries,
+                      &read);
+    BOOST_TEST(num_timesteps == 3u);
+    BOOST_TEST(num_channels == 2u);
+    BOOST_TEST(num_radiometries == 2500u);
+    BOOST_TEST(read.size() == 2500u);
+    remove(filename.c_str());
+    remove(ys_filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(writer_bin64_test, *tolerance(TOL)) {
+    check_writer_binary("bin64", false);  // single precision
+}
+
+BOOST_AUTO_TEST_CASE(writer_bin32_test, *tolerance(FLOAT_TOL)) {
+    check_writer_binary("bin32", true);  // single precision
+}
+
+BOOST_AUTO_TEST_CASE(writer_empty_test) {
+    string filename = "radiometries-io-test.tmp";
+    string ys_filename = "radiometries-io-test-ys.tmp";
+    SequencingModel seq_model = test_seq_model();
+    vector<string> formats = {"tsv", "bin64", "bin32"};
+    for (const string& format : formats) {
+        write_in_blocks(filename, ys_filename, format, vector<unsigned int>());
+        RadiometriesReader reader(filename, seq_model);
+        BOOST_TEST(reader.valid);
+        BOOST_TEST(reader.num_timesteps == 3u);
+        BOOST_TEST(reader.num_radiometries == 0u);
+        BOOST_TEST(parse_ys(ys_filename).empty());
+    }
+    remove(filename.c_str());
+    remove(ys_filename.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // radiometries_io_suite
+BOOST_AUTO_TEST_SUITE_END()  // io_suite
+
+}  // namespace whatprot
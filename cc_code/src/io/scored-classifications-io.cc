@@ -27,6 +27,22 @@ using std::string;
 using std::vector;
 }  // namespace
 
+ScoredClassificationsWriter::ScoredClassificationsWriter(const string& filename)
+        : f(filename), num_written(0) {
+    f << "radmat_iz,best_pep_iz,best_pep_score\n";
+}
+
+void ScoredClassificationsWriter::write(
+        const vector<ScoredClassification>& scored_classifications) {
+    for (const ScoredClassification& scored_classification :
+         scored_classifications) {
+        f << num_written << ",";
+        f << scored_classification.id << ",";
+        f << setprecision(17) << scored_classification.adjusted_score() << "\n";
+        num_written++;
+    }
+}
+
 void write_scored_classifications(
         const string& filename,
         int total_num_scored_classifications,
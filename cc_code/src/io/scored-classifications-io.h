@@ -10,6 +10,7 @@
 #define WHATPROT_IO_SCORED_CLASSIFICATIONS_IO_H
 
 // Standard C++ library headers:
+#include <fstream>
 #include <string>
 #include <vector>
 
@@ -18,6 +19,21 @@
 
 namespace whatprot {
 
+// Writes scored classifications to a file a chunk at a time, in the same
+// format as write_scored_classifications(). The header is written by the
+// constructor.
+class ScoredClassificationsWriter {
+public:
+    ScoredClassificationsWriter(const std::string& filename);
+    // Appends the scored classifications to the file, numbering them on from
+    // those written already.
+    void write(
+            const std::vector<ScoredClassification>& scored_classifications);
+    std::ofstream f;
+    // Number of scored classifications written so far.
+    int num_written;
+};
+
 void write_scored_classifications(
         const std::string& filename,
         int total_num_scored_classifications,
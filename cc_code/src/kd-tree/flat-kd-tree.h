@@ -0,0 +1,757 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+#ifndef KD_TREE_FLAT_KD_TREE_H
+#define KD_TREE_FLAT_KD_TREE_H
+
+// Standard C++ library headers:
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+// Local project headers:
+#include "kd-tree/internal-node.h"
+#include "kd-tree/k-best.h"
+#include "kd-tree/kd-tree.h"
+#include "kd-tree/leaf-node.h"
+#include "kd-tree/node.h"
+
+namespace whatprot {
+namespace kd_tree {
+
+// A node of a FlatKDTree. Nodes are stored in breadth-first order, so the
+// upper levels of the tree, which every search goes through, share a few cache
+// lines. The two children of an internal node are always stored next to each
+// other.
+class FlatNode {
+public:
+    int s;  // split dimension, or -1 for a leaf.
+    // Index into the nodes of the left child; the right child is the node
+    // right after it. Zero for a leaf.
+    unsigned int left_child;
+    // The entries under this node (in any leaf below it) are [begin, end).
+    unsigned int begin;
+    unsigned int end;
+    // These three are as in InternalNode, and are zero for a leaf.
+    double max_left;
+    double min_right;
+    double split_value;
+};
+
+// Everything KBest needs to know about an entry of a FlatKDTree.
+class FlatEntry {
+public:
+    int hits;
+};
+
+// Scratch space for FlatKDTree::search_leaf(), with room for the largest leaf.
+class LeafScratch {
+public:
+    LeafScratch(unsigned int size) : dists_sq(size), survivors(size) {}
+
+    std::vector<double> dists_sq;
+    std::vector<unsigned int> survivors;
+};
+
+// Everything a search of a FlatKDTree needs besides the tree. Each thread
+// keeps one of these (see FlatKDTree::thread_scratch()), which only ever grows,
+// so that a thread classifying many radiometries allocates nothing once it has
+// done its first few searches.
+class SearchScratch {
+public:
+    SearchScratch() : leaf(0) {}
+
+    // Make room for leaves of up to max_leaf_size entries and for num_queries
+    // queries of d dimensions and num_features features (see
+    // FlatKDTree::build_prefilter()), and reset the first num_queries of
+    // k_bests.
+    void prepare(unsigned int max_leaf_size,
+                 unsigned int num_queries,
+                 int d,
+                 int num_features,
+                 int k) {
+        if (leaf.dists_sq.size() < max_leaf_size) {
+            leaf.dists_sq.resize(max_leaf_size);
+            leaf.survivors.resize(max_leaf_size);
+        }
+        if (query.size() < (unsigned int)d) {
+            query.resize(d);
+        }
+        if (query_features.size() < (size_t)num_queries * num_features) {
+            query_features.resize((size_t)num_queries * num_features);
+        }
+        while (k_bests.size() < num_queries) {
+            k_bests.push_back(KBest<const FlatEntry>(k));
+        }
+        for (unsigned int q = 0; q < num_queries; q++) {
+            k_bests[q].reset(k);
+        }
+    }
+
+    LeafScratch leaf;
+    std::vector<double> query;
+    std::vector<double> query_features;
+    std::vector<KBest<const FlatEntry>> k_bests;
+};
+
+// Sets nodes to root and everything below it, in breadth-first order. The
+// entries of the leaves are given as indices relative to values, which must be
+// the values of the KDTree.
+template <typename E, typename Q>
+void flatten_tree(const Node<E, Q>* root,
+                  const E* values,
+                  std::vector<FlatNode>* nodes) {
+    // The node at queue[i] becomes (*nodes)[i]. A node always comes after its
+    // parent, which is what lets the loop below fill in the ranges of the
+    // internal nodes from their children.
+    std::vector<const Node<E, Q>*> queue;
+    queue.push_back(root);
+    for (unsigned int i = 0; i < queue.size(); i++) {
+        FlatNode flat;
+        const LeafNode<E, Q>* leaf =
+                dynamic_cast<const LeafNode<E, Q>*>(queue[i]);
+        if (leaf != NULL) {
+            flat.s = -1;
+            flat.left_child = 0;
+            flat.begin = leaf->begin - values;
+            flat.end = leaf->end - values;
+            flat.max_left = 0.0;
+            flat.min_right = 0.0;
+            flat.split_value = 0.0;
+        } else {
+            const InternalNode<E, Q>* internal =
+                    static_cast<const InternalNode<E, Q>*>(queue[i]);
+            flat.s = internal->s;
+            flat.left_child = queue.size();
+            flat.begin = 0;
+            flat.end = 0;
+            flat.max_left = internal->max_left;
+            flat.min_right = internal->min_right;
+            flat.split_value = internal->split_value;
+            queue.push_back(internal->left_child);
+            queue.push_back(internal->right_child);
+        }
+        nodes->push_back(flat);
+    }
+    for (unsigned int i = nodes->size(); i-- > 0;) {
+        FlatNode& flat = (*nodes)[i];
+        if (flat.s != -1) {
+            flat.begin = (*nodes)[flat.left_child].begin;
+            flat.end = (*nodes)[flat.left_child + 1].end;
+        }
+    }
+}
+
+}  // namespace kd_tree
+
+// A KDTree with all of its nodes in one array, and with the coordinates of
+// every entry computed once, up front, and stored in one array in the order of
+// the leaves. Nothing in it is a pointer, so it can be written to a file as is
+// and later used straight out of a mapping of that file. A search gives exactly
+// the same results as a search of the KDTree it was flattened from.
+//
+// The coordinates of the entries of each leaf are stored together, one
+// dimension at a time (the first coordinate of every entry of the leaf, then
+// the second, and so on), so that the distances to every entry of a leaf can be
+// computed together in a loop which the compiler vectorizes.
+//
+// Entries are identified by their index, i.e., the position of their
+// FlatEntry in entries. This is also the index of the entry in the values of
+// the KDTree it was flattened from.
+class FlatKDTree {
+public:
+    // Flattens tree, which is not modified. Here d is the dimensionality that
+    // tree was built with.
+    template <typename E, typename Q>
+    FlatKDTree(const KDTree<E, Q>& tree, int d)
+            : d(d), num_entries(tree.values.size()) {
+        const E* values = &tree.values[0];
+        kd_tree::flatten_tree<E, Q>(tree.root, values, &owned_nodes);
+        num_nodes = owned_nodes.size();
+        owned_coordinates.resize((size_t)num_entries * d);
+        owned_entries.resize(num_entries);
+        for (unsigned int n = 0; n < num_nodes; n++) {
+            const kd_tree::FlatNode& leaf = owned_nodes[n];
+            if (leaf.s != -1) {
+                continue;
+            }
+            unsigned int size = leaf.end - leaf.begin;
+            double* block = &owned_coordinates[(size_t)leaf.begin * d];
+            for (unsigned int i = 0; i < size; i++) {
+                for (int j = 0; j < d; j++) {
+                    block[(size_t)j * size + i] = values[leaf.begin + i][j];
+                }
+            }
+        }
+        for (unsigned int i = 0; i < num_entries; i++) {
+            owned_entries[i].hits = values[i].hits;
+        }
+        nodes = &owned_nodes[0];
+        coordinates = &owned_coordinates[0];
+        entries = &owned_entries[0];
+        num_features = 0;
+        num_coarse_features = 0;
+        find_max_leaf_size();
+    }
+
+    // Views a flat tree stored elsewhere (i.e., in a MappedFile), which must
+    // outlive this.
+    FlatKDTree(int d,
+               unsigned int num_nodes,
+               unsigned int num_entries,
+               const kd_tree::FlatNode* nodes,
+               const double* coordinates,
+               const kd_tree::FlatEntry* entries)
+            : d(d),
+              num_nodes(num_nodes),
+              num_entries(num_entries),
+              nodes(nodes),
+              coordinates(coordinates),
+              entries(entries),
+              num_features(0),
+              num_coarse_features(0) {
+        find_max_leaf_size();
+    }
+
+    // Sets up a lower bound on the distance to each entry, which search_leaf()
+    // uses to rule out most of the entries of a leaf before computing much of
+    // their distances. The coordinates are taken to be num_channels channels
+    // at each of d / num_channels timesteps, with coordinate j at timestep
+    // j / num_channels and of channel j % num_channels, as with a Radiometry.
+    //
+    // Each entry gets a few features, which are its coordinates in an
+    // orthonormal basis of part of the space, so the distance between the
+    // features of two points is never more than the distance between the
+    // points. The same goes for any subset of the features, so the bound can be
+    // built up one feature at a time, and an entry dropped as soon as it is
+    // too far away. The first feature of each channel is the sum of all of its
+    // timesteps. After that, each level splits every block of timesteps from
+    // the level before it in half, and adds the difference between the two
+    // halves (as in a Haar wavelet). Dye tracks are staircases, so these say a
+    // lot about them in very few numbers, and the bound is usually close.
+    //
+    // This does not change the results of any search. It can be used whether
+    // the tree was flattened here or is viewed; the features are always kept
+    // here, and are not part of an index.
+    void build_prefilter(int num_channels, int num_levels) {
+        int num_timesteps = d / num_channels;
+        feature_offsets.assign(1, 0);
+        feature_dims.clear();
+        feature_weights.clear();
+        for (int c = 0; c < num_channels; c++) {
+            for (int t = 0; t < num_timesteps; t++) {
+                feature_dims.push_back(t * num_channels + c);
+                feature_weights.push_back(1.0 / std::sqrt(num_timesteps));
+            }
+            feature_offsets.push_back(feature_dims.size());
+        }
+        num_coarse_features = num_channels;
+        // Each block is the timesteps [first, second), for every channel.
+        std::vector<std::pair<int, int>> blocks;
+        blocks.push_back(std::pair<int, int>(0, num_timesteps));
+        for (int level = 0; level < num_levels; level++) {
+            std::vector<std::pair<int, int>> next_blocks;
+            for (int c = 0; c < num_channels; c++) {
+                for (const std::pair<int, int>& block : blocks) {
+                    int begin = block.first;
+                    int end = block.second;
+                    if (end - begin < 2) {
+                        continue;
+                    }
+                    int mid = (begin + end) / 2;
+                    // Scaled so that the weights have a norm of one.
+                    double n_left = mid - begin;
+                    double n_right = end - mid;
+                    double n = end - begin;
+                    for (int t = begin; t < end; t++) {
+                        feature_dims.push_back(t * num_channels + c);
+                        if (t < mid) {
+                            feature_weights.push_back(
+                                    std::sqrt(n_right / (n_left * n)));
+                        } else {
+                            feature_weights.push_back(
+                                    -std::sqrt(n_left / (n_right * n)));
+                        }
+                    }
+                    feature_offsets.push_back(feature_dims.size());
+                    if (c == 0) {
+                        next_blocks.push_back(
+                                std::pair<int, int>(begin, mid));
+                        next_blocks.push_back(std::pair<int, int>(mid, end));
+                    }
+                }
+            }
+            blocks.swap(next_blocks);
+        }
+        num_features = feature_offsets.size() - 1;
+        // Stored like the coordinates, one feature at a time within each leaf.
+        features.assign((size_t)num_entries * num_features, 0.0);
+        for (unsigned int n = 0; n < num_nodes; n++) {
+            const kd_tree::FlatNode& leaf = nodes[n];
+            if (leaf.s != -1) {
+                continue;
+            }
+            unsigned int size = leaf.end - leaf.begin;
+            const double* block = &coordinates[(size_t)leaf.begin * d];
+            double* feature_block =
+                    &features[(size_t)leaf.begin * num_features];
+            for (int f = 0; f < num_features; f++) {
+                double* feature = &feature_block[(size_t)f * size];
+                for (int x = feature_offsets[f]; x < feature_offsets[f + 1];
+                     x++) {
+                    const double* c = &block[(size_t)feature_dims[x] * size];
+                    double weight = feature_weights[x];
+                    for (unsigned int i = 0; i < size; i++) {
+                        feature[i] += c[i] * weight;
+                    }
+                }
+            }
+        }
+    }
+
+    // The features of query (see build_prefilter()), into query_features.
+    void compute_features(const double* query, double* query_features) const {
+        for (int f = 0; f < num_features; f++) {
+            query_features[f] = 0.0;
+            for (int x = feature_offsets[f]; x < feature_offsets[f + 1]; x++) {
+                query_features[f] +=
+                        query[feature_dims[x]] * feature_weights[x];
+            }
+        }
+    }
+
+    // Same as KDTree::search(), except that k is given here, and that the
+    // search may be approximate. If epsilon is zero, the search is exact.
+    // Otherwise a subtree is skipped unless it could hold something more than
+    // (1 + epsilon) times closer than the current k-th nearest. This visits far
+    // fewer leaves, and every neighbor found is still within (1 + epsilon)
+    // times the distance of the true k-th nearest.
+    template <typename Q>
+    void search(const Q& query,
+                int k,
+                double epsilon,
+                std::vector<const kd_tree::FlatEntry*>* k_nearest,
+                std::vector<double>* dists_sq) const {
+        kd_tree::SearchScratch* scratch = thread_scratch();
+        scratch->prepare(max_leaf_size, 1, d, num_features, k);
+        for (int j = 0; j < d; j++) {
+            scratch->query[j] = query[j];
+        }
+        // Without a prefilter there are no features, so query_features may be
+        // empty.
+        compute_features(&scratch->query[0], scratch->query_features.data());
+        search_node(0,
+                    &scratch->query[0],
+                    scratch->query_features.data(),
+                    prune_factor(epsilon),
+                    &scratch->leaf,
+                    &scratch->k_bests[0]);
+        scratch->k_bests[0].fill(k_nearest, dists_sq);
+    }
+
+    // Same as search(), for a whole batch of queries, each given as d values.
+    // The results for queries[q] go in (*k_nearest)[q] and (*dists_sq)[q], and
+    // are exactly what search() would give. The tree is walked once for the
+    // whole batch, so each leaf is searched for every query which reaches it
+    // while it is still in cache. This works best when the queries are close
+    // together; see descend().
+    void search_batch(
+            const std::vector<const double*>& queries,
+            int k,
+            double epsilon,
+            std::vector<std::vector<const kd_tree::FlatEntry*>>* k_nearest,
+            std::vector<std::vector<double>>* dists_sq) const {
+        kd_tree::SearchScratch* scratch = thread_scratch();
+        scratch->prepare(max_leaf_size, queries.size(), d, num_features, k);
+        std::vector<unsigned int> active(queries.size());
+        for (unsigned int q = 0; q < queries.size(); q++) {
+            active[q] = q;
+            compute_features(queries[q],
+                             scratch->query_features.data()
+                                     + (size_t)q * num_features);
+        }
+        batch_search_node(0,
+                          queries,
+                          scratch->query_features.data(),
+                          active,
+                          prune_factor(epsilon),
+                          &scratch->leaf,
+                          &scratch->k_bests);
+        k_nearest->resize(queries.size());
+        dists_sq->resize(queries.size());
+        for (unsigned int q = 0; q < queries.size(); q++) {
+            (*k_nearest)[q].clear();
+            (*dists_sq)[q].clear();
+            scratch->k_bests[q].fill(&(*k_nearest)[q], &(*dists_sq)[q]);
+        }
+    }
+
+    // Follows query down the tree, without any backtracking, and gives the
+    // index of the first entry of the leaf it ends up at. The leaves are in
+    // order through space, so sorting queries by this puts queries which
+    // search the same part of the tree next to each other.
+    unsigned int descend(const double* query) const {
+        unsigned int node_index = 0;
+        while (nodes[node_index].s != -1) {
+            const kd_tree::FlatNode& node = nodes[node_index];
+            node_index = node.left_child;
+            if (query[node.s] >= node.split_value) {
+                node_index++;
+            }
+        }
+        return nodes[node_index].begin;
+    }
+
+    unsigned int index(const kd_tree::FlatEntry* entry) const {
+        return entry - entries;
+    }
+
+    // Squared distances to subtrees are scaled by this before comparing them
+    // to the k-th nearest distance. With an epsilon of zero this is exactly
+    // one, so that an exact search does exactly the same arithmetic.
+    static double prune_factor(double epsilon) {
+        return (1.0 + epsilon) * (1.0 + epsilon);
+    }
+
+    // The SearchScratch of the calling thread.
+    static kd_tree::SearchScratch* thread_scratch() {
+        static thread_local kd_tree::SearchScratch scratch;
+        return &scratch;
+    }
+
+    // Same as InternalNode::search(), except for the prune_factor; see
+    // search() and prune_factor().
+    void search_node(unsigned int node_index,
+                     const double* query,
+                     const double* query_features,
+                     double prune_factor,
+                     kd_tree::LeafScratch* scratch,
+                     kd_tree::KBest<const kd_tree::FlatEntry>* k_best) const {
+        const kd_tree::FlatNode& node = nodes[node_index];
+        if (node.s == -1) {
+            search_leaf(node, query, query_features, scratch, k_best);
+            return;
+        }
+        unsigned int left = node.left_child;
+        unsigned int right = node.left_child + 1;
+        double query_value = query[node.s];
+        if (query_value < node.split_value) {
+            search_node(left,
+                        query,
+                        query_features,
+                        prune_factor,
+                        scratch,
+                        k_best);
+            // Must use squared distances. See InternalNode::search().
+            double right_dist = node.min_right - query_value;
+            double right_dist_sq = right_dist * right_dist;
+            if (k_best->kth_dist_sq > right_dist_sq * prune_factor) {
+                search_node(right,
+                            query,
+                            query_features,
+                            prune_factor,
+                            scratch,
+                            k_best);
+            }
+        } else {
+            search_node(right,
+                        query,
+                        query_features,
+                        prune_factor,
+                        scratch,
+                        k_best);
+            double left_dist = query_value - node.max_left;
+            double left_dist_sq = left_dist * left_dist;
+            if (k_best->kth_dist_sq > left_dist_sq * prune_factor) {
+                search_node(left,
+                            query,
+                            query_features,
+                            prune_factor,
+                            scratch,
+                            k_best);
+            }
+        }
+    }
+
+    // Same as search_node(), for every query in active at once. Every query
+    // still visits the children in the same order, and rules them out on the
+    // same conditions, as it would in search_node(); only the searches of
+    // different queries are interleaved. So the results are the same.
+    void batch_search_node(
+            unsigned int node_index,
+            const std::vector<const double*>& queries,
+            const double* query_features,
+            const std::vector<unsigned int>& active,
+            double prune_factor,
+            kd_tree::LeafScratch* scratch,
+            std::vector<kd_tree::KBest<const kd_tree::FlatEntry>>* k_bests)
+            const {
+        const kd_tree::FlatNode& node = nodes[node_index];
+        if (node.s == -1) {
+            for (unsigned int q : active) {
+                search_leaf(node,
+                            queries[q],
+                            query_features + (size_t)q * num_features,
+                            scratch,
+                            &(*k_bests)[q]);
+            }
+            return;
+        }
+        std::vector<unsigned int> left_first;
+        std::vector<unsigned int> right_first;
+        for (unsigned int q : active) {
+            if (queries[q][node.s] < node.split_value) {
+                left_first.push_back(q);
+            } else {
+                right_first.push_back(q);
+            }
+        }
+        if (!left_first.empty()) {
+            batch_search_node(node.left_child,
+                              queries,
+                              query_features,
+                              left_first,
+                              prune_factor,
+                              scratch,
+                              k_bests);
+        }
+        // The right child is searched for every query which goes there first,
+        // and for those which went left first but can't yet rule it out. See
+        // InternalNode::search().
+        std::vector<unsigned int> right = right_first;
+        for (unsigned int q : left_first) {
+            double right_dist = node.min_right - queries[q][node.s];
+            double right_dist_sq = right_dist * right_dist;
+            if ((*k_bests)[q].kth_dist_sq > right_dist_sq * prune_factor) {
+                right.push_back(q);
+            }
+        }
+        if (!right.empty()) {
+            batch_search_node(node.left_child + 1,
+                              queries,
+                              query_features,
+                              right,
+                              prune_factor,
+                              scratch,
+                              k_bests);
+        }
+        std::vector<unsigned int> left_second;
+        for (unsigned int q : right_first) {
+            double left_dist = queries[q][node.s] - node.max_left;
+            double left_dist_sq = left_dist * left_dist;
+            if ((*k_bests)[q].kth_dist_sq > left_dist_sq * prune_factor) {
+                left_second.push_back(q);
+            }
+        }
+        if (!left_second.empty()) {
+            batch_search_node(node.left_child,
+                              queries,
+                              query_features,
+                              left_second,
+                              prune_factor,
+                              scratch,
+                              k_bests);
+        }
+    }
+
+    // Same as LeafNode::search(). The first four dimensions of the distance to
+    // every entry of the leaf are computed in one loop, which has no branches,
+    // so that it vectorizes. Most entries are already too far away after these,
+    // so only the rest, the survivors, go on to the other dimensions, where
+    // they are dropped as soon as they are too far away, like with the early
+    // return of LeafNode::consider(). Every distance is summed in the same
+    // order as in LeafNode::consider(), and the survivors are offered to k_best
+    // in the order of the entries, so the results are exactly the same. With
+    // a prefilter (see build_prefilter()), the first loop computes the lower
+    // bounds instead, and only the entries it can't rule out are survivors.
+    // Here query_features are the features of query, if there is a
+    // prefilter.
+    void search_leaf(const kd_tree::FlatNode& leaf,
+                     const double* query,
+                     const double* query_features,
+                     kd_tree::LeafScratch* scratch,
+                     kd_tree::KBest<const kd_tree::FlatEntry>* k_best) const {
+        unsigned int size = leaf.end - leaf.begin;
+        double kth_dist_sq = k_best->kth_dist_sq;
+        double* dists_sq = &scratch->dists_sq[0];
+        unsigned int* survivors = &scratch->survivors[0];
+        const double* block = &coordinates[(size_t)leaf.begin * d];
+        int j = 0;
+        unsigned int num_survivors = 0;
+        if (num_features > 0) {
+            // The lower bound of the distance to every entry of the leaf from
+            // the coarse features, one feature at a time, in a loop which
+            // vectorizes, and then from the rest of the features for the
+            // survivors only. See build_prefilter(). The bound is relaxed very
+            // slightly, so that rounding errors can never rule out an entry
+            // which would otherwise be kept. The survivors then start over
+            // from the first dimension, so their distances are still summed in
+            // the same order.
+            const double* feature_block =
+                    &features[(size_t)leaf.begin * num_features];
+            double cutoff = kth_dist_sq * (1.0 + 1e-9);
+            std::fill(dists_sq, dists_sq + size, 0.0);
+            for (int f = 0; f < num_coarse_features; f++) {
+                const double* c = &feature_block[(size_t)f * size];
+                double q = query_features[f];
+#pragma omp simd
+                for (unsigned int i = 0; i < size; i++) {
+                    double x = q - c[i];
+                    dists_sq[i] += x * x;
+                }
+            }
+            for (unsigned int i = 0; i < size; i++) {
+                if (dists_sq[i] < cutoff) {
+                    survivors[num_survivors] = i;
+                    dists_sq[num_survivors] = dists_sq[i];
+                    num_survivors++;
+                }
+            }
+            int f = num_coarse_features;
+            while (f < num_features && num_survivors > 0) {
+                int stop = std::min(num_features, f + 4);
+                unsigned int num_kept = 0;
+                for (unsigned int n = 0; n < num_survivors; n++) {
+                    unsigned int i = survivors[n];
+                    double bound_sq = dists_sq[n];
+                    for (int g = f; g < stop; g++) {
+                        double x = query_features[g]
+                                   - feature_block[(size_t)g * size + i];
+                        bound_sq += x * x;
+                    }
+                    if (bound_sq < cutoff) {
+                        survivors[num_kept] = i;
+                        dists_sq[num_kept] = bound_sq;
+                        num_kept++;
+                    }
+                }
+                num_survivors = num_kept;
+                f = stop;
+            }
+            std::fill(dists_sq, dists_sq + num_survivors, 0.0);
+        } else {
+            if (d >= 4) {
+                const double* c1 = &block[0];
+                const double* c2 = &block[size];
+                const double* c3 = &block[2 * size];
+                const double* c4 = &block[3 * size];
+                double q1 = query[0];
+                double q2 = query[1];
+                double q3 = query[2];
+                double q4 = query[3];
+#pragma omp simd
+                for (unsigned int i = 0; i < size; i++) {
+                    double x1 = q1 - c1[i];
+                    double x2 = q2 - c2[i];
+                    double x3 = q3 - c3[i];
+                    double x4 = q4 - c4[i];
+                    dists_sq[i] = x1 * x1 + x2 * x2 + x3 * x3 + x4 * x4;
+                }
+                j = 4;
+            } else {
+                std::fill(dists_sq, dists_sq + size, 0.0);
+            }
+            // The survivors and their partial distances are packed at the
+            // front of the scratch space. This can be done in place, as an
+            // entry can only ever move towards the front.
+            for (unsigned int i = 0; i < size; i++) {
+                if (dists_sq[i] < kth_dist_sq) {
+                    survivors[num_survivors] = i;
+                    dists_sq[num_survivors] = dists_sq[i];
+                    num_survivors++;
+                }
+            }
+        }
+        while (j < d - 3 && num_survivors > 0) {
+            const double* c1 = &block[j * size];
+            const double* c2 = &block[(j + 1) * size];
+            const double* c3 = &block[(j + 2) * size];
+            const double* c4 = &block[(j + 3) * size];
+            double q1 = query[j];
+            double q2 = query[j + 1];
+            double q3 = query[j + 2];
+            double q4 = query[j + 3];
+            unsigned int num_kept = 0;
+            for (unsigned int n = 0; n < num_survivors; n++) {
+                unsigned int i = survivors[n];
+                double x1 = q1 - c1[i];
+                double x2 = q2 - c2[i];
+                double x3 = q3 - c3[i];
+                double x4 = q4 - c4[i];
+                double dist_sq =
+                        dists_sq[n] + (x1 * x1 + x2 * x2 + x3 * x3 + x4 * x4);
+                if (dist_sq < kth_dist_sq) {
+                    survivors[num_kept] = i;
+                    dists_sq[num_kept] = dist_sq;
+                    num_kept++;
+                }
+            }
+            num_survivors = num_kept;
+            j += 4;
+        }
+        while (j < d) {
+            const double* c = &block[j * size];
+            double q = query[j];
+            for (unsigned int n = 0; n < num_survivors; n++) {
+                double x = q - c[survivors[n]];
+                dists_sq[n] += x * x;
+            }
+            j++;
+        }
+        for (unsigned int n = 0; n < num_survivors; n++) {
+            if (dists_sq[n] < k_best->kth_dist_sq) {
+                k_best->insert(dists_sq[n],
+                               &entries[leaf.begin + survivors[n]]);
+            }
+        }
+    }
+
+    void find_max_leaf_size() {
+        max_leaf_size = 0;
+        for (unsigned int i = 0; i < num_nodes; i++) {
+            if (nodes[i].s == -1) {
+                max_leaf_size =
+                        std::max(max_leaf_size, nodes[i].end - nodes[i].begin);
+            }
+        }
+    }
+
+    int d;
+    unsigned int num_nodes;
+    unsigned int num_entries;
+    unsigned int max_leaf_size;
+    const kd_tree::FlatNode* nodes;
+    // num_entries * d values. The coordinates of the leaf with entries
+    // [begin, end) start at begin * d, and coordinate j of entry begin + i of
+    // that leaf is at j * (end - begin) + i from there.
+    const double* coordinates;
+    const kd_tree::FlatEntry* entries;
+    // Storage for the above when the tree was flattened here, rather than
+    // viewed. Empty otherwise.
+    std::vector<kd_tree::FlatNode> owned_nodes;
+    std::vector<double> owned_coordinates;
+    std::vector<kd_tree::FlatEntry> owned_entries;
+    // The prefilter; see build_prefilter(). Without one, num_features is zero
+    // and the rest are empty. Feature f is the sum of coordinate
+    // feature_dims[x] times feature_weights[x], for x from feature_offsets[f]
+    // up to feature_offsets[f + 1]. The first num_coarse_features of them are
+    // computed for every entry of a leaf that is searched. The features of the
+    // leaf with entries [begin, end) start at begin * num_features, and are
+    // laid out like its coordinates.
+    int num_features;
+    int num_coarse_features;
+    std::vector<int> feature_offsets;
+    std::vector<int> feature_dims;
+    std::vector<double> feature_weights;
+    std::vector<double> features;
+};
+
+}  // namespace whatprot
+
+#endif  // KD_TREE_FLAT_KD_TREE_H
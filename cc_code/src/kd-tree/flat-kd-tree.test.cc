@@ -0,0 +1,385 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+
+// Boost unit test framework (recommended to be the first include):
+#include <boost/test/unit_test.hpp>
+
+// File under test:
+#include "flat-kd-tree.h"
+
+// Standard C++ library headers:
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+// Local project headers:
+#include "kd-tree/kd-tree.h"
+
+namespace whatprot {
+
+namespace {
+using std::move;
+using std::vector;
+
+// Class we can use as a template parameter for E.
+class FlatTestVec {
+public:
+    FlatTestVec(double x, double y, int hits) : v(2), hits(hits) {
+        v[0] = x;
+        v[1] = y;
+    }
+    double operator[](int d) const {
+        return v[d];
+    }
+    vector<double> v;
+    int hits;
+};
+
+// A 4x3 grid of points, all on integers, with varying hits.
+vector<FlatTestVec> grid() {
+    vector<FlatTestVec> vecs;
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 4; j++) {
+            vecs.push_back(FlatTestVec(i, j, 1 + (i + j) % 2));
+        }
+    }
+    return vecs;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(kd_tree_suite)
+BOOST_AUTO_TEST_SUITE(flat_kd_tree_suite)
+
+BOOST_AUTO_TEST_CASE(flatten_test) {
+    int k = 2;
+    int d = 2;
+    KDTree<FlatTestVec, vector<double>> kdt(k, d, grid());
+    FlatKDTree fkdt(kdt, d);
+    BOOST_TEST(fkdt.d == 2);
+    BOOST_TEST(fkdt.num_entries == 12u);
+    BOOST_TEST(fkdt.num_nodes == fkdt.owned_nodes.size());
+    BOOST_TEST(fkdt.nodes == &fkdt.owned_nodes[0]);
+    BOOST_TEST(fkdt.nodes[0].begin == 0u);
+    BOOST_TEST(fkdt.nodes[0].end == 12u);
+    BOOST_TEST(fkdt.nodes[0].s != -1);
+    // Breadth-first, so the children of the root come right after it, and
+    // together they cover the root.
+    BOOST_TEST(fkdt.nodes[0].left_child == 1u);
+    const kd_tree::FlatNode& left = fkdt.nodes[1];
+    const kd_tree::FlatNode& right = fkdt.nodes[2];
+    BOOST_TEST(left.begin == 0u);
+    BOOST_TEST(left.end == right.begin);
+    BOOST_TEST(right.end == 12u);
+    // Every node comes after its parent.
+    for (unsigned int i = 0; i < fkdt.num_nodes; i++) {
+        if (fkdt.nodes[i].s != -1) {
+            BOOST_TEST(fkdt.nodes[i].left_child > i);
+        }
+    }
+    // The coordinates of each leaf are together, one dimension at a time.
+    for (unsigned int n = 0; n < fkdt.num_nodes; n++) {
+        const kd_tree::FlatNode& leaf = fkdt.nodes[n];
+        if (leaf.s != -1) {
+            continue;
+        }
+        unsigned int size = leaf.end - leaf.begin;
+        const double* block = &fkdt.coordinates[leaf.begin * 2];
+        for (unsigned int i = 0; i < size; i++) {
+            BOOST_TEST(block[i] == kdt.values[leaf.begin + i][0]);
+            BOOST_TEST(block[size + i] == kdt.values[leaf.begin + i][1]);
+        }
+    }
+    for (unsigned int i = 0; i < 12; i++) {
+        BOOST_TEST(fkdt.entries[i].hits == kdt.values[i].hits);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(max_leaf_size_test) {
+    int k = 2;
+    int d = 2;
+    KDTree<FlatTestVec, vector<double>> kdt(k, d, grid());
+    FlatKDTree fkdt(kdt, d);
+    unsigned int max_leaf_size = 0;
+    unsigned int total_leaf_size = 0;
+    for (unsigned int i = 0; i < fkdt.num_nodes; i++) {
+        if (fkdt.nodes[i].s == -1) {
+            unsigned int size = fkdt.nodes[i].end - fkdt.nodes[i].begin;
+            max_leaf_size = std::max(max_leaf_size, size);
+            total_leaf_size += size;
+        }
+    }
+    BOOST_TEST(fkdt.max_leaf_size == max_leaf_size);
+    BOOST_TEST(total_leaf_size == 12u);
+}
+
+BOOST_AUTO_TEST_CASE(search_matches_kd_tree_high_dimension_test) {
+    // Enough dimensions to exercise both the four-at-a-time and the remainder
+    // loops of search_leaf().
+    int k = 3;
+    int d = 6;
+    vector<vector<double>> points;
+    for (int i = 0; i < 40; i++) {
+        vector<double> point(d);
+        for (int j = 0; j < d; j++) {
+            point[j] = (double)((i * (j + 3) + j * 7) % 11) / 3.0;
+        }
+        points.push_back(point);
+    }
+    vector<FlatTestVec> vecs;
+    for (int i = 0; i < 40; i++) {
+        FlatTestVec vec(0.0, 0.0, 1 + i % 3);
+        vec.v = points[i];
+        vecs.push_back(vec);
+    }
+    KDTree<FlatTestVec, vector<double>> kdt(k, d, move(vecs));
+    FlatKDTree fkdt(kdt, d);
+    for (int q = 0; q < 10; q++) {
+        vector<double> query(d);
+        for (int j = 0; j < d; j++) {
+            query[j] = (double)((q * 5 + j * 2) % 9) / 2.5;
+        }
+        vector<FlatTestVec*> k_nearest;
+        vector<double> dists_sq;
+        kdt.search(query, &k_nearest, &dists_sq);
+        vector<const kd_tree::FlatEntry*> flat_k_nearest;
+        vector<double> flat_dists_sq;
+        fkdt.search(query, k, 0.0, &flat_k_nearest, &flat_dists_sq);
+        BOOST_REQUIRE(flat_k_nearest.size() == k_nearest.size());
+        for (unsigned int i = 0; i < k_nearest.size(); i++) {
+            BOOST_TEST(fkdt.index(flat_k_nearest[i])
+                       == (unsigned int)(k_nearest[i] - &kdt.values[0]));
+            BOOST_TEST(flat_dists_sq[i] == dists_sq[i]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(search_matches_kd_tree_test) {
+    int k = 3;
+    int d = 2;
+    KDTree<FlatTestVec, vector<double>> kdt(k, d, grid());
+    FlatKDTree fkdt(kdt, d);
+    for (double x = -0.5; x < 3.0; x += 0.7) {
+        for (double y = -0.5; y < 4.0; y += 0.9) {
+            vector<double> query(2);
+            query[0] = x;
+            query[1] = y;
+            vector<FlatTestVec*> k_nearest;
+            vector<double> dists_sq;
+            kdt.search(query, &k_nearest, &dists_sq);
+            vector<const kd_tree::FlatEntry*> flat_k_nearest;
+            vector<double> flat_dists_sq;
+            fkdt.search(query, k, 0.0, &flat_k_nearest, &flat_dists_sq);
+            BOOST_REQUIRE(flat_k_nearest.size() == k_nearest.size());
+            for (unsigned int i = 0; i < k_nearest.size(); i++) {
+                BOOST_TEST(fkdt.index(flat_k_nearest[i])
+                           == (unsigned int)(k_nearest[i] - &kdt.values[0]));
+                BOOST_TEST(flat_dists_sq[i] == dists_sq[i]);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(search_batch_matches_search_test) {
+    int k = 3;
+    int d = 2;
+    KDTree<FlatTestVec, vector<double>> kdt(k, d, grid());
+    FlatKDTree fkdt(kdt, d);
+    vector<vector<double>> query_values;
+    for (double x = -0.5; x < 3.0; x += 0.7) {
+        for (double y = -0.5; y < 4.0; y += 0.9) {
+            vector<double> query(2);
+            query[0] = x;
+            query[1] = y;
+            query_values.push_back(query);
+        }
+    }
+    vector<const double*> queries;
+    for (unsigned int q = 0; q < query_values.size(); q++) {
+        queries.push_back(&query_values[q][0]);
+    }
+    vector<vector<const kd_tree::FlatEntry*>> batch_k_nearest;
+    vector<vector<double>> batch_dists_sq;
+    fkdt.search_batch(queries, k, 0.0, &batch_k_nearest, &batch_dists_sq);
+    BOOST_REQUIRE(batch_k_nearest.size() == queries.size());
+    BOOST_REQUIRE(batch_dists_sq.size() == queries.size());
+    for (unsigned int q = 0; q < queries.size(); q++) {
+        vector<const kd_tree::FlatEntry*> k_nearest;
+        vector<double> dists_sq;
+        fkdt.search(query_values[q], k, 0.0, &k_nearest, &dists_sq);
+        BOOST_REQUIRE(batch_k_nearest[q].size() == k_nearest.size());
+        for (unsigned int i = 0; i < k_nearest.size(); i++) {
+            BOOST_TEST(batch_k_nearest[q][i] == k_nearest[i]);
+            BOOST_TEST(batch_dists_sq[q][i] == dists_sq[i]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(approximate_search_test) {
+    int k = 4;
+    int d = 6;
+    double epsilon = 1.0;
+    vector<FlatTestVec> vecs;
+    for (int i = 0; i < 200; i++) {
+        FlatTestVec vec(0.0, 0.0, 1);
+        vec.v.resize(d);
+        for (int j = 0; j < d; j++) {
+            vec.v[j] = (double)((i * (2 * j + 3) + j * 5) % 17) / 4.0;
+        }
+        vecs.push_back(vec);
+    }
+    KDTree<FlatTestVec, vector<double>> kdt(k, d, move(vecs));
+    FlatKDTree fkdt(kdt, d);
+    vector<vector<double>> query_values;
+    for (int q = 0; q < 20; q++) {
+        vector<double> query(d);
+        for (int j = 0; j < d; j++) {
+            query[j] = (double)((q * 7 + j * 3) % 13) / 3.0;
+        }
+        query_values.push_back(query);
+    }
+    vector<const double*> queries;
+    for (unsigned int q = 0; q < query_values.size(); q++) {
+        queries.push_back(&query_values[q][0]);
+    }
+    vector<vector<const kd_tree::FlatEntry*>> batch_k_nearest;
+    vector<vector<double>> batch_dists_sq;
+    fkdt.search_batch(
+            queries, k, epsilon, &batch_k_nearest, &batch_dists_sq);
+    for (unsigned int q = 0; q < queries.size(); q++) {
+        vector<const kd_tree::FlatEntry*> exact_k_nearest;
+        vector<double> exact_dists_sq;
+        fkdt.search(
+                query_values[q], k, 0.0, &exact_k_nearest, &exact_dists_sq);
+        vector<const kd_tree::FlatEntry*> k_nearest;
+        vector<double> dists_sq;
+        fkdt.search(query_values[q], k, epsilon, &k_nearest, &dists_sq);
+        // Every neighbor is within (1 + epsilon) times the distance of the
+        // true k-th nearest, which is first.
+        BOOST_REQUIRE(k_nearest.size() == exact_k_nearest.size());
+        double bound_sq = (1.0 + epsilon) * (1.0 + epsilon) * exact_dists_sq[0];
+        for (unsigned int i = 0; i < k_nearest.size(); i++) {
+            BOOST_TEST(dists_sq[i] <= bound_sq);
+        }
+        // And a batch gives just the same approximation.
+        BOOST_REQUIRE(batch_k_nearest[q].size() == k_nearest.size());
+        for (unsigned int i = 0; i < k_nearest.size(); i++) {
+            BOOST_TEST(batch_k_nearest[q][i] == k_nearest[i]);
+            BOOST_TEST(batch_dists_sq[q][i] == dists_sq[i]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(prefilter_test) {
+    // Three channels of four timesteps, with enough levels to split every
+    // block down to single timesteps.
+    int k = 5;
+    int d = 12;
+    int num_channels = 3;
+    vector<FlatTestVec> vecs;
+    for (int i = 0; i < 300; i++) {
+        FlatTestVec vec(0.0, 0.0, 1 + i % 2);
+        vec.v.resize(d);
+        for (int j = 0; j < d; j++) {
+            vec.v[j] = (double)((i * (2 * j + 3) + j * 5) % 17) / 4.0;
+        }
+        vecs.push_back(vec);
+    }
+    KDTree<FlatTestVec, vector<double>> kdt(k, d, move(vecs));
+    FlatKDTree fkdt(kdt, d);
+    fkdt.build_prefilter(num_channels, 3);
+    // One feature for each channel, then one for each block of two or more
+    // timesteps split: four timesteps split once, then two blocks of two.
+    BOOST_TEST(fkdt.num_coarse_features == num_channels);
+    BOOST_TEST(fkdt.num_features == 4 * num_channels);
+    vector<vector<double>> query_values;
+    for (int q = 0; q < 20; q++) {
+        vector<double> query(d);
+        for (int j = 0; j < d; j++) {
+            query[j] = (double)((q * 7 + j * 3) % 13) / 3.0;
+        }
+        query_values.push_back(query);
+    }
+    vector<const double*> queries;
+    for (unsigned int q = 0; q < query_values.size(); q++) {
+        queries.push_back(&query_values[q][0]);
+    }
+    vector<vector<const kd_tree::FlatEntry*>> batch_k_nearest;
+    vector<vector<double>> batch_dists_sq;
+    fkdt.search_batch(queries, k, 0.0, &batch_k_nearest, &batch_dists_sq);
+    for (unsigned int q = 0; q < queries.size(); q++) {
+        // Exactly the same results as without the prefilter.
+        vector<FlatTestVec*> k_nearest;
+        vector<double> dists_sq;
+        kdt.search(query_values[q], &k_nearest, &dists_sq);
+        vector<const kd_tree::FlatEntry*> flat_k_nearest;
+        vector<double> flat_dists_sq;
+        fkdt.search(query_values[q], k, 0.0, &flat_k_nearest, &flat_dists_sq);
+        BOOST_REQUIRE(flat_k_nearest.size() == k_nearest.size());
+        BOOST_REQUIRE(batch_k_nearest[q].size() == k_nearest.size());
+        for (unsigned int i = 0; i < k_nearest.size(); i++) {
+            BOOST_TEST(fkdt.index(flat_k_nearest[i])
+                       == (unsigned int)(k_nearest[i] - &kdt.values[0]));
+            BOOST_TEST(flat_dists_sq[i] == dists_sq[i]);
+            BOOST_TEST(batch_k_nearest[q][i] == flat_k_nearest[i]);
+            BOOST_TEST(batch_dists_sq[q][i] == flat_dists_sq[i]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(descend_test) {
+    int k = 2;
+    int d = 2;
+    KDTree<FlatTestVec, vector<double>> kdt(k, d, grid());
+    FlatKDTree fkdt(kdt, d);
+    for (unsigned int i = 0; i < fkdt.num_entries; i++) {
+        // Every entry descends to the leaf holding it.
+        double query[2] = {kdt.values[i][0], kdt.values[i][1]};
+        unsigned int begin = fkdt.descend(query);
+        bool found = false;
+        for (unsigned int n = 0; n < fkdt.num_nodes; n++) {
+            if (fkdt.nodes[n].s == -1 && fkdt.nodes[n].begin == begin) {
+                found = true;
+                BOOST_TEST(i >= fkdt.nodes[n].begin);
+                BOOST_TEST(i < fkdt.nodes[n].end);
+            }
+        }
+        BOOST_TEST(found);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(view_constructor_test) {
+    int k = 2;
+    int d = 2;
+    KDTree<FlatTestVec, vector<double>> kdt(k, d, grid());
+    FlatKDTree fkdt(kdt, d);
+    FlatKDTree view(fkdt.d,
+                    fkdt.num_nodes,
+                    fkdt.num_entries,
+                    fkdt.nodes,
+                    fkdt.coordinates,
+                    fkdt.entries);
+    BOOST_TEST(view.owned_nodes.empty());
+    BOOST_TEST(view.max_leaf_size == fkdt.max_leaf_size);
+    vector<double> query(2);
+    query[0] = 0.9;
+    query[1] = 0.8;
+    vector<const kd_tree::FlatEntry*> k_nearest;
+    vector<double> dists_sq;
+    view.search(query, k, 0.0, &k_nearest, &dists_sq);
+    BOOST_REQUIRE(k_nearest.size() > 0u);
+    // The nearest point is (1, 1), which is always last.
+    unsigned int nearest = view.index(k_nearest.back());
+    BOOST_TEST(kdt.values[nearest][0] == 1.0);
+    BOOST_TEST(kdt.values[nearest][1] == 1.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // flat_kd_tree_suite
+BOOST_AUTO_TEST_SUITE_END()  // kd_tree_suite
+
+}  // namespace whatprot
@@ -10,52 +10,106 @@
 #define KD_TREE_K_BEST_H
 
 // Standard C++ library headers:
+#include <algorithm>
 #include <cfloat>
-#include <queue>
 #include <utility>
 #include <vector>
 
 namespace whatprot {
 namespace kd_tree {
 
+// Keeps the nearest entries seen so far, where an entry with more than one hit
+// counts that many times towards k. The entries are kept in a max-heap in a
+// buffer which is allocated once. If every entry has at least one hit, there
+// are never more than k entries, plus one for a moment during insert(), so the
+// buffer never grows. A KBest can be reset() and used again for another query
+// without any more allocation.
 template <typename E>
 class KBest {
 public:
-    KBest(int k) : k(k), hits(0), kth_dist_sq(DBL_MAX) {}
+    KBest(int k) : k(k), hits(0), kth_dist_sq(DBL_MAX) {
+        heap.reserve(k + 1);
+    }
+
+    // Make this empty again, and able to hold k hits.
+    void reset(int k) {
+        this->k = k;
+        hits = 0;
+        kth_dist_sq = DBL_MAX;
+        heap.clear();
+        heap.reserve(k + 1);
+    }
 
     virtual void insert(double d, E* entry) {
+        std::pair<double, E*> item(d, entry);
         hits += entry->hits;
-        pq.push(std::pair<double, E*>(d, entry));
-        // Here we pop the top element of pq if removing it still allows us to
-        // have a hits larger than k.
-        int top_hits = pq.top().second->hits;
-        if (hits - top_hits >= k) {
-            hits -= top_hits;
-            pq.pop();
+        // The top element of the heap is dropped if removing it still allows
+        // us to have a hits larger than k. If the new element would go on top,
+        // then it would be dropped at once, so it is never added. Otherwise,
+        // if the old top is dropped, the new element takes its place.
+        if (heap.empty() || heap.front() < item) {
+            if (hits - entry->hits >= k) {
+                hits -= entry->hits;
+            } else {
+                heap.push_back(item);
+                std::push_heap(heap.begin(), heap.end());
+            }
+        } else if (hits - heap.front().second->hits >= k) {
+            hits -= heap.front().second->hits;
+            replace_top(item);
+        } else {
+            heap.push_back(item);
+            std::push_heap(heap.begin(), heap.end());
         }
         // We only want to reset kth_dist_sq if we have enough elements. This
         // ensures that the kth_dist_sq remains DBL_MAX so that everything tried
         // will be added until there are enough elements.
         if (hits >= k) {
-            kth_dist_sq = pq.top().first;
+            kth_dist_sq = heap.front().first;
         }
     }
 
+    // Appends the entries to k_nearest, and their distances to dists_sq, from
+    // farthest to nearest, and leaves this empty. Nothing is allocated if the
+    // vectors already have room.
     virtual void fill(std::vector<E*>* k_nearest,
                       std::vector<double>* dists_sq) {
-        k_nearest->reserve(pq.size());
-        dists_sq->reserve(pq.size());
-        while (!pq.empty()) {
-            dists_sq->push_back(pq.top().first);
-            k_nearest->push_back(pq.top().second);
-            pq.pop();
+        std::sort_heap(heap.begin(), heap.end());
+        k_nearest->reserve(k_nearest->size() + heap.size());
+        dists_sq->reserve(dists_sq->size() + heap.size());
+        for (unsigned int i = heap.size(); i > 0; i--) {
+            dists_sq->push_back(heap[i - 1].first);
+            k_nearest->push_back(heap[i - 1].second);
+        }
+        heap.clear();
+    }
+
+    // Put item in place of the top of the heap, and sift it down to where it
+    // belongs.
+    void replace_top(const std::pair<double, E*>& item) {
+        unsigned int size = heap.size();
+        unsigned int i = 0;
+        while (true) {
+            unsigned int child = 2 * i + 1;
+            if (child >= size) {
+                break;
+            }
+            if (child + 1 < size && heap[child] < heap[child + 1]) {
+                child++;
+            }
+            if (!(item < heap[child])) {
+                break;
+            }
+            heap[i] = heap[child];
+            i = child;
         }
+        heap[i] = item;
     }
 
     int k;
     int hits;
     double kth_dist_sq;
-    std::priority_queue<std::pair<double, E*>> pq;
+    std::vector<std::pair<double, E*>> heap;
 };
 
 }  // namespace kd_tree
@@ -185,6 +185,48 @@ BOOST_AUTO_TEST_CASE(over_capacity_hits_gt1_test, *tolerance(TOL)) {
     BOOST_TEST(dists_sq[1] == 1.0);
 }
 
+BOOST_AUTO_TEST_CASE(reset_test, *tolerance(TOL)) {
+    KBest<Str> kb(2);
+    Str s_one("one point zero");
+    kb.insert(1.0, &s_one);
+    Str s_two("two point zero");
+    kb.insert(2.0, &s_two);
+    kb.reset(3);
+    BOOST_TEST(kb.k == 3);
+    BOOST_TEST(kb.kth_dist_sq == DBL_MAX);
+    BOOST_TEST(kb.hits == 0);
+    Str s_three("three point zero");
+    kb.insert(3.0, &s_three);
+    vector<Str*> v;
+    vector<double> dists_sq;
+    kb.fill(&v, &dists_sq);
+    BOOST_REQUIRE(v.size() == 1);
+    BOOST_TEST(v[0]->s == "three point zero");
+    BOOST_TEST(dists_sq[0] == 3.0);
+}
+
+BOOST_AUTO_TEST_CASE(no_growth_test, *tolerance(TOL)) {
+    KBest<Str> kb(3);
+    unsigned int capacity = kb.heap.capacity();
+    vector<Str> strs;
+    for (int i = 0; i < 20; i++) {
+        strs.push_back(Str("", 1 + i % 2));
+    }
+    for (int i = 0; i < 20; i++) {
+        kb.insert((double)((i * 7) % 20), &strs[i]);
+    }
+    BOOST_TEST(kb.heap.capacity() == capacity);
+    vector<Str*> v;
+    vector<double> dists_sq;
+    kb.fill(&v, &dists_sq);
+    BOOST_TEST(kb.heap.capacity() == capacity);
+    BOOST_REQUIRE(v.size() > 0u);
+    for (unsigned int i = 1; i < v.size(); i++) {
+        BOOST_TEST(dists_sq[i - 1] > dists_sq[i]);
+    }
+    BOOST_TEST(dists_sq.back() == 0.0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()  // k_best_suite
 BOOST_AUTO_TEST_SUITE_END()  // kd_tree_suite
 
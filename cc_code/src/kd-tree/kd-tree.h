@@ -40,11 +40,17 @@ public:
     //   3. v - a vector of E typed elements, which must give a valid response
     //      when called with the operator[] function for any element in the
     //      range [0, d).
-    KDTree(int k, int d, std::vector<E>&& v)
+    // Each leaf of the tree then holds at least k entries.
+    KDTree(int k, int d, std::vector<E>&& v) : KDTree(k, d, k, std::move(v)) {}
+
+    // Same as above, except that each leaf holds at least leaf_size entries
+    // instead. Smaller leaves mean fewer distances to compute, but more nodes
+    // to visit.
+    KDTree(int k, int d, int leaf_size, std::vector<E>&& v)
             : k(k),
               values(std::move(v)),
               root(kd_tree::make_node<E, Q>(
-                      k, d, &values[0], &values[values.size()])) {}
+                      leaf_size, d, &values[0], &values[values.size()])) {}
 
     ~KDTree() {
         delete root;
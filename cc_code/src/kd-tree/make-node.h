@@ -12,6 +12,7 @@
 // Standard C++ library headers:
 #include <algorithm>
 #include <cfloat>
+#include <cstddef>
 #include <functional>
 #include <vector>
 
@@ -24,19 +25,67 @@
 namespace whatprot {
 namespace kd_tree {
 
+// Ranges of at least this many entries are worth the overhead of an OpenMP
+// task. Below this, the whole subtree is built by one thread.
+const std::size_t TASK_CUTOFF = 1 << 15;
+
+// Sets mins and maxes (each of size d) to the minimum and maximum of each
+// dimension over [begin, end). A large range is split into chunks, each scanned
+// by its own OpenMP task. This must be called from within a parallel region to
+// actually run in parallel (see make_node()).
+template <typename E>
+void find_bounds(int d,
+                 E* begin,
+                 E* end,
+                 std::vector<double>* mins,
+                 std::vector<double>* maxes) {
+    std::size_t size = end - begin;
+    std::size_t num_chunks = (size + TASK_CUTOFF - 1) / TASK_CUTOFF;
+    if (num_chunks <= 1) {
+        for (E* entry = begin; entry < end; entry++) {
+            for (int i = 0; i < d; i++) {
+                (*mins)[i] = std::min((*mins)[i], (*entry)[i]);
+                (*maxes)[i] = std::max((*maxes)[i], (*entry)[i]);
+            }
+        }
+        return;
+    }
+    std::vector<std::vector<double>> chunk_mins(
+            num_chunks, std::vector<double>(d, DBL_MAX));
+    std::vector<std::vector<double>> chunk_maxes(
+            num_chunks, std::vector<double>(d, DBL_MIN));
+    for (std::size_t c = 0; c < num_chunks; c++) {
+#pragma omp task shared(chunk_mins, chunk_maxes)
+        {
+            E* chunk_begin = begin + c * TASK_CUTOFF;
+            E* chunk_end = std::min(chunk_begin + TASK_CUTOFF, end);
+            find_bounds(d,
+                        chunk_begin,
+                        chunk_end,
+                        &chunk_mins[c],
+                        &chunk_maxes[c]);
+        }
+    }
+#pragma omp taskwait
+    // The minimum and maximum don't depend on the order they are taken in, so
+    // this is exactly the same as a scan by one thread.
+    for (std::size_t c = 0; c < num_chunks; c++) {
+        for (int i = 0; i < d; i++) {
+            (*mins)[i] = std::min((*mins)[i], chunk_mins[c][i]);
+            (*maxes)[i] = std::max((*maxes)[i], chunk_maxes[c][i]);
+        }
+    }
+}
+
+// Does the work of make_node(), which must have set up the parallel region.
 template <typename E, typename Q>
-Node<E, Q>* make_node(int k, int d, E* begin, E* end) {
+Node<E, Q>* make_node_task(int leaf_size, int d, E* begin, E* end) {
     // We want to split on the dimension with the biggest range. To do that, we
     // find the minimums and maximums of every dimension, which we can later use
     // to find the range of every dimension and take the max.
     std::vector<double> mins(d, DBL_MAX);
     std::vector<double> maxes(d, DBL_MIN);
-    for (E* entry = begin; entry < end; entry++) {
-        for (int i = 0; i < d; i++) {
-            mins[i] = std::min(mins[i], (*entry)[i]);
-            maxes[i] = std::max(maxes[i], (*entry)[i]);
-        }
-    }
+    find_bounds(d, begin, end, &mins, &maxes);
     // Take largest range, computing using mins and maxes.
     double best_range = -1.0;
     int s = -1;  // s is the split_dim
@@ -61,24 +110,49 @@ Node<E, Q>* make_node(int k, int d, E* begin, E* end) {
     // points:
     //   * "end" always signifies one PAST the last element, therefore the end
     //     for the left node is the same as begin for the right node.
-    //   * We don't want any children smaller than k. We plan to search for k
-    //     nearest neighbors, therefore we waste time with reference hops to
-    //     deal with any leaf that has less than k values. If either child of
-    //     the new node would be too small, we can just make a leaf instead.
+    //   * We don't want any children smaller than leaf_size. If either child
+    //     of the new node would be too small, we can just make a leaf instead.
     int left_size = (int)(nth - begin);
     int right_size = (int)(end - nth);
-    if (left_size < k || right_size < k) {
+    if (left_size < leaf_size || right_size < leaf_size) {
         return new LeafNode<E, Q>(d, begin, end);
     } else {
         double max_left = max_element(begin, nth, s);
         double min_right = min_element(nth, end, s);
-        Node<E, Q>* left_child = make_node<E, Q>(k, d, begin, nth);
-        Node<E, Q>* right_child = make_node<E, Q>(k, d, nth, end);
+        // The two children own disjoint ranges of entries, so they can be
+        // built at the same time. Each subtree comes out exactly the same as
+        // if it were built by one thread.
+        Node<E, Q>* left_child;
+        Node<E, Q>* right_child;
+        if ((std::size_t)(end - begin) >= TASK_CUTOFF) {
+#pragma omp task shared(left_child)
+            left_child = make_node_task<E, Q>(leaf_size, d, begin, nth);
+            right_child = make_node_task<E, Q>(leaf_size, d, nth, end);
+#pragma omp taskwait
+        } else {
+            left_child = make_node_task<E, Q>(leaf_size, d, begin, nth);
+            right_child = make_node_task<E, Q>(leaf_size, d, nth, end);
+        }
         return new InternalNode<E, Q>(
                 left_child, right_child, max_left, min_right, s);
     }
 }
 
+// Builds a KD-tree over [begin, end), reordering the entries so that every
+// leaf holds a contiguous range of them. No node is split if either of its
+// children would have fewer than leaf_size entries, so every leaf has at least
+// leaf_size entries (unless there are fewer entries than that in total). The
+// upper levels of the tree are built in parallel with OpenMP tasks, with the
+// same result as a build on one thread.
+template <typename E, typename Q>
+Node<E, Q>* make_node(int leaf_size, int d, E* begin, E* end) {
+    Node<E, Q>* root;
+#pragma omp parallel
+#pragma omp single
+    root = make_node_task<E, Q>(leaf_size, d, begin, end);
+    return root;
+}
+
 }  // namespace kd_tree
 }  // namespace whatprot
 
@@ -17,6 +17,9 @@
 #include <typeinfo>
 #include <vector>
 
+// OpenMP
+#include <omp.h>
+
 // Local project headers:
 #include "kd-tree/internal-node.h"
 #include "kd-tree/leaf-node.h"
@@ -50,6 +53,25 @@ public:
     int hits;
 };
 
+// Checks that every leaf under node has at least leaf_size entries, and adds up
+// the number of entries in the leaves.
+void check_leaves(const Node<Vec, vector<double>>* node,
+                  int leaf_size,
+                  int* total) {
+    const LeafNode<Vec, vector<double>>* leaf_node =
+            dynamic_cast<const LeafNode<Vec, vector<double>>*>(node);
+    if (leaf_node != NULL) {
+        BOOST_TEST(leaf_node->end - leaf_node->begin >= leaf_size);
+        *total += leaf_node->end - leaf_node->begin;
+        return;
+    }
+    const InternalNode<Vec, vector<double>>* internal_node =
+            dynamic_cast<const InternalNode<Vec, vector<double>>*>(node);
+    BOOST_REQUIRE(internal_node != NULL);
+    check_leaves(internal_node->left_child, leaf_size, total);
+    check_leaves(internal_node->right_child, leaf_size, total);
+}
+
 BOOST_AUTO_TEST_SUITE(kd_tree_suite)
 BOOST_AUTO_TEST_SUITE(internal_node_suite)
 
@@ -210,6 +232,40 @@ BOOST_AUTO_TEST_CASE(internal_node_reordering_test, *tolerance(TOL)) {
     delete node;
 }
 
+BOOST_AUTO_TEST_CASE(parallel_test, *tolerance(TOL)) {
+    int leaf_size = 50;
+    int d = 3;
+    // Big enough that the upper levels are built by separate tasks.
+    int size = 3 * TASK_CUTOFF + 123;
+    vector<Vec> vecs(size, Vec(vector<double>(3, 0)));
+    for (int i = 0; i < size; i++) {
+        vecs[i][0] = (double)((i * 7919) % 1009);
+        vecs[i][1] = (double)((i * 104729) % 2003) / 2.0;
+        vecs[i][2] = (double)(i % 17);
+    }
+    vector<Vec> serial_vecs = vecs;
+    int max_threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    Node<Vec, vector<double>>* serial_node = make_node<Vec, vector<double>>(
+            leaf_size, d, &serial_vecs[0], &serial_vecs[0] + size);
+    omp_set_num_threads(max_threads);
+    Node<Vec, vector<double>>* node = make_node<Vec, vector<double>>(
+            leaf_size, d, &vecs[0], &vecs[0] + size);
+    int total = 0;
+    check_leaves(node, leaf_size, &total);
+    BOOST_TEST(total == size);
+    // Each task only reorders its own range of entries, and splits it the
+    // same way whichever thread runs it, so the entries end up in the same
+    // order as when one thread builds the whole tree.
+    bool same = true;
+    for (int i = 0; i < size; i++) {
+        same = same && (vecs[i] == serial_vecs[i]);
+    }
+    BOOST_TEST(same);
+    delete node;
+    delete serial_node;
+}
+
 BOOST_AUTO_TEST_SUITE_END()  // internal_node_suite
 BOOST_AUTO_TEST_SUITE_END()  // kd_tree_suite
 
@@ -35,6 +35,11 @@ void print_built_classifier(double time) {
     cout << "Built classifier (" << time << " seconds).\n";
 }
 
+void print_built_kd_tree_index(int num, double time) {
+    cout << "Built KD-tree index of " << num << " dye tracks (" << time
+         << " seconds).\n";
+}
+
 void print_final_step_size(double step_size) {
     cout << "Final step-size: " << step_size << " (under inf-norm)\n";
 }
@@ -52,6 +57,11 @@ void print_finished_deduping_dye_tracks(int num, double time) {
          << "seconds).\n";
 }
 
+void print_finished_enumerating_dye_tracks(int num, double time) {
+    cout << "Finished enumerating " << num << " unique dye tracks (" << time
+         << "seconds).\n";
+}
+
 void print_finished_generating_dye_tracks(int num, double time) {
     int total_num = num;
     cout << "Finished generating " << total_num << " dye tracks (" << time
@@ -72,6 +82,16 @@ void print_finished_saving_results(double time) {
     cout << "Finished saving results (" << time << " seconds).\n";
 }
 
+void print_finished_streaming_classification(int num, double time) {
+    cout << "Finished reading, classifying, and saving " << num
+         << " radiometries (" << time << " seconds).\n";
+}
+
+void print_finished_streaming_simulation(int num, double time) {
+    cout << "Finished generating and saving " << num << " radiometries ("
+         << time << " seconds).\n";
+}
+
 void print_invalid_classifier() {
     cout << "Invalid classifier. Second argument must be 'hmm', 'nn', or "
          << "'hybrid'.\n";
@@ -101,10 +121,19 @@ void print_read_dye_tracks(int num, double time) {
     cout << "Read " << num << " dye tracks (" << time << " seconds).\n";
 }
 
+void print_read_kd_tree_index(int num, double time) {
+    cout << "Read KD-tree index of " << num << " dye tracks (" << time
+         << " seconds).\n";
+}
+
 void print_read_radiometries(int num, double time) {
     cout << "Read " << num << " radiometries (" << time << " seconds).\n";
 }
 
+void print_seed(unsigned int seed) {
+    cout << "Using random seed " << seed << ".\n";
+}
+
 void print_total_time(double time) {
     cout << "Total run time: " << time << " seconds.\n";
 }
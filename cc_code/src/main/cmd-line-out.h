@@ -16,21 +16,28 @@ namespace whatprot {
 
 void print_bad_inputs();
 void print_built_classifier(double time);
+void print_built_kd_tree_index(int num, double time);
 void print_final_step_size(double step_size);
 void print_finished_basic_setup(double time);
 void print_finished_classification(double time);
 void print_finished_deduping_dye_tracks(int num, double time);
+void print_finished_enumerating_dye_tracks(int num, double time);
 void print_finished_generating_dye_tracks(int num, double time);
 void print_finished_generating_radiometries(int num, double time);
 void print_finished_parameter_fitting(double time);
 void print_finished_saving_results(double time);
+void print_finished_streaming_classification(int num, double time);
+
+void print_finished_streaming_simulation(int num, double time);
 void print_invalid_classifier();
 void print_invalid_command();
 void print_omp_info();
 void print_parameter_results(const SequencingModel& seq_model, double log_l);
 void print_read_dye_seqs(int num, double time);
 void print_read_dye_tracks(int num, double time);
+void print_read_kd_tree_index(int num, double time);
 void print_read_radiometries(int num, double time);
+void print_seed(unsigned int seed);
 void print_total_time(double time);
 void print_wrong_number_of_inputs();
 
@@ -18,12 +18,14 @@
 
 // Local project headers:
 #include "main/cmd-line-out.h"
+#include "main/run-build-index.h"
 #include "main/run-classify-hmm.h"
 #include "main/run-classify-hybrid.h"
 #include "main/run-classify-nn.h"
 #include "main/run-fit.h"
 #include "main/run-simulate-dt.h"
 #include "main/run-simulate-rad.h"
+#include "util/time.h"
 
 namespace {
 using cxxopts::Options;
@@ -38,12 +40,14 @@ using std::vector;
 using whatprot::print_bad_inputs;
 using whatprot::print_invalid_command;
 using whatprot::print_omp_info;
+using whatprot::run_build_index;
 using whatprot::run_classify_hmm;
 using whatprot::run_classify_hybrid;
 using whatprot::run_classify_nn;
 using whatprot::run_fit;
 using whatprot::run_simulate_dt;
 using whatprot::run_simulate_rad;
+using whatprot::time_based_seed;
 }  // namespace
 
 int main(int argc, char** argv) {
@@ -65,6 +69,16 @@ int main(int argc, char** argv) {
     // clang-format off
     options.add_options()
         ("h,help", "Print usage\n")
+        ("a,nnepsilon",
+            "Only for nn or hybrid classification, and NOT required. If "
+            "greater than zero, the nearest neighbor search is approximate: "
+            "part of the KD-tree is skipped unless it could hold a neighbor "
+            "more than (1 + nnepsilon) times closer than the farthest of the "
+            "neighbors found so far. This is much faster, and the neighbors "
+            "found are all within (1 + nnepsilon) times the distance of the "
+            "true farthest neighbor. Must not be negative. Defaults to 0 "
+            "(exact search).\n",
+            value<double>())
         ("b,numbootstrap",
             "Only for parameter fitting, and optional. If specified, indicates "
             "number of bootstrapping rounds to perform to get confidence "
@@ -76,6 +90,22 @@ int main(int argc, char** argv) {
             "the desired confidence interval size. If specified you must also "
             "specify --numbootstrap (shorthand -b).\n",
             value<double>())
+        ("d,dtformat",
+            "Only for simulate dt, and NOT required. Format to write the "
+            "dye-tracks in. One of tsv (tab-separated text) or bin (binary). "
+            "The binary format is much faster to read, and can be given to "
+            "classification in place of the text format. Defaults to tsv.\n",
+            value<string>())
+        ("e,hmmepsilon",
+            "Only for hmm or hybrid classification, and NOT required. If "
+            "greater than zero, the HMM for a candidate peptide is abandoned "
+            "part way through once it can be shown that the peptide cannot "
+            "be the best match, and would add less than this fraction of the "
+            "best match's score to the total score. This is faster, at the "
+            "cost of slightly overestimating the confidence of each "
+            "classification. Must be between 0 and 1. Defaults to 0 (no "
+            "early termination).\n",
+            value<double>())
         ("g,numgenerate",
             "Only for simulation, and required. Number of dye-tracks or "
             "radiometries to generate. For simulate rad, this is the actual "
@@ -85,16 +115,46 @@ int main(int argc, char** argv) {
             "a real run due to failure to attach functioning fluorophores "
             "prior to sequencing, the result is omitted in the output file.\n",
             value<int>())
+        ("i,nnindex",
+            "Only for nn or hybrid classification with --dyetracks, and NOT "
+            "required. Kind of index to search for nearest neighbors in. One "
+            "of kd (a KD-tree) or ball (a ball tree). A ball tree can prune "
+            "more of the search when there are many timesteps and channels. "
+            "Defaults to kd.\n",
+            value<string>())
         ("k,neighbors",
             "Only for nn or hybrid classification, and required. Number of "
             "neighbors to use for kNN classification\n",
             value<int>())
+        ("l,leafsize",
+            "Only for nn or hybrid classification with --dyetracks, or for "
+            "build-index, and NOT required. Minimum number of dye-tracks in "
+            "each leaf of the KD-tree. Smaller leaves mean fewer distances to "
+            "compute in each search, but more of the tree to walk. Defaults "
+            "to --neighbors.\n",
+            value<int>())
+        ("n,enumerate",
+            "Only for simulate dt, and NOT required. Takes no value. If "
+            "given, the dye-tracks are not sampled. Instead every dye-track "
+            "which --numgenerate samples per peptide would be expected to give "
+            "at least once is found, along with the number of times it would "
+            "be expected, which is written as its hits. This is more accurate "
+            "for rare dye-tracks, and much faster for large values of "
+            "--numgenerate. The result does not depend on --seed.\n")
         ("p,hmmprune",
             "Only for hmm or hybrid classification, and NOT required. Defines "
             "a multiplier on sigma to use when pruning an HMM for greater "
             "efficiency. Higher values imply less pruning. Defaults to "
             "infinity.\n",
             value<double>())
+        ("r,radformat",
+            "Only for simulate rad, and NOT required. Format to write the "
+            "radiometries in. One of tsv (tab-separated text), bin64 (binary "
+            "with double precision intensities), or bin32 (binary with single "
+            "precision intensities). The binary formats are much faster to "
+            "read, and can be given to classification in place of the text "
+            "format. Defaults to tsv.\n",
+            value<string>())
         ("s,sigma",
             "Only for nn or hybrid classification, and required. Sigma to use "
             "for the Gaussian kernel used to weight votes in kNN "
@@ -114,6 +174,32 @@ int main(int argc, char** argv) {
             "a fluorophore on channel 0 at position 3 and on channel 1 at "
             "position 5.\n",
             value<string>())
+        ("z,seed",
+            "Only for simulation, and NOT required. Seed for the random "
+            "numbers. Simulating again with the same seed and the same inputs "
+            "gives exactly the same results, no matter how many threads are "
+            "used. Defaults to a seed based on the time, which is printed so "
+            "that the run can be repeated.\n",
+            value<unsigned int>())
+        ("B,hmmbatch",
+            "Only for hmm classification, and NOT required. Number of "
+            "radiometries to run through each HMM at the same time. Larger "
+            "values reuse more work between radiometries, but need more "
+            "memory. Defaults to 1 (no batching).\n",
+            value<int>())
+        ("C,streamchunk",
+            "Only for classification, and NOT required. If given, the "
+            "radiometries are read, classified, and written this many at a "
+            "time, with the reading and writing overlapped with the "
+            "classification. This bounds the memory needed for very large "
+            "radiometry files. Defaults to reading the whole file at once.\n",
+            value<int>())
+        ("E,fastexp",
+            "Only for hmm or hybrid classification, and NOT required. Takes "
+            "no value. If given, a fast approximation of the exponential "
+            "function is used when computing emission probabilities. This "
+            "changes the scores very slightly, in exchange for faster "
+            "throughput.\n")
         ("F,fitsettings",
             "Only for fit, and NOT required. Provides json file in "
             "standardized format with options related to parameter fitting. In "
@@ -125,6 +211,15 @@ int main(int argc, char** argv) {
             "Only for hybrid classification, and required. Number of peptide "
             "candidates to pass through from kNN to HMM.\n",
             value<int>())
+        ("I,kdtreeindex",
+            "For build-index, required, and then it is the name of the file "
+            "to write the KD-tree index to. For nn or hybrid classification, "
+            "NOT required, and then it is the name of a KD-tree index to use "
+            "in place of --dyetracks, which saves rebuilding the KD-tree on "
+            "every run. The index must have been built with the same "
+            "--seqparams, which is checked; the --neighbors it was built with "
+            "only affects speed.\n",
+            value<string>())
         ("L,stoppingthreshold",
             "Only for fit, and required. Threshold of change in the norm to "
             "stop the fitting iteration.\n",
@@ -161,9 +256,11 @@ int main(int argc, char** argv) {
             "to read dye-seqs from.\n",
             value<string>())
         ("T,dyetracks",
-            "Only for nn or hybrid classification, or dt simulation, and "
-            "required. Name of file to read dye-tracks from (classification) "
-            "or name of file to write them to (dt simulation).\n",
+            "Only for nn or hybrid classification, dt simulation, or "
+            "build-index, and required (except that nn or hybrid "
+            "classification may use --kdtreeindex instead). Name of file to "
+            "read dye-tracks from (classification and build-index) or name "
+            "of file to write them to (dt simulation).\n",
             value<string>())
         ("Y,results",
             "Required for classify and simulate rad. Then it is the name of "
@@ -177,8 +274,8 @@ int main(int argc, char** argv) {
     // Generic text for options, declaring when to use each option.
     options.custom_help(
             "[MODE] [VARIANT] [OPTS...]\n\n"
-            "  MODE is one of classify, fit, or simulate. Other parameter\n"
-            "  requirements depend on these.\n"
+            "  MODE is one of classify, fit, simulate, or build-index. Other\n"
+            "  parameter requirements depend on these.\n"
             "  \n"
             "  For MODE classify, you must define a VARIANT as one of hmm,\n"
             "  hybrid, or nn. Your data will then be classified using the\n"
@@ -186,16 +283,22 @@ int main(int argc, char** argv) {
             "  specific parameters.\n"
             "  \n"
             "    For VARIANT hmm, you must define --seqparams, --dyeseqs,\n"
-            "    --radiometries, and --results. Option --hmmprune is also\n"
-            "    permitted.\n"
+            "    --radiometries, and --results. Options --hmmprune,\n"
+            "    --hmmepsilon, --hmmbatch, --fastexp, and --streamchunk are\n"
+            "    also permitted.\n"
             "    \n"
             "    For VARIANT hybrid, you must define --seqparams,\n"
-            "    --neighbors, --sigma, --passthrough, --dyeseqs, --dyetracks,\n"
-            "    --radiometries, and --results. Option --hmmprune is also\n"
-            "    permitted.\n"
+            "    --neighbors, --sigma, --passthrough, --dyeseqs, either\n"
+            "    --dyetracks or --kdtreeindex, --radiometries, and --results.\n"
+            "    Options --nnepsilon, --hmmprune, --hmmepsilon, --fastexp,\n"
+            "    and --streamchunk are also permitted, as are --nnindex and\n"
+            "    --leafsize with --dyetracks.\n"
             "    \n"
             "    For VARIANT nn, you must define --seqparams, --neighbors,\n"
-            "    --sigma, --dyetracks, --radiometries, and --results.\n"
+            "    --sigma, either --dyetracks or --kdtreeindex,\n"
+            "    --radiometries, and --results. Options --nnepsilon and\n"
+            "    --streamchunk are also permitted, as are --nnindex and\n"
+            "    --leafsize with --dyetracks.\n"
             "    \n"
             "  For MODE fit, you must NOT define a VARIANT, and you MUST\n"
             "  define --seqparams, --stoppingthreshold, --dyeseqstring, and\n"
@@ -212,10 +315,19 @@ int main(int argc, char** argv) {
             "  possibilities require specific parameters.\n"
             "  \n"
             "    For VARIANT dt, you must define --seqparams, --timesteps,\n"
-            "    --numgenerate, --dyeseqs, and --dyetracks.\n"
+            "    --numgenerate, --dyeseqs, and --dyetracks. Options\n"
+            "    --dtformat, --enumerate, and --seed are also permitted.\n"
             "    \n"
             "    For VARIANT rad, you must define --seqparams, --timesteps,\n"
-            "    --numgenerate, --dyeseqs, --radiometries, and --results\n"
+            "    --numgenerate, --dyeseqs, --radiometries, and --results.\n"
+            "    Options --radformat and --seed are also permitted.\n"
+            "    \n"
+            "  For MODE build-index, you must NOT define a VARIANT, and you\n"
+            "  MUST define --seqparams, --neighbors, --dyetracks, and\n"
+            "  --kdtreeindex. The KD-tree for nn and hybrid classification is\n"
+            "  built from the dye-tracks and saved, to be given to later\n"
+            "  classification runs with --kdtreeindex. Option --leafsize is\n"
+            "  also permitted.\n"
             "    \n");
 
     // Parse options.
@@ -232,6 +344,13 @@ int main(int argc, char** argv) {
     // Parameter for option should have same name as the one-character version
     // of the option.
     unsigned int num_optional_args = 0;
+    bool has_a = false;
+    double a = 0.0;
+    if (parsed_opts.count("nnepsilon")) {
+        has_a = true;
+        num_optional_args++;
+        a = parsed_opts["nnepsilon"].as<double>();
+    }
     bool has_b = false;
     int b = -1;
     if (parsed_opts.count("numbootstrap")) {
@@ -246,6 +365,20 @@ int main(int argc, char** argv) {
         num_optional_args++;
         c = parsed_opts["confidenceinterval"].as<double>();
     }
+    bool has_d = false;
+    string d("tsv");
+    if (parsed_opts.count("dtformat")) {
+        has_d = true;
+        num_optional_args++;
+        d = parsed_opts["dtformat"].as<string>();
+    }
+    bool has_e = false;
+    double e = 0.0;
+    if (parsed_opts.count("hmmepsilon")) {
+        has_e = true;
+        num_optional_args++;
+        e = parsed_opts["hmmepsilon"].as<double>();
+    }
     bool has_g = false;
     int g = -1;
     if (parsed_opts.count("numgenerate")) {
@@ -253,6 +386,13 @@ int main(int argc, char** argv) {
         num_optional_args++;
         g = parsed_opts["numgenerate"].as<int>();
     }
+    bool has_i = false;
+    string i("kd");
+    if (parsed_opts.count("nnindex")) {
+        has_i = true;
+        num_optional_args++;
+        i = parsed_opts["nnindex"].as<string>();
+    }
     bool has_k = false;
     int k = -1;
     if (parsed_opts.count("neighbors")) {
@@ -260,6 +400,20 @@ int main(int argc, char** argv) {
         num_optional_args++;
         k = parsed_opts["neighbors"].as<int>();
     }
+    bool has_l = false;
+    int l = -1;
+    if (parsed_opts.count("leafsize")) {
+        has_l = true;
+        num_optional_args++;
+        l = parsed_opts["leafsize"].as<int>();
+    }
+    bool has_n = false;
+    bool n = false;
+    if (parsed_opts.count("enumerate")) {
+        has_n = true;
+        num_optional_args++;
+        n = true;
+    }
     bool has_p = false;
     double p = std::numeric_limits<double>::max();
     if (parsed_opts.count("hmmprune")) {
@@ -267,6 +421,13 @@ int main(int argc, char** argv) {
         num_optional_args++;
         p = parsed_opts["hmmprune"].as<double>();
     }
+    bool has_r = false;
+    string r("tsv");
+    if (parsed_opts.count("radformat")) {
+        has_r = true;
+        num_optional_args++;
+        r = parsed_opts["radformat"].as<string>();
+    }
     bool has_s = false;
     double s = 0.0;
     if (parsed_opts.count("sigma")) {
@@ -288,6 +449,34 @@ int main(int argc, char** argv) {
         num_optional_args++;
         x = parsed_opts["dyeseqstring"].as<string>();
     }
+    bool has_z = false;
+    unsigned int z = 0;
+    if (parsed_opts.count("seed")) {
+        has_z = true;
+        num_optional_args++;
+        z = parsed_opts["seed"].as<unsigned int>();
+    }
+    bool has_B = false;
+    int B = 1;
+    if (parsed_opts.count("hmmbatch")) {
+        has_B = true;
+        num_optional_args++;
+        B = parsed_opts["hmmbatch"].as<int>();
+    }
+    bool has_C = false;
+    int C = 0;
+    if (parsed_opts.count("streamchunk")) {
+        has_C = true;
+        num_optional_args++;
+        C = parsed_opts["streamchunk"].as<int>();
+    }
+    bool has_E = false;
+    bool E = false;
+    if (parsed_opts.count("fastexp")) {
+        has_E = true;
+        num_optional_args++;
+        E = true;
+    }
     bool has_F = false;
     string F("");
     if (parsed_opts.count("fitsettings")) {
@@ -302,6 +491,13 @@ int main(int argc, char** argv) {
         num_optional_args++;
         H = parsed_opts["passthrough"].as<int>();
     }
+    bool has_I = false;
+    string I("");
+    if (parsed_opts.count("kdtreeindex")) {
+        has_I = true;
+        num_optional_args++;
+        I = parsed_opts["kdtreeindex"].as<string>();
+    }
     bool has_L = false;
     double L = 0.0;
     if (parsed_opts.count("stoppingthreshold")) {
@@ -366,44 +562,104 @@ int main(int argc, char** argv) {
             return 1;
         }
         if (0 == positional_args[1].compare("hmm")) {
-            // Special handling for p since it is optional for classify hmm.
+            // Special handling for p, e, B, C, and E since they are optional
+            // for classify hmm.
             if (has_p) {
                 num_optional_args--;
             }
+            if (has_e) {
+                num_optional_args--;
+            }
+            if (has_B) {
+                num_optional_args--;
+            }
+            if (has_C) {
+                num_optional_args--;
+            }
+            if (has_E) {
+                num_optional_args--;
+            }
             if (num_optional_args != 4 || !has_P || !has_S || !has_R
-                || !has_Y) {
+                || !has_Y || B < 1 || C < 0 || e < 0.0 || e > 1.0) {
                 cout << endl << "INCORRECT USAGE" << endl << endl;
                 cout << options.help() << endl;
                 return 1;
             }
             print_omp_info();
-            run_classify_hmm(P, p, S, R, Y);
+            run_classify_hmm(P, p, e, E, B, C, S, R, Y);
             return 0;
         }
         if (0 == positional_args[1].compare("hybrid")) {
-            // Special handling for p since it is optional for classify hybrid.
+            // Special handling for a, i, l, p, e, C, and E since they are
+            // optional for classify hybrid.
+            if (has_a) {
+                num_optional_args--;
+            }
+            if (has_i) {
+                num_optional_args--;
+            }
+            if (has_l) {
+                num_optional_args--;
+            }
             if (has_p) {
                 num_optional_args--;
             }
+            if (has_C) {
+                num_optional_args--;
+            }
+            if (has_e) {
+                num_optional_args--;
+            }
+            if (has_E) {
+                num_optional_args--;
+            }
+            // Exactly one of T and I gives the dye-tracks to search. The
+            // kind and leaf size of an index were fixed when it was built.
             if (num_optional_args != 8 || !has_P || !has_k || !has_s || !has_H
-                || !has_S || !has_T || !has_R || !has_Y) {
+                || !has_S || !(has_T ^ has_I) || !has_R || !has_Y || a < 0.0
+                || (has_l && (has_I || l < 1))
+                || (has_i && (has_I || !(0 == i.compare("kd")
+                                         || 0 == i.compare("ball"))))
+                || C < 0 || e < 0.0
+                || e > 1.0) {
                 cout << endl << "INCORRECT USAGE" << endl << endl;
                 cout << options.help() << endl;
                 return 1;
             }
             print_omp_info();
-            run_classify_hybrid(P, k, s, H, p, S, T, R, Y);
+            run_classify_hybrid(
+                    P, k, has_l ? l : k, i, s, a, H, p, e, E, C, S, T, I, R, Y);
             return 0;
         }
         if (0 == positional_args[1].compare("nn")) {
-            if (num_optional_args != 6 || !has_P || !has_k || !has_s || !has_T
-                || !has_R || !has_Y) {
+            // Special handling for a, i, l, and C since they are optional for
+            // classify nn.
+            if (has_a) {
+                num_optional_args--;
+            }
+            if (has_i) {
+                num_optional_args--;
+            }
+            if (has_l) {
+                num_optional_args--;
+            }
+            if (has_C) {
+                num_optional_args--;
+            }
+            // Exactly one of T and I gives the dye-tracks to search. The
+            // kind and leaf size of an index were fixed when it was built.
+            if (num_optional_args != 6 || !has_P || !has_k || !has_s
+                || !(has_T ^ has_I) || !has_R || !has_Y || a < 0.0
+                || (has_l && (has_I || l < 1))
+                || (has_i && (has_I || !(0 == i.compare("kd")
+                                         || 0 == i.compare("ball"))))
+                || C < 0) {
                 cout << endl << "INCORRECT USAGE" << endl << endl;
                 cout << options.help() << endl;
                 return 1;
             }
             print_omp_info();
-            run_classify_nn(P, k, s, T, R, Y);
+            run_classify_nn(P, k, has_l ? l : k, i, s, a, C, T, I, R, Y);
             return 0;
         }
         cout << endl << "INCORRECT USAGE" << endl << endl;
@@ -452,29 +708,70 @@ int main(int argc, char** argv) {
             return 1;
         }
         if (0 == positional_args[1].compare("dt")) {
+            // Special handling for d, n, and z since they are optional for
+            // simulate dt.
+            if (has_d) {
+                num_optional_args--;
+            }
+            if (has_n) {
+                num_optional_args--;
+            }
+            if (has_z) {
+                num_optional_args--;
+            }
             if (num_optional_args != 5 || !has_P || !has_t || !has_g || !has_S
-                || !has_T) {
+                || !has_T
+                || (0 != d.compare("tsv") && 0 != d.compare("bin"))) {
                 cout << endl << "INCORRECT USAGE" << endl << endl;
                 cout << options.help() << endl;
                 return 1;
             }
-            run_simulate_dt(t, g, P, S, T);
+            print_omp_info();
+            run_simulate_dt(
+                    t, g, n, d, P, S, T, has_z ? z : time_based_seed());
             return 0;
         }
         if (0 == positional_args[1].compare("rad")) {
+            // Special handling for r and z since they are optional for
+            // simulate rad.
+            if (has_r) {
+                num_optional_args--;
+            }
+            if (has_z) {
+                num_optional_args--;
+            }
             if (num_optional_args != 6 || !has_P || !has_t || !has_g || !has_S
-                || !has_R || !has_Y) {
+                || !has_R || !has_Y
+                || (0 != r.compare("tsv") && 0 != r.compare("bin64")
+                    && 0 != r.compare("bin32"))) {
                 cout << endl << "INCORRECT USAGE" << endl << endl;
                 cout << options.help() << endl;
                 return 1;
             }
-            run_simulate_rad(t, g, P, S, R, Y);
+            print_omp_info();
+            run_simulate_rad(
+                    t, g, r, P, S, R, Y, has_z ? z : time_based_seed());
             return 0;
         }
         cout << endl << "INCORRECT USAGE" << endl << endl;
         cout << options.help() << endl;
         return 1;
     }
+    if (0 == positional_args[0].compare("build-index")) {
+        // Special handling for l since it is optional for build-index.
+        if (has_l) {
+            num_optional_args--;
+        }
+        if (positional_args.size() != 1 || num_optional_args != 4 || !has_P
+            || !has_k || !has_T || !has_I || (has_l && l < 1)) {
+            cout << endl << "INCORRECT USAGE" << endl << endl;
+            cout << options.help() << endl;
+            return 1;
+        }
+        print_omp_info();
+        run_build_index(P, k, has_l ? l : k, T, I);
+        return 0;
+    }
     cout << endl << "INCORRECT USAGE" << endl << endl;
     cout << options.help() << endl;
     return 1;
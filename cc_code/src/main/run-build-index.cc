@@ -0,0 +1,101 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+
+// Defining symbols from header:
+#include "run-build-index.h"
+
+// Standard C++ library headers:
+#include <string>
+#include <vector>
+
+// Local project headers:
+#include "classifiers/nn-classifier.h"
+#include "common/dye-track.h"
+#include "common/sourced-data.h"
+#include "io/dye-tracks-io.h"
+#include "io/kd-tree-index-io.h"
+#include "kd-tree/flat-kd-tree.h"
+#include "main/cmd-line-out.h"
+#include "parameterization/model/sequencing-model.h"
+#include "util/mapped-file.h"
+#include "util/time.h"
+
+namespace whatprot {
+
+namespace {
+using std::string;
+using std::vector;
+}  // namespace
+
+void run_build_index(string seq_params_filename,
+                     int k,
+                     int leaf_size,
+                     string dye_tracks_filename,
+                     string kd_tree_index_filename) {
+    double total_start_time = wall_time();
+
+    double start_time;
+    double end_time;
+
+    start_time = wall_time();
+    SequencingModel true_seq_model(seq_params_filename);
+    SequencingModel seq_model = true_seq_model.with_mu_as_one();
+    end_time = wall_time();
+    print_finished_basic_setup(end_time - start_time);
+
+    start_time = wall_time();
+    unsigned int num_timesteps;
+    unsigned int num_channels;
+    MappedFile* dye_tracks_file;  // NULL unless the file is binary.
+    vector<SourcedData<DyeTrack, SourceCountHitsList<int>>> dye_tracks;
+    read_dye_tracks(dye_tracks_filename,
+                    &num_timesteps,
+                    &num_channels,
+                    &dye_tracks_file,
+                    &dye_tracks);
+    if (num_timesteps == 0) {
+        print_bad_inputs();
+        return;
+    }
+    end_time = wall_time();
+    print_read_dye_tracks(dye_tracks.size(), end_time - start_time);
+
+    start_time = wall_time();
+    vector<SourceCountHitsList<int>> entry_sources;
+    FlatKDTree* kd_tree = build_kd_tree(num_timesteps,
+                                        num_channels,
+                                        seq_model,
+                                        k,
+                                        leaf_size,
+                                        &dye_tracks,
+                                        &entry_sources);
+    end_time = wall_time();
+    print_built_kd_tree_index(kd_tree->num_entries, end_time - start_time);
+
+    start_time = wall_time();
+    write_kd_tree_index(kd_tree_index_filename,
+                        seq_model,
+                        num_timesteps,
+                        num_channels,
+                        k,
+                        *kd_tree,
+                        entry_sources);
+    end_time = wall_time();
+    print_finished_saving_results(end_time - start_time);
+
+    delete kd_tree;
+    // The sources may still point into the mapping, so they must go first.
+    entry_sources.clear();
+    delete dye_tracks_file;
+
+    double total_end_time = wall_time();
+    print_total_time(total_end_time - total_start_time);
+}
+
+}  // namespace whatprot
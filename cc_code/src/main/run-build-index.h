@@ -0,0 +1,26 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+
+#ifndef WHATPROT_MAIN_RUN_BUILD_INDEX_H
+#define WHATPROT_MAIN_RUN_BUILD_INDEX_H
+
+// Standard C++ library headers:
+#include <string>
+
+namespace whatprot {
+
+void run_build_index(std::string seq_params_filename,
+                     int k,
+                     int leaf_size,
+                     std::string dye_tracks_filename,
+                     std::string kd_tree_index_filename);
+
+}  // namespace whatprot
+
+#endif  // WHATPROT_MAIN_RUN_BUILD_INDEX_H
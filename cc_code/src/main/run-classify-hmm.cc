@@ -24,6 +24,7 @@
 #include "io/radiometries-io.h"
 #include "io/scored-classifications-io.h"
 #include "main/cmd-line-out.h"
+#include "main/stream-classify.h"
 #include "parameterization/model/sequencing-model.h"
 #include "parameterization/settings/sequencing-settings.h"
 #include "util/time.h"
@@ -37,6 +38,10 @@ using std::vector;
 
 void run_classify_hmm(string seq_params_filename,
                       double hmm_pruning_cutoff,
+                      double hmm_epsilon,
+                      bool fast_exp,
+                      unsigned int hmm_batch_size,
+                      unsigned int stream_chunk_size,
                       string dye_seqs_filename,
                       string radiometries_filename,
                       string predictions_filename) {
@@ -59,39 +64,56 @@ void run_classify_hmm(string seq_params_filename,
     SequencingModel seq_model = true_seq_model.with_mu_as_one();
     SequencingSettings seq_settings;
     seq_settings.dist_cutoff = hmm_pruning_cutoff;
+    seq_settings.fast_exp = fast_exp;
     end_time = wall_time();
     print_finished_basic_setup(end_time - start_time);
 
     start_time = wall_time();
-    unsigned int num_timesteps;
-    unsigned int duplicate_num_channels;  // also get this from dye seq file.
-    unsigned int total_num_radiometries;  // num radiometries across all procs.
+    RadiometriesReader reader(radiometries_filename, true_seq_model);
+    if (!reader.valid) {
+        print_bad_inputs();
+        return;
+    }
+    unsigned int num_timesteps = reader.num_timesteps;
+    unsigned int total_num_radiometries = reader.num_radiometries;
     vector<Radiometry> radiometries;
-    read_radiometries(radiometries_filename,
-                      true_seq_model,
-                      &num_timesteps,
-                      &duplicate_num_channels,
-                      &total_num_radiometries,
-                      &radiometries);
-    end_time = wall_time();
-    print_read_radiometries(total_num_radiometries, end_time - start_time);
+    // When streaming, the radiometries are instead read a chunk at a time
+    // during classification.
+    if (stream_chunk_size == 0) {
+        reader.read(total_num_radiometries, &radiometries);
+        end_time = wall_time();
+        print_read_radiometries(total_num_radiometries, end_time - start_time);
+    }
 
     start_time = wall_time();
     HMMClassifier classifier(
             num_timesteps, num_channels, seq_model, seq_settings, dye_seqs);
+    classifier.batch_size = hmm_batch_size;
+    classifier.abandon_epsilon = hmm_epsilon;
     end_time = wall_time();
     print_built_classifier(end_time - start_time);
 
-    start_time = wall_time();
-    vector<ScoredClassification> results = classifier.classify(radiometries);
-    end_time = wall_time();
-    print_finished_classification(end_time - start_time);
+    if (stream_chunk_size != 0) {
+        start_time = wall_time();
+        ScoredClassificationsWriter writer(predictions_filename);
+        unsigned int num_classified = stream_classify(
+                stream_chunk_size, &reader, &classifier, &writer);
+        end_time = wall_time();
+        print_finished_streaming_classification(num_classified,
+                                                end_time - start_time);
+    } else {
+        start_time = wall_time();
+        vector<ScoredClassification> results =
+                classifier.classify(radiometries);
+        end_time = wall_time();
+        print_finished_classification(end_time - start_time);
 
-    start_time = wall_time();
-    write_scored_classifications(
-            predictions_filename, total_num_radiometries, results);
-    end_time = wall_time();
-    print_finished_saving_results(end_time - start_time);
+        start_time = wall_time();
+        write_scored_classifications(
+                predictions_filename, total_num_radiometries, results);
+        end_time = wall_time();
+        print_finished_saving_results(end_time - start_time);
+    }
 
     double total_end_time = wall_time();
     print_total_time(total_end_time - total_start_time);
@@ -15,6 +15,10 @@ namespace whatprot {
 
 void run_classify_hmm(std::string seq_params_filename,
                       double hmm_pruning_cutoff,
+                      double hmm_epsilon,
+                      bool fast_exp,
+                      unsigned int hmm_batch_size,
+                      unsigned int stream_chunk_size,
                       std::string dye_seqs_filename,
                       std::string radiometries_filename,
                       std::string predictions_filename);
@@ -15,11 +15,18 @@ namespace whatprot {
 
 void run_classify_hybrid(std::string seq_params_filename,
                          int k,
+                         int leaf_size,
+                         std::string nn_index,
                          double sig,
+                         double nn_epsilon,
                          int h,
                          double hmm_pruning_cutoff,
+                         double hmm_epsilon,
+                         bool fast_exp,
+                         unsigned int stream_chunk_size,
                          std::string dye_seqs_filename,
                          std::string dye_tracks_filename,
+                         std::string kd_tree_index_filename,
                          std::string radiometries_filename,
                          std::string predictions_filename);
 
@@ -14,16 +14,21 @@
 #include <vector>
 
 // Local project headers:
+#include "ball-tree/flat-ball-tree.h"
 #include "classifiers/nn-classifier.h"
 #include "common/dye-track.h"
 #include "common/radiometry.h"
 #include "common/scored-classification.h"
 #include "common/sourced-data.h"
 #include "io/dye-tracks-io.h"
+#include "io/kd-tree-index-io.h"
 #include "io/radiometries-io.h"
 #include "io/scored-classifications-io.h"
+#include "kd-tree/flat-kd-tree.h"
 #include "main/cmd-line-out.h"
+#include "main/stream-classify.h"
 #include "parameterization/model/sequencing-model.h"
+#include "util/mapped-file.h"
 #include "util/time.h"
 
 namespace whatprot {
@@ -35,8 +40,13 @@ using std::vector;
 
 void run_classify_nn(string seq_params_filename,
                      int k,
+                     int leaf_size,
+                     string nn_index,
                      double sig,
+                     double nn_epsilon,
+                     unsigned int stream_chunk_size,
                      string dye_tracks_filename,
+                     string kd_tree_index_filename,
                      string radiometries_filename,
                      string predictions_filename) {
     double total_start_time = wall_time();
@@ -46,48 +56,129 @@ void run_classify_nn(string seq_params_filename,
 
     start_time = wall_time();
     SequencingModel true_seq_model(seq_params_filename);
+    SequencingModel seq_model = true_seq_model.with_mu_as_one();
     end_time = wall_time();
     print_finished_basic_setup(end_time - start_time);
 
     start_time = wall_time();
     unsigned int num_timesteps;
     unsigned int num_channels;
+    // The classifier is built from either dye tracks or a KD-tree index. The
+    // file is left mapped unless it is a text dye tracks file.
+    MappedFile* reference_file;
     vector<SourcedData<DyeTrack, SourceCountHitsList<int>>> dye_tracks;
-    read_dye_tracks(
-            dye_tracks_filename, &num_timesteps, &num_channels, &dye_tracks);
-    end_time = wall_time();
-    print_read_dye_tracks(dye_tracks.size(), end_time - start_time);
+    FlatKDTree* kd_tree = NULL;
+    vector<SourceCountHitsList<int>> entry_sources;
+    if (kd_tree_index_filename.empty()) {
+        read_dye_tracks(dye_tracks_filename,
+                        &num_timesteps,
+                        &num_channels,
+                        &reference_file,
+                        &dye_tracks);
+        if (num_timesteps == 0) {
+            print_bad_inputs();
+            return;
+        }
+        end_time = wall_time();
+        print_read_dye_tracks(dye_tracks.size(), end_time - start_time);
+    } else {
+        read_kd_tree_index(kd_tree_index_filename,
+                           seq_model,
+                           &num_timesteps,
+                           &num_channels,
+                           &reference_file,
+                           &kd_tree,
+                           &entry_sources);
+        if (kd_tree == NULL) {
+            print_bad_inputs();
+            delete reference_file;
+            return;
+        }
+        end_time = wall_time();
+        print_read_kd_tree_index(kd_tree->num_entries, end_time - start_time);
+    }
 
     start_time = wall_time();
-    unsigned int duplicate_num_timesteps;  // also get this from dye track file.
-    unsigned int duplicate_num_channels;  // also get this from dye track file.
-    unsigned int total_num_radiometries;  // num radiometries across all procs.
+    RadiometriesReader reader(radiometries_filename, true_seq_model);
+    if (!reader.valid) {
+        print_bad_inputs();
+        // The KD-tree may use the mapping, so it must be deleted first.
+        delete kd_tree;
+        delete reference_file;
+        return;
+    }
+    unsigned int total_num_radiometries = reader.num_radiometries;
     vector<Radiometry> radiometries;
-    read_radiometries(radiometries_filename,
-                      true_seq_model,
-                      &duplicate_num_timesteps,
-                      &duplicate_num_channels,
-                      &total_num_radiometries,
-                      &radiometries);
-    end_time = wall_time();
-    print_read_radiometries(total_num_radiometries, end_time - start_time);
+    // When streaming, the radiometries are instead read a chunk at a time
+    // during classification.
+    if (stream_chunk_size == 0) {
+        reader.read(total_num_radiometries, &radiometries);
+        end_time = wall_time();
+        print_read_radiometries(total_num_radiometries, end_time - start_time);
+    }
 
     start_time = wall_time();
-    NNClassifier classifier(
-            num_timesteps, num_channels, true_seq_model, k, sig, &dye_tracks);
+    NNClassifier* classifier;
+    if (kd_tree == NULL && 0 == nn_index.compare("ball")) {
+        FlatBallTree* ball_tree = build_ball_tree(num_timesteps,
+                                                  num_channels,
+                                                  seq_model,
+                                                  leaf_size,
+                                                  &dye_tracks,
+                                                  &entry_sources);
+        classifier = new NNClassifier(num_timesteps,
+                                      num_channels,
+                                      k,
+                                      sig,
+                                      nn_epsilon,
+                                      ball_tree,
+                                      &entry_sources);
+    } else if (kd_tree == NULL) {
+        classifier = new NNClassifier(num_timesteps,
+                                      num_channels,
+                                      seq_model,
+                                      k,
+                                      leaf_size,
+                                      sig,
+                                      nn_epsilon,
+                                      &dye_tracks);
+    } else {
+        classifier = new NNClassifier(num_timesteps,
+                                      num_channels,
+                                      k,
+                                      sig,
+                                      nn_epsilon,
+                                      kd_tree,
+                                      &entry_sources);
+    }
     end_time = wall_time();
     print_built_classifier(end_time - start_time);
 
-    start_time = wall_time();
-    vector<ScoredClassification> results = classifier.classify(radiometries);
-    end_time = wall_time();
-    print_finished_classification(end_time - start_time);
+    if (stream_chunk_size != 0) {
+        start_time = wall_time();
+        ScoredClassificationsWriter writer(predictions_filename);
+        unsigned int num_classified = stream_classify(
+                stream_chunk_size, &reader, classifier, &writer);
+        end_time = wall_time();
+        print_finished_streaming_classification(num_classified,
+                                                end_time - start_time);
+    } else {
+        start_time = wall_time();
+        vector<ScoredClassification> results =
+                classifier->classify(radiometries);
+        end_time = wall_time();
+        print_finished_classification(end_time - start_time);
 
-    start_time = wall_time();
-    write_scored_classifications(
-            predictions_filename, total_num_radiometries, results);
-    end_time = wall_time();
-    print_finished_saving_results(end_time - start_time);
+        start_time = wall_time();
+        write_scored_classifications(
+                predictions_filename, total_num_radiometries, results);
+        end_time = wall_time();
+        print_finished_saving_results(end_time - start_time);
+    }
+
+    // The classifier may use the mapping, so it must be deleted first.
+    delete classifier;
+    delete reference_file;
 
     double total_end_time = wall_time();
     print_total_time(total_end_time - total_start_time);
@@ -15,8 +15,13 @@ namespace whatprot {
 
 void run_classify_nn(std::string seq_params_filename,
                      int k,
+                     int leaf_size,
+                     std::string nn_index,
                      double sig,
+                     double nn_epsilon,
+                     unsigned int stream_chunk_size,
                      std::string dye_tracks_filename,
+                     std::string kd_tree_index_filename,
                      std::string radiometries_filename,
                      std::string predictions_filename);
 
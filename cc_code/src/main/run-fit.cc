@@ -57,6 +57,7 @@ void run_fit(double stopping_threshold,
     // Sequencing settings
     SequencingSettings seq_settings;
     seq_settings.dist_cutoff = std::numeric_limits<double>::max();
+    seq_settings.fast_exp = false;
     // Fit settings
     FitSettings fit_settings;
     if (fit_params_filename == "") {
@@ -80,6 +81,10 @@ void run_fit(double stopping_threshold,
                       &duplicate_num_channels,
                       &total_num_radiometries,
                       &radiometries);
+    if (num_timesteps == 0) {
+        print_bad_inputs();
+        return;
+    }
     end_time = wall_time();
     print_read_radiometries(total_num_radiometries, end_time - start_time);
 
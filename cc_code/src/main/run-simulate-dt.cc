@@ -10,7 +10,6 @@
 #include "run-simulate-dt.h"
 
 // Standard C++ library headers:
-#include <random>
 #include <string>
 #include <vector>
 
@@ -22,22 +21,25 @@
 #include "main/cmd-line-out.h"
 #include "parameterization/model/sequencing-model.h"
 #include "simulation/dedup-dye-tracks.h"
+#include "simulation/enumerate-dye-tracks.h"
 #include "simulation/generate-dye-tracks.h"
 #include "util/time.h"
 
 namespace whatprot {
 
 namespace {
-using std::default_random_engine;
 using std::string;
 using std::vector;
 }  // namespace
 
 void run_simulate_dt(unsigned int num_timesteps,
                      unsigned int dye_tracks_per_peptide,
+                     bool enumerate,
+                     string dye_tracks_format,
                      string seq_params_filename,
                      string dye_seqs_filename,
-                     string dye_tracks_filename) {
+                     string dye_tracks_filename,
+                     unsigned int seed) {
     double total_start_time = wall_time();
 
     double start_time;
@@ -58,33 +60,54 @@ void run_simulate_dt(unsigned int num_timesteps,
     end_time = wall_time();
     print_read_dye_seqs(total_num_dye_seqs, end_time - start_time);
 
-    start_time = wall_time();
-    default_random_engine generator(time_based_seed());
-    vector<SourcedData<DyeTrack, SourceCount<int>>> dye_tracks;
-    generate_dye_tracks(seq_model,
-                        dye_seqs,
-                        num_timesteps,
-                        num_channels,
-                        dye_tracks_per_peptide,
-                        &generator,
-                        &dye_tracks);
-    end_time = wall_time();
-    print_finished_generating_dye_tracks(dye_tracks.size(),
-                                         end_time - start_time);
-
-    start_time = wall_time();
     vector<SourcedData<DyeTrack, SourceCountHitsList<int>>> deduped_dye_tracks;
-    dedup_dye_tracks(
-            num_timesteps, num_channels, &dye_tracks, &deduped_dye_tracks);
-    end_time = wall_time();
-    print_finished_deduping_dye_tracks(deduped_dye_tracks.size(),
-                                       end_time - start_time);
+    if (enumerate) {
+        start_time = wall_time();
+        enumerate_dye_tracks(seq_model,
+                             dye_seqs,
+                             num_timesteps,
+                             num_channels,
+                             dye_tracks_per_peptide,
+                             &deduped_dye_tracks);
+        end_time = wall_time();
+        print_finished_enumerating_dye_tracks(deduped_dye_tracks.size(),
+                                              end_time - start_time);
+    } else {
+        print_seed(seed);
+
+        start_time = wall_time();
+        vector<SourcedData<DyeTrack, SourceCount<int>>> dye_tracks;
+        generate_dye_tracks(seq_model,
+                            dye_seqs,
+                            num_timesteps,
+                            num_channels,
+                            dye_tracks_per_peptide,
+                            seed,
+                            &dye_tracks);
+        end_time = wall_time();
+        print_finished_generating_dye_tracks(dye_tracks.size(),
+                                             end_time - start_time);
+
+        start_time = wall_time();
+        dedup_dye_tracks(
+                num_timesteps, num_channels, &dye_tracks, &deduped_dye_tracks);
+        end_time = wall_time();
+        print_finished_deduping_dye_tracks(deduped_dye_tracks.size(),
+                                           end_time - start_time);
+    }
 
     start_time = wall_time();
-    write_dye_tracks(dye_tracks_filename,
-                     num_timesteps,
-                     num_channels,
-                     deduped_dye_tracks);
+    if (0 == dye_tracks_format.compare("tsv")) {
+        write_dye_tracks(dye_tracks_filename,
+                         num_timesteps,
+                         num_channels,
+                         deduped_dye_tracks);
+    } else {
+        write_dye_tracks_binary(dye_tracks_filename,
+                                num_timesteps,
+                                num_channels,
+                                deduped_dye_tracks);
+    }
     end_time = wall_time();
     print_finished_saving_results(end_time - start_time);
 
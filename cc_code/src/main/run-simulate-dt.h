@@ -16,9 +16,12 @@ namespace whatprot {
 
 void run_simulate_dt(unsigned int num_timesteps,
                      unsigned int dye_tracks_per_peptide,
+                     bool enumerate,
+                     std::string dye_tracks_format,
                      std::string seq_params_filename,
                      std::string dye_seqs_filename,
-                     std::string dye_tracks_filename);
+                     std::string dye_tracks_filename,
+                     unsigned int seed);
 
 }  // namespace whatprot
 
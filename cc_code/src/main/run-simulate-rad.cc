@@ -10,8 +10,9 @@
 #include "run-simulate-rad.h"
 
 // Standard C++ library headers:
-#include <random>
 #include <string>
+#include <thread>
+#include <utility>  // for std::swap
 #include <vector>
 
 // Local project headers:
@@ -27,17 +28,24 @@
 namespace whatprot {
 
 namespace {
-using std::default_random_engine;
 using std::string;
+using std::swap;
+using std::thread;
 using std::vector;
+
+// Radiometries are generated and written this many at a time, so that only a
+// couple of blocks need to be held in memory at once.
+const unsigned int BLOCK_SIZE = 1 << 16;
 }  // namespace
 
 void run_simulate_rad(unsigned int num_timesteps,
                       unsigned int num_to_generate,
+                      string radiometries_format,
                       string seq_params_filename,
                       string dye_seqs_filename,
                       string radiometries_filename,
-                      string ys_filename) {
+                      string ys_filename,
+                      unsigned int seed) {
     double total_start_time = wall_time();
 
     double start_time;
@@ -48,6 +56,7 @@ void run_simulate_rad(unsigned int num_timesteps,
     SequencingModel seq_model = true_seq_model.with_mu_as_one();
     end_time = wall_time();
     print_finished_basic_setup(end_time - start_time);
+    print_seed(seed);
 
     start_time = wall_time();
     unsigned int num_channels;
@@ -58,29 +67,44 @@ void run_simulate_rad(unsigned int num_timesteps,
     end_time = wall_time();
     print_read_dye_seqs(total_num_dye_seqs, end_time - start_time);
 
+    // While one block is generated and formatted (using all of the OpenMP
+    // threads), another thread writes the block before. Each radiometry has its
+    // own stream of random numbers, so the results do not depend on the size
+    // of the blocks.
     start_time = wall_time();
-    default_random_engine generator(time_based_seed());
-    vector<SourcedData<Radiometry, SourceCount<int>>> radiometries;
-    generate_radiometries(seq_model,
-                          dye_seqs,
-                          num_timesteps,
-                          num_channels,
-                          num_to_generate,
-                          &generator,
-                          &radiometries);
-    end_time = wall_time();
-    print_finished_generating_radiometries(radiometries.size(),
-                                           end_time - start_time);
-
-    start_time = wall_time();
-    write_radiometries(radiometries_filename,
-                       true_seq_model,
-                       num_timesteps,
-                       num_channels,
-                       radiometries);
-    write_ys(ys_filename, radiometries);
+    RadiometriesWriter writer(radiometries_filename,
+                              ys_filename,
+                              true_seq_model,
+                              num_timesteps,
+                              num_channels,
+                              radiometries_format);
+    vector<SourcedData<Radiometry, SourceCount<int>>> block;
+    FormattedRadiometries formatted;
+    FormattedRadiometries previous_formatted;
+    for (unsigned int begin = 0; begin < num_to_generate; begin += BLOCK_SIZE) {
+        unsigned int size = BLOCK_SIZE;
+        if (size > num_to_generate - begin) {
+            size = num_to_generate - begin;
+        }
+        thread io_thread([&]() { writer.write(previous_formatted); });
+        block.clear();
+        generate_radiometries(seq_model,
+                              dye_seqs,
+                              num_timesteps,
+                              num_channels,
+                              begin,
+                              size,
+                              seed,
+                              &block);
+        writer.format(block, &formatted);
+        io_thread.join();
+        swap(formatted, previous_formatted);
+    }
+    writer.write(previous_formatted);
+    writer.close();
     end_time = wall_time();
-    print_finished_saving_results(end_time - start_time);
+    print_finished_streaming_simulation(writer.num_written,
+                                        end_time - start_time);
 
     double total_end_time = wall_time();
     print_total_time(total_end_time - total_start_time);
@@ -0,0 +1,61 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+#ifndef WHATPROT_MAIN_STREAM_CLASSIFY_H
+#define WHATPROT_MAIN_STREAM_CLASSIFY_H
+
+// Standard C++ library headers:
+#include <thread>
+#include <vector>
+
+// Local project headers:
+#include "common/radiometry.h"
+#include "common/scored-classification.h"
+#include "io/radiometries-io.h"
+#include "io/scored-classifications-io.h"
+
+namespace whatprot {
+
+// Classifies every radiometry that reader has left, chunk_size at a time,
+// writing the results in order with writer. This needs memory for only a
+// couple of chunks, rather than for the whole file. While the classifier works
+// on one chunk (using all of the OpenMP threads), another thread reads the next
+// chunk and writes the results of the one before, so that the file I/O is
+// mostly hidden. C can be any classifier with a classify() function taking a
+// vector of radiometries. Returns the number of radiometries classified.
+template <class C>
+unsigned int stream_classify(unsigned int chunk_size,
+                             RadiometriesReader* reader,
+                             C* classifier,
+                             ScoredClassificationsWriter* writer) {
+    std::vector<Radiometry> chunk;
+    std::vector<Radiometry> next_chunk;
+    std::vector<ScoredClassification> results;
+    std::vector<ScoredClassification> previous_results;
+    unsigned int num_classified = 0;
+    reader->read(chunk_size, &chunk);
+    while (!chunk.empty()) {
+        std::thread io_thread([&]() {
+            writer->write(previous_results);
+            reader->read(chunk_size, &next_chunk);
+        });
+        results = classifier->classify(chunk);
+        io_thread.join();
+        num_classified += chunk.size();
+        // Radiometry has no assignment operator, so we must swap rather than
+        // assign.
+        chunk.swap(next_chunk);
+        previous_results.swap(results);
+    }
+    writer->write(previous_results);
+    return num_classified;
+}
+
+}  // namespace whatprot
+
+#endif  // WHATPROT_MAIN_STREAM_CLASSIFY_H
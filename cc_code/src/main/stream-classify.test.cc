@@ -0,0 +1,150 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+// Boost unit test framework (recommended to be the first include):
+#include <boost/test/unit_test.hpp>
+
+// File under test:
+#include "stream-classify.h"
+
+// Standard C++ library headers:
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Local project headers:
+#include "common/radiometry.h"
+#include "common/scored-classification.h"
+#include "common/sourced-data.h"
+#include "io/radiometries-io.h"
+#include "io/scored-classifications-io.h"
+#include "parameterization/model/sequencing-model.h"
+
+namespace whatprot {
+
+namespace {
+using std::ifstream;
+using std::istreambuf_iterator;
+using std::remove;
+using std::string;
+using std::vector;
+
+// Classifies a radiometry as the integer part of its first intensity, with a
+// score that depends on the rest of it, and keeps the size of every chunk it
+// is given.
+class StubClassifier {
+public:
+    vector<ScoredClassification> classify(
+            const vector<Radiometry>& radiometries) {
+        chunk_sizes.push_back(radiometries.size());
+        vector<ScoredClassification> results;
+        for (const Radiometry& radiometry : radiometries) {
+            results.push_back(ScoredClassification(
+                    (int)radiometry(0, 0),  // id
+                    radiometry(1, 0),       // score
+                    2.0));                  // total
+        }
+        return results;
+    }
+    vector<unsigned int> chunk_sizes;
+};
+
+// One channel with mu as one, so that the radiometries are written as they
+// are.
+SequencingModel test_seq_model() {
+    SequencingModel seq_model(1);
+    seq_model.channel_models[0]->mu = 1.0;
+    return seq_model;
+}
+
+// Writes num_radiometries radiometries of two timesteps, where radiometry i
+// has the intensities (i % 7) and 0.1 * i.
+void write_test_radiometries(const string& filename,
+                             unsigned int num_radiometries) {
+    vector<SourcedData<Radiometry, SourceCount<int>>> radiometries;
+    for (unsigned int i = 0; i < num_radiometries; i++) {
+        Radiometry radiometry(2, 1);
+        radiometry(0, 0) = i % 7;
+        radiometry(1, 0) = 0.1 * i;
+        radiometries.push_back(SourcedData<Radiometry, SourceCount<int>>(
+                radiometry, SourceCount<int>(i, 1)));
+    }
+    write_radiometries(filename, test_seq_model(), 2, 1, radiometries);
+}
+
+// Classifies the whole file at once with a StubClassifier, and writes the
+// results with write_scored_classifications().
+void classify_whole(const string& radiometries_filename,
+                    const string& filename) {
+    SequencingModel seq_model = test_seq_model();
+    RadiometriesReader reader(radiometries_filename, seq_model);
+    vector<Radiometry> radiometries;
+    reader.read(reader.num_radiometries, &radiometries);
+    StubClassifier classifier;
+    vector<ScoredClassification> results = classifier.classify(radiometries);
+    write_scored_classifications(filename, results.size(), results);
+}
+
+string read_file(const string& filename) {
+    ifstream f(filename, ifstream::binary);
+    return string(istreambuf_iterator<char>(f), istreambuf_iterator<char>());
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(main_suite)
+BOOST_AUTO_TEST_SUITE(stream_classify_suite)
+
+BOOST_AUTO_TEST_CASE(matches_whole_file_test) {
+    string radiometries_filename = "stream-classify-test-radiometries.tmp";
+    string filename = "stream-classify-test.tmp";
+    string expected_filename = "stream-classify-test-expected.tmp";
+    write_test_radiometries(radiometries_filename, 23);
+    classify_whole(radiometries_filename, expected_filename);
+    SequencingModel seq_model = test_seq_model();
+    StubClassifier classifier;
+    unsigned int num_classified;
+    {
+        RadiometriesReader reader(radiometries_filename, seq_model);
+        ScoredClassificationsWriter writer(filename);
+        // Five doesn't divide 23, so the last chunk is short.
+        num_classified = stream_classify(5, &reader, &classifier, &writer);
+    }
+    BOOST_TEST(num_classified == 23u);
+    BOOST_TEST(classifier.chunk_sizes == vector<unsigned int>({5, 5, 5, 5, 3}));
+    // The same results, in the same order, with radmat_iz counting on across
+    // the chunks.
+    BOOST_TEST((read_file(filename) == read_file(expected_filename)));
+    remove(radiometries_filename.c_str());
+    remove(filename.c_str());
+    remove(expected_filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(empty_test) {
+    string radiometries_filename = "stream-classify-test-radiometries.tmp";
+    string filename = "stream-classify-test.tmp";
+    write_test_radiometries(radiometries_filename, 0);
+    SequencingModel seq_model = test_seq_model();
+    StubClassifier classifier;
+    unsigned int num_classified;
+    {
+        RadiometriesReader reader(radiometries_filename, seq_model);
+        ScoredClassificationsWriter writer(filename);
+        num_classified = stream_classify(5, &reader, &classifier, &writer);
+    }
+    BOOST_TEST(num_classified == 0u);
+    BOOST_TEST(classifier.chunk_sizes.empty());
+    BOOST_TEST(read_file(filename) == "radmat_iz,best_pep_iz,best_pep_score\n");
+    remove(radiometries_filename.c_str());
+    remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // stream_classify_suite
+BOOST_AUTO_TEST_SUITE_END()  // main_suite
+
+}  // namespace whatprot
@@ -16,6 +16,9 @@ public:
     // We prune the emission matrix using this as a multiplier for the standard
     // deviation.
     double dist_cutoff;
+    // Whether to use fast_exp() (see util/fast-exp.h) instead of std::exp()
+    // when computing emission probabilities.
+    bool fast_exp;
 };
 
 }  // namespace whatprot
@@ -10,13 +10,14 @@
 #include "dedup-dye-tracks.h"
 
 // Standard C++ library headers:
-#include <unordered_map>
+#include <algorithm>
+#include <cstddef>
+#include <functional>
 #include <utility>  // for std::move
 #include <vector>
 
-// External headers:
-#include "keyvalue.h"
-#include "mapreduce.h"
+// OpenMP
+#include <omp.h>
 
 // Local project headers:
 #include "common/dye-track.h"
@@ -25,11 +26,23 @@
 namespace whatprot {
 
 namespace {
-using MAPREDUCE_NS::KeyValue;
-using MAPREDUCE_NS::MapReduce;
+using std::hash;
 using std::move;
-using std::unordered_map;
+using std::size_t;
+using std::stable_sort;
 using std::vector;
+
+// The number of shards the dye tracks are split into. This is the most threads
+// that can dedup at once, but the shards are also unequal, so there should be
+// many more of them than threads.
+const unsigned int NUM_SHARDS = 256;
+
+// Marks an empty slot of the hash table of dedup_dye_tracks_shard().
+const unsigned int NO_GROUP = -1;
+
+bool less_by_source(const SourceCount<int>& a, const SourceCount<int>& b) {
+    return a.source < b.source;
+}
 }  // namespace
 
 void dedup_dye_tracks(
@@ -38,113 +51,139 @@ void dedup_dye_tracks(
         vector<SourcedData<DyeTrack, SourceCount<int>>>* dye_tracks_in,
         vector<SourcedData<DyeTrack, SourceCountHitsList<int>>>*
                 dye_tracks_out) {
-    int mpi_size = 1;
-    MapReduce mr(MPI_COMM_WORLD);
-    // map function puts key/value pairs into MapReduce system.
-    mr.map(mpi_size,  // nmap - this ensures one callback per process.
-           &map_dye_tracks,  // callback function
-           (void*)dye_tracks_in);  // ptr - passed through to callback.
-    // collate function brings together key/value pairs with the same key.
-    mr.collate(NULL);  // Collating with default hash function.
-    // reduce converts keys with multiple values into keys with one value.
-    mr.reduce(&reduce_dye_tracks,  // callback function
-              NULL);  // not providing a pointer to be passed to callback.
-    // gather brings the key/value pairs back to one process.
-    mr.gather(1);  // parameter indicates nprocs to gather to
-    // scan goes over all the key/value pairs and puts them into the
-    // dye_tracks_out vector.
-    OutputInfo output_info(num_timesteps, num_channels, dye_tracks_out);
-    mr.scan(&output_dye_tracks,  // callback function
-            (void*)&output_info);  // ptr - passed through to callback.
-}
-
-void map_dye_tracks(int index, KeyValue* kv, void* ptr) {
-    vector<SourcedData<DyeTrack, SourceCount<int>>>* dye_tracks =
-            (vector<SourcedData<DyeTrack, SourceCount<int>>>*)ptr;
-    for (SourcedData<DyeTrack, SourceCount<int>>& dye_track : *dye_tracks) {
-        kv->add((char*)&dye_track.value.counts[0],  // key
-                dye_track.value.counts.size() * sizeof(short),  // keybytes
-                (char*)&dye_track.source,  // value
-                sizeof(SourceCount<int>));  // valuebytes
-    }
-}
-
-void reduce_dye_tracks(char* key,
-                       int keybytes,
-                       char* multivalue,
-                       int nvalues,
-                       int* valuebytes,
-                       KeyValue* kv,
-                       void* ptr) {
-    unordered_map<int, SourceCountHits<int>> source_map;
-    if (multivalue == NULL) {
-        MapReduce* mr = (MapReduce*)valuebytes;
-        int nblocks;
-        uint64_t nvalues_total = mr->multivalue_blocks(nblocks);
-        source_map.reserve(nvalues_total);
-        for (int i = 0; i < nblocks; i++) {
-            nvalues = mr->multivalue_block(i, &multivalue, &valuebytes);
-            reduce_dye_tracks_helper(multivalue, nvalues, &source_map);
+    int num_dye_tracks = dye_tracks_in->size();
+    vector<size_t> hashes(num_dye_tracks);
+    // thread_shards[t][s] holds the indices of the dye tracks of shard s which
+    // thread t went through. Each thread goes through one contiguous part of
+    // dye_tracks_in, and the parts are in the order of the threads.
+    vector<vector<vector<unsigned int>>> thread_shards;
+#pragma omp parallel
+    {
+#pragma omp single
+        thread_shards.resize(omp_get_num_threads(),
+                             vector<vector<unsigned int>>(NUM_SHARDS));
+        // There is a barrier at the end of the single block.
+        vector<vector<unsigned int>>& shards =
+                thread_shards[omp_get_thread_num()];
+        hash<DyeTrack> dye_track_hash;
+#pragma omp for schedule(static)
+        for (int i = 0; i < num_dye_tracks; i++) {
+            hashes[i] = dye_track_hash((*dye_tracks_in)[i].value);
+            shards[hashes[i] % NUM_SHARDS].push_back(i);
         }
-    } else {
-        source_map.reserve(nvalues);
-        reduce_dye_tracks_helper(multivalue, nvalues, &source_map);
     }
-    int num_sources = source_map.size();
-    SourceCountHits<int>* sources = new SourceCountHits<int>[num_sources];
-    unsigned int index = 0;
-    for (const auto& source_map_entry : source_map) {
-        sources[index] = source_map_entry.second;
-        index++;
+    vector<vector<SourcedData<DyeTrack, SourceCountHitsList<int>>>>
+            shard_dye_tracks(NUM_SHARDS);
+#pragma omp parallel for schedule(dynamic)
+    for (unsigned int s = 0; s < NUM_SHARDS; s++) {
+        dedup_dye_tracks_shard(s,
+                               hashes,
+                               &thread_shards,
+                               dye_tracks_in,
+                               &shard_dye_tracks[s]);
     }
-    kv->add(key,
-            keybytes,
-            (char*)sources,  // value
-            num_sources * sizeof(SourceCountHits<int>));  // valuebytes
-}
-
-void reduce_dye_tracks_helper(
-        char* multivalue,
-        int nvalues,
-        unordered_map<int, SourceCountHits<int>>* source_map) {
-    SourceCount<int>* source_counts = (SourceCount<int>*)multivalue;
-    for (int i = 0; i < nvalues; i++) {
-        int source = source_counts[i].source;
-        int count = source_counts[i].count;
-        if (source_map->find(source) == source_map->end()) {
-            (*source_map)[source] = SourceCountHits<int>(source, count, 1);
-        } else {
-            (*source_map)[source].hits++;
+    size_t num_deduped = 0;
+    for (unsigned int s = 0; s < NUM_SHARDS; s++) {
+        num_deduped += shard_dye_tracks[s].size();
+    }
+    dye_tracks_out->reserve(dye_tracks_out->size() + num_deduped);
+    for (unsigned int s = 0; s < NUM_SHARDS; s++) {
+        for (SourcedData<DyeTrack, SourceCountHitsList<int>>& dye_track :
+             shard_dye_tracks[s]) {
+            dye_tracks_out->push_back(move(dye_track));
         }
+        shard_dye_tracks[s].clear();
     }
 }
 
-OutputInfo::OutputInfo(
-        unsigned int num_timesteps,
-        unsigned int num_channels,
-        std::vector<SourcedData<DyeTrack, SourceCountHitsList<int>>>*
-                dye_tracks_out)
-        : num_timesteps(num_timesteps),
-          num_channels(num_channels),
-          dye_tracks_out(dye_tracks_out) {}
-
-void output_dye_tracks(
-        char* key, int keybytes, char* value, int valuebytes, void* ptr) {
-    short* counts = (short*)key;
-    SourceCountHits<int>* val_sources = (SourceCountHits<int>*)value;
-    int num_sources = valuebytes / sizeof(SourceCountHits<int>);
-    OutputInfo* output_info = (OutputInfo*)ptr;
-    unsigned int num_timesteps = output_info->num_timesteps;
-    unsigned int num_channels = output_info->num_channels;
-    vector<SourcedData<DyeTrack, SourceCountHitsList<int>>>* dye_tracks =
-            output_info->dye_tracks_out;
-    SourceCountHits<int>** sources = new SourceCountHits<int>*[num_sources];
-    for (int i = 0; i < num_sources; i++) {
-        sources[i] = new SourceCountHits<int>(val_sources[i]);
+void dedup_dye_tracks_shard(
+        unsigned int shard,
+        const vector<size_t>& hashes,
+        vector<vector<vector<unsigned int>>>* thread_shards,
+        vector<SourcedData<DyeTrack, SourceCount<int>>>* dye_tracks_in,
+        vector<SourcedData<DyeTrack, SourceCountHitsList<int>>>*
+                dye_tracks_out) {
+    vector<unsigned int> members;
+    for (vector<vector<unsigned int>>& shards : *thread_shards) {
+        members.insert(
+                members.end(), shards[shard].begin(), shards[shard].end());
+        vector<unsigned int>().swap(shards[shard]);
+    }
+    // Number the distinct dye tracks in the order they first appear. They are
+    // looked up in a hash table with open addressing, which holds the number
+    // of each distinct dye track, or NO_GROUP. The table is at least twice as
+    // big as the number of dye tracks, so probes are short.
+    size_t table_size = 1;
+    while (table_size < 2 * members.size()) {
+        table_size *= 2;
+    }
+    vector<unsigned int> table(table_size, NO_GROUP);
+    vector<unsigned int> groups(members.size());
+    vector<unsigned int> first_members;
+    for (unsigned int m = 0; m < members.size(); m++) {
+        unsigned int i = members[m];
+        const vector<short>& counts = (*dye_tracks_in)[i].value.counts;
+        // The low bits of the hash chose the shard, so use the others here.
+        size_t slot = (hashes[i] / NUM_SHARDS) & (table_size - 1);
+        while (table[slot] != NO_GROUP
+               && (hashes[first_members[table[slot]]] != hashes[i]
+                   || (*dye_tracks_in)[first_members[table[slot]]].value.counts
+                              != counts)) {
+            slot = (slot + 1) & (table_size - 1);
+        }
+        if (table[slot] == NO_GROUP) {
+            table[slot] = first_members.size();
+            first_members.push_back(i);
+        }
+        groups[m] = table[slot];
+    }
+    vector<unsigned int>().swap(table);
+    unsigned int num_groups = first_members.size();
+    // Collect the sources of each distinct dye track together, with a counting
+    // sort, so that the members of each stay in order.
+    vector<unsigned int> group_begins(num_groups + 1, 0);
+    for (unsigned int m = 0; m < members.size(); m++) {
+        group_begins[groups[m] + 1]++;
+    }
+    for (unsigned int g = 0; g < num_groups; g++) {
+        group_begins[g + 1] += group_begins[g];
+    }
+    vector<SourceCount<int>> sources(members.size(), SourceCount<int>(0, 0));
+    vector<unsigned int> next(group_begins.begin(), group_begins.end() - 1);
+    for (unsigned int m = 0; m < members.size(); m++) {
+        sources[next[groups[m]]++] = (*dye_tracks_in)[members[m]].source;
+    }
+    dye_tracks_out->reserve(num_groups);
+    for (unsigned int g = 0; g < num_groups; g++) {
+        SourceCount<int>* begin = &sources[group_begins[g]];
+        SourceCount<int>* end = &sources[0] + group_begins[g + 1];
+        stable_sort(begin, end, less_by_source);
+        // As before, the count of a source is the count of the first of its
+        // dye tracks, and its hits are how many of them there are.
+        int num_sources = 0;
+        for (SourceCount<int>* sc = begin; sc != end; sc++) {
+            if (sc == begin || sc->source != (sc - 1)->source) {
+                num_sources++;
+            }
+        }
+        SourceCountHits<int>* deduped_sources =
+                new SourceCountHits<int>[num_sources];
+        int index = -1;
+        for (SourceCount<int>* sc = begin; sc != end; sc++) {
+            if (sc == begin || sc->source != (sc - 1)->source) {
+                index++;
+                deduped_sources[index] =
+                        SourceCountHits<int>(sc->source, sc->count, 1);
+            } else {
+                deduped_sources[index].hits++;
+            }
+        }
+        dye_tracks_out->push_back(
+                move(SourcedData<DyeTrack, SourceCountHitsList<int>>(
+                        move((*dye_tracks_in)[first_members[g]].value),
+                        move(SourceCountHitsList<int>(num_sources,
+                                                      deduped_sources)))));
     }
-    dye_tracks->push_back(move(SourcedData<DyeTrack, SourceCountHitsList<int>>(
-            move(DyeTrack(num_timesteps, num_channels, counts)),
-            move(SourceCountHitsList<int>(num_sources, sources)))));
 }
 
 }  // namespace whatprot
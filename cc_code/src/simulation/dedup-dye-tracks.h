@@ -10,18 +10,25 @@
 #define WHATPROT_SIMULATION_DEDUP_DYE_TRACKS_H
 
 // Standard C++ library headers:
-#include <unordered_map>
+#include <cstddef>
 #include <vector>
 
-// External headers:
-#include "keyvalue.h"
-
 // Local project headers:
 #include "common/dye-track.h"
 #include "common/sourced-data.h"
 
 namespace whatprot {
 
+// Combines the dye tracks of dye_tracks_in which have the same counts into one
+// dye track of dye_tracks_out, which has a SourceCountHits for every source
+// that gave it, with hits being the number of times that source gave it. The
+// counts of dye_tracks_in are moved out of.
+//
+// The dye tracks are split into shards by the hash of their counts, so that
+// every copy of a dye track is in the same shard, and the shards are deduped
+// in parallel. The output is the same for any number of threads: the dye
+// tracks of each shard are in the order they first appear in dye_tracks_in,
+// and the sources of each dye track are in increasing order.
 void dedup_dye_tracks(
         unsigned int num_timesteps,
         unsigned int num_channels,
@@ -29,36 +36,18 @@ void dedup_dye_tracks(
         std::vector<SourcedData<DyeTrack, SourceCountHitsList<int>>>*
                 dye_tracks_out);
 
-void map_dye_tracks(int index, MAPREDUCE_NS::KeyValue* kv, void* ptr);
-
-void reduce_dye_tracks(char* key,
-                       int keybytes,
-                       char* multivalue,
-                       int nvalues,
-                       int* valuebytes,
-                       MAPREDUCE_NS::KeyValue* kv,
-                       void* ptr);
-
-void reduce_dye_tracks_helper(
-        char* multivalue,
-        int nvalues,
-        std::unordered_map<int, SourceCountHits<int>>* source_map);
-
-class OutputInfo {
-public:
-    OutputInfo(unsigned int num_timesteps,
-               unsigned int num_channels,
-               std::vector<SourcedData<DyeTrack, SourceCountHitsList<int>>>*
-                       dye_tracks_out);
-    unsigned int num_timesteps;
-    unsigned int num_channels;
-    std::vector<SourcedData<DyeTrack,
-                            SourceCountHitsList<int>>>*
-            dye_tracks_out;  // not ownd
-};
-
-void output_dye_tracks(
-        char* key, int keybytes, char* value, int valuebytes, void* ptr);
+// Dedups one shard for dedup_dye_tracks(). The indices into dye_tracks_in of
+// the dye tracks of the shard are given by thread_shards[t][shard] for every
+// thread t, which are cleared. Every index of thread t must be before every
+// index of thread t + 1, and hashes[i] must be the hash of the counts of
+// (*dye_tracks_in)[i].
+void dedup_dye_tracks_shard(
+        unsigned int shard,
+        const std::vector<std::size_t>& hashes,
+        std::vector<std::vector<std::vector<unsigned int>>>* thread_shards,
+        std::vector<SourcedData<DyeTrack, SourceCount<int>>>* dye_tracks_in,
+        std::vector<SourcedData<DyeTrack, SourceCountHitsList<int>>>*
+                dye_tracks_out);
 
 }  // namespace whatprot
 
@@ -0,0 +1,236 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+// Boost unit test framework (recommended to be the first include):
+#include <boost/test/unit_test.hpp>
+
+// File under test:
+#include "dedup-dye-tracks.h"
+
+// Standard C++ library headers:
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <utility>
+#include <vector>
+
+// OpenMP
+#include <omp.h>
+
+// Local project headers:
+#include "common/dye-track.h"
+#include "common/sourced-data.h"
+
+namespace whatprot {
+
+namespace {
+using std::hash;
+using std::map;
+using std::pair;
+using std::size_t;
+using std::vector;
+
+// The dye track of two timesteps and two channels whose counts are the base 7
+// digits of k.
+DyeTrack make_dye_track(int k) {
+    DyeTrack dye_track(2, 2);
+    for (int j = 0; j < 4; j++) {
+        dye_track.counts[j] = k % 7;
+        k /= 7;
+    }
+    return dye_track;
+}
+
+// num_dye_tracks dye tracks, of num_distinct distinct dye tracks. Dye track i
+// is make_dye_track((i * 13) % num_distinct), from source (i * 3) % 5, with a
+// count of 10 more than its source.
+void make_dye_tracks(
+        int num_dye_tracks,
+        int num_distinct,
+        vector<SourcedData<DyeTrack, SourceCount<int>>>* dye_tracks) {
+    for (int i = 0; i < num_dye_tracks; i++) {
+        int source = (i * 3) % 5;
+        dye_tracks->push_back(SourcedData<DyeTrack, SourceCount<int>>(
+                make_dye_track((i * 13) % num_distinct),
+                SourceCount<int>(source, 10 + source)));
+    }
+}
+
+// What dedup_dye_tracks() should give for the dye tracks of make_dye_tracks():
+// the hits of each source of each dye track, and the dye tracks in the order
+// they first appear.
+void expected_dedup(int num_dye_tracks,
+                    int num_distinct,
+                    map<vector<short>, map<int, int>>* hits,
+                    vector<vector<short>>* order) {
+    for (int i = 0; i < num_dye_tracks; i++) {
+        vector<short> counts =
+                make_dye_track((i * 13) % num_distinct).counts;
+        if (hits->count(counts) == 0) {
+            order->push_back(counts);
+        }
+        (*hits)[counts][(i * 3) % 5]++;
+    }
+}
+
+// Checks that every dye track of dye_tracks_out is distinct, has the sources
+// and hits of expected_hits in increasing order of source, and that together
+// they are all of expected_hits.
+void check_dedup(
+        const map<vector<short>, map<int, int>>& expected_hits,
+        const vector<SourcedData<DyeTrack, SourceCountHitsList<int>>>&
+                dye_tracks_out) {
+    BOOST_TEST(dye_tracks_out.size() == expected_hits.size());
+    map<vector<short>, int> seen;
+    for (const auto& dye_track : dye_tracks_out) {
+        const vector<short>& counts = dye_track.value.counts;
+        BOOST_TEST(seen[counts]++ == 0);
+        BOOST_REQUIRE(expected_hits.count(counts) == 1u);
+        const map<int, int>& sources = expected_hits.at(counts);
+        const SourceCountHitsList<int>& list = dye_track.source;
+        BOOST_REQUIRE(list.num_sources == (int)sources.size());
+        map<int, int>::const_iterator it = sources.begin();
+        for (int s = 0; s < list.num_sources; s++, it++) {
+            BOOST_TEST(list.sources[s].source == it->first);
+            BOOST_TEST(list.sources[s].count == 10 + it->first);
+            BOOST_TEST(list.sources[s].hits == it->second);
+        }
+    }
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(simulation_suite)
+BOOST_AUTO_TEST_SUITE(dedup_dye_tracks_suite)
+
+BOOST_AUTO_TEST_CASE(dedup_test) {
+    int num_dye_tracks = 5000;
+    int num_distinct = 700;
+    vector<SourcedData<DyeTrack, SourceCount<int>>> dye_tracks_in;
+    make_dye_tracks(num_dye_tracks, num_distinct, &dye_tracks_in);
+    vector<SourcedData<DyeTrack, SourceCountHitsList<int>>> dye_tracks_out;
+    dedup_dye_tracks(2, 2, &dye_tracks_in, &dye_tracks_out);
+    map<vector<short>, map<int, int>> expected_hits;
+    vector<vector<short>> order;
+    expected_dedup(num_dye_tracks, num_distinct, &expected_hits, &order);
+    check_dedup(expected_hits, dye_tracks_out);
+    // The dye tracks are grouped by shard, in order, and within each shard
+    // are in the order they first appear.
+    hash<DyeTrack> dye_track_hash;
+    vector<vector<vector<short>>> shards(256);
+    for (const vector<short>& counts : order) {
+        DyeTrack dye_track(2, 2);
+        dye_track.counts = counts;
+        shards[dye_track_hash(dye_track) % 256].push_back(counts);
+    }
+    vector<vector<short>> expected_order;
+    for (const vector<vector<short>>& shard : shards) {
+        expected_order.insert(expected_order.end(), shard.begin(), shard.end());
+    }
+    BOOST_REQUIRE(dye_tracks_out.size() == expected_order.size());
+    bool same_order = true;
+    for (unsigned int i = 0; i < expected_order.size(); i++) {
+        same_order = same_order
+                     && dye_tracks_out[i].value.counts == expected_order[i];
+    }
+    BOOST_TEST(same_order);
+}
+
+BOOST_AUTO_TEST_CASE(appends_test) {
+    vector<SourcedData<DyeTrack, SourceCount<int>>> dye_tracks_in;
+    make_dye_tracks(10, 4, &dye_tracks_in);
+    vector<SourcedData<DyeTrack, SourceCountHitsList<int>>> dye_tracks_out;
+    SourceCountHits<int>* sources = new SourceCountHits<int>[1];
+    sources[0] = SourceCountHits<int>(42, 1, 1);
+    dye_tracks_out.push_back(SourcedData<DyeTrack, SourceCountHitsList<int>>(
+            make_dye_track(1000), SourceCountHitsList<int>(1, sources)));
+    dedup_dye_tracks(2, 2, &dye_tracks_in, &dye_tracks_out);
+    BOOST_REQUIRE(dye_tracks_out.size() == 5u);
+    BOOST_TEST(dye_tracks_out[0].value.counts == make_dye_track(1000).counts);
+    BOOST_TEST(dye_tracks_out[0].source.sources[0].source == 42);
+}
+
+BOOST_AUTO_TEST_CASE(threads_test) {
+    int num_dye_tracks = 5000;
+    int num_distinct = 700;
+    vector<SourcedData<DyeTrack, SourceCount<int>>> serial_in;
+    make_dye_tracks(num_dye_tracks, num_distinct, &serial_in);
+    vector<SourcedData<DyeTrack, SourceCount<int>>> parallel_in;
+    make_dye_tracks(num_dye_tracks, num_distinct, &parallel_in);
+    vector<SourcedData<DyeTrack, SourceCountHitsList<int>>> serial_out;
+    vector<SourcedData<DyeTrack, SourceCountHitsList<int>>> parallel_out;
+    int max_threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    dedup_dye_tracks(2, 2, &serial_in, &serial_out);
+    // More threads than the machine may have, so that each thread gets part
+    // of the dye tracks of most shards.
+    omp_set_num_threads(4);
+    dedup_dye_tracks(2, 2, &parallel_in, &parallel_out);
+    omp_set_num_threads(max_threads);
+    // Each shard takes its indices from the threads in thread order, which
+    // is the order of the input, so the distinct dye tracks come out in the
+    // same order with the same sources however the input was split.
+    BOOST_REQUIRE(parallel_out.size() == serial_out.size());
+    bool same = true;
+    for (unsigned int i = 0; i < serial_out.size(); i++) {
+        const SourceCountHitsList<int>& a = serial_out[i].source;
+        const SourceCountHitsList<int>& b = parallel_out[i].source;
+        same = same && serial_out[i].value == parallel_out[i].value
+               && a.num_sources == b.num_sources;
+        for (int s = 0; same && s < a.num_sources; s++) {
+            same = a.sources[s].source == b.sources[s].source
+                   && a.sources[s].count == b.sources[s].count
+                   && a.sources[s].hits == b.sources[s].hits;
+        }
+    }
+    BOOST_TEST(same);
+}
+
+BOOST_AUTO_TEST_CASE(shard_colliding_hashes_test) {
+    // Every dye track of the shard has the same hash, so every distinct dye
+    // track after the first is found by probing past all of those before it,
+    // and the table has to be sized up well past its smallest size to hold
+    // them all.
+    int num_dye_tracks = 3000;
+    int num_distinct = 500;
+    vector<SourcedData<DyeTrack, SourceCount<int>>> dye_tracks_in;
+    make_dye_tracks(num_dye_tracks, num_distinct, &dye_tracks_in);
+    vector<size_t> hashes(num_dye_tracks, 7);
+    // Two threads, each with half of the dye tracks, in order.
+    vector<vector<vector<unsigned int>>> thread_shards(
+            2, vector<vector<unsigned int>>(1));
+    for (int i = 0; i < num_dye_tracks; i++) {
+        thread_shards[2 * i / num_dye_tracks][0].push_back(i);
+    }
+    vector<SourcedData<DyeTrack, SourceCountHitsList<int>>> dye_tracks_out;
+    dedup_dye_tracks_shard(
+            0, hashes, &thread_shards, &dye_tracks_in, &dye_tracks_out);
+    BOOST_TEST(thread_shards[0][0].empty());
+    BOOST_TEST(thread_shards[1][0].empty());
+    map<vector<short>, map<int, int>> expected_hits;
+    vector<vector<short>> order;
+    expected_dedup(num_dye_tracks, num_distinct, &expected_hits, &order);
+    check_dedup(expected_hits, dye_tracks_out);
+    BOOST_REQUIRE(dye_tracks_out.size() == order.size());
+    bool same_order = true;
+    for (unsigned int i = 0; i < order.size(); i++) {
+        same_order = same_order && dye_tracks_out[i].value.counts == order[i];
+    }
+    BOOST_TEST(same_order);
+}
+
+BOOST_AUTO_TEST_CASE(empty_test) {
+    vector<SourcedData<DyeTrack, SourceCount<int>>> dye_tracks_in;
+    vector<SourcedData<DyeTrack, SourceCountHitsList<int>>> dye_tracks_out;
+    dedup_dye_tracks(2, 2, &dye_tracks_in, &dye_tracks_out);
+    BOOST_TEST(dye_tracks_out.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // dedup_dye_tracks_suite
+BOOST_AUTO_TEST_SUITE_END()  // simulation_suite
+
+}  // namespace whatprot
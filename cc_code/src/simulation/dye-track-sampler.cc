@@ -0,0 +1,153 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+// Defining symbols from header:
+#include "dye-track-sampler.h"
+
+// Standard C++ library headers:
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Local project headers:
+#include "common/dye-seq.h"
+#include "common/dye-track.h"
+#include "parameterization/model/sequencing-model.h"
+#include "util/philox.h"
+
+namespace whatprot {
+
+namespace {
+using std::fill;
+using std::log;
+using std::min;
+using std::upper_bound;
+using std::vector;
+}  // namespace
+
+DyeTrackSampler::DyeTrackSampler(const SequencingModel& seq_model,
+                                 unsigned int num_timesteps,
+                                 unsigned int num_channels)
+        : num_timesteps(num_timesteps),
+          num_channels(num_channels),
+          p_initial_block(seq_model.p_initial_block),
+          log_p_edman_failure(log(seq_model.p_edman_failure)),
+          log_p_no_cyclic_block(log(1.0 - seq_model.p_cyclic_block)) {
+    for (unsigned int c = 0; c < num_channels; c++) {
+        p_dud.push_back(seq_model.channel_models[c]->p_dud);
+        log_p_no_bleach.push_back(
+                log(1.0 - seq_model.channel_models[c]->p_bleach));
+    }
+    double p_attached = 1.0;
+    for (unsigned int t = 0; t < num_timesteps; t++) {
+        p_attached *= 1.0 - seq_model.p_detach[t];
+        detach_cdf.push_back(1.0 - p_attached);
+    }
+}
+
+void DyeTrackSampler::sample(const DyeSeq& dye_seq,
+                             unsigned int num_replicates,
+                             Philox* generator,
+                             vector<DyeTrack>* dye_tracks) const {
+    // For each dye which is not a dud: its channel, and the last timestep at
+    // which it is counted.
+    vector<short> channels(dye_seq.length);
+    vector<unsigned int> lasts(dye_seq.length);
+    // The number of dyes of each channel counted for the last time at each
+    // timestep, indexed as in a DyeTrack.
+    vector<short> ends(num_timesteps * num_channels);
+    for (unsigned int r = 0; r < num_replicates; r++) {
+        // Duds. The Edman degradations remove positions, not dyes, so the
+        // position of each dye is kept.
+        unsigned int num_dyes = 0;
+        for (unsigned int i = 0; i < dye_seq.length; i++) {
+            short c = dye_seq[i];
+            if (c != -1 && uniform(generator) > p_dud[c]) {
+                channels[num_dyes] = c;
+                lasts[num_dyes] = i;
+                num_dyes++;
+            }
+        }
+        if (num_dyes == 0) {
+            continue;
+        }
+        // Detachment. The peptide is last counted at the timestep it
+        // detaches, and there is nothing to count after the last timestep.
+        unsigned int detach = upper_bound(detach_cdf.begin(),
+                                          detach_cdf.end(),
+                                          1.0 - uniform(generator))
+                              - detach_cdf.begin();
+        unsigned int last = min(detach, num_timesteps - 1);
+        // Blocking. There are no Edman degradations from the timestep at which
+        // the peptide is blocked, nor from the timestep at which it detaches.
+        unsigned int block = 0;
+        if (uniform(generator) > p_initial_block) {
+            block = geometric(log_p_no_cyclic_block, generator);
+        }
+        unsigned int edman_end = min(block, detach);
+        // Edman degradations. Position i is removed by the (i + 1)th
+        // successful one, so it is last counted at the timestep of that one.
+        // Positions of duds are removed too, so i walks every position, while
+        // next_dye walks the dyes.
+        unsigned int next_dye = 0;
+        unsigned int t = geometric(log_p_edman_failure, generator);
+        for (unsigned int i = 0; t < edman_end && next_dye < num_dyes; i++) {
+            if (lasts[next_dye] == i) {
+                lasts[next_dye] = t;
+                next_dye++;
+            }
+            t += 1 + geometric(log_p_edman_failure, generator);
+        }
+        // Dyes from next_dye on are never removed by an Edman degradation.
+        for (unsigned int d = next_dye; d < num_dyes; d++) {
+            lasts[d] = last;
+        }
+        // Bleaching.
+        for (unsigned int d = 0; d < num_dyes; d++) {
+            unsigned int bleach =
+                    geometric(log_p_no_bleach[channels[d]], generator);
+            lasts[d] = min(min(lasts[d], bleach), last);
+        }
+        // A dye is counted at every timestep up to its last, so the counts at
+        // each timestep are the dyes last counted at that timestep or later.
+        fill(ends.begin(), ends.end(), 0);
+        for (unsigned int d = 0; d < num_dyes; d++) {
+            ends[lasts[d] * num_channels + channels[d]]++;
+        }
+        dye_tracks->emplace_back(num_timesteps, num_channels);
+        short* counts = &dye_tracks->back().counts[0];
+        int end = num_timesteps * num_channels;
+        for (int i = end - 1; i >= end - (int)num_channels; i--) {
+            counts[i] = ends[i];
+        }
+        for (int i = end - num_channels - 1; i >= 0; i--) {
+            counts[i] = counts[i + num_channels] + ends[i];
+        }
+    }
+}
+
+double DyeTrackSampler::uniform(Philox* generator) const {
+    return ((double)(*generator)() + 1.0) * (1.0 / 4294967296.0);
+}
+
+unsigned int DyeTrackSampler::geometric(double log_p_fail,
+                                        Philox* generator) const {
+    // Inversion: the number of failures is the floor of log(u) / log(p_fail)
+    // for u uniform in (0, 1]. If every trial fails, this is infinite, and if
+    // every trial succeeds, it is zero (log(u) / -infinity).
+    if (log_p_fail >= 0.0) {
+        return num_timesteps;
+    }
+    double x = log(uniform(generator)) / log_p_fail;
+    if (x >= (double)num_timesteps) {
+        return num_timesteps;
+    }
+    return (unsigned int)x;
+}
+
+}  // namespace whatprot
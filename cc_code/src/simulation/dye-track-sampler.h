@@ -0,0 +1,76 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+#ifndef WHATPROT_SIMULATION_DYE_TRACK_SAMPLER_H
+#define WHATPROT_SIMULATION_DYE_TRACK_SAMPLER_H
+
+// Standard C++ library headers:
+#include <vector>
+
+// Local project headers:
+#include "common/dye-seq.h"
+#include "common/dye-track.h"
+#include "parameterization/model/sequencing-model.h"
+#include "util/philox.h"
+
+namespace whatprot {
+
+// Simulates dye tracks from the same model as generate_dye_track(), but draws
+// the time of each event instead of asking at every timestep whether it
+// happens. Each event of the model happens at most once to each dye or
+// peptide, and the chances at each timestep are independent, so the timestep
+// of an event can be drawn all at once:
+//   * a dye is bleached at the end of a geometrically distributed timestep,
+//   * the peptide is blocked before the Edman degradation of a geometrically
+//     distributed timestep (or the first, if it was blocked to begin with),
+//   * the gaps between successful Edman degradations are geometric,
+//   * and the peptide detaches at a timestep drawn from the distribution given
+//     by p_detach, which can change with the timestep.
+// A dye is counted at every timestep up to the first of the bleaching of the
+// dye, the Edman degradation which removes it, and the detachment of the
+// peptide. This takes a few random numbers for each dye, where
+// generate_dye_track() takes a few for each dye at every timestep. The
+// distribution of the dye tracks is the same, but not the dye tracks given by
+// any particular stream of random numbers.
+class DyeTrackSampler {
+public:
+    DyeTrackSampler(const SequencingModel& seq_model,
+                    unsigned int num_timesteps,
+                    unsigned int num_channels);
+
+    // Simulates num_replicates dye tracks of dye_seq, and appends those which
+    // would be visible to dye_tracks. A dye track is not visible if every dye
+    // was a dud, so that it is all zeros.
+    void sample(const DyeSeq& dye_seq,
+                unsigned int num_replicates,
+                Philox* generator,
+                std::vector<DyeTrack>* dye_tracks) const;
+
+    // Uniform in (0, 1].
+    double uniform(Philox* generator) const;
+
+    // The number of failures before the first success of a series of trials,
+    // each failing with a probability of exp(log_p_fail), as with
+    // std::geometric_distribution. Anything larger than num_timesteps is given
+    // as num_timesteps, which is never the timestep of an event.
+    unsigned int geometric(double log_p_fail, Philox* generator) const;
+
+    unsigned int num_timesteps;
+    unsigned int num_channels;
+    double p_initial_block;
+    double log_p_edman_failure;
+    double log_p_no_cyclic_block;
+    std::vector<double> p_dud;  // for each channel.
+    std::vector<double> log_p_no_bleach;  // for each channel.
+    // Chance that the peptide has detached by the end of each timestep.
+    std::vector<double> detach_cdf;
+};
+
+}  // namespace whatprot
+
+#endif  // WHATPROT_SIMULATION_DYE_TRACK_SAMPLER_H
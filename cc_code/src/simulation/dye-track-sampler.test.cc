@@ -0,0 +1,186 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+// Boost unit test framework (recommended to be the first include):
+#include <boost/test/unit_test.hpp>
+
+// File under test:
+#include "dye-track-sampler.h"
+
+// Standard C++ library headers:
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+
+// Local project headers:
+#include "common/dye-seq.h"
+#include "common/dye-track.h"
+#include "parameterization/model/sequencing-model.h"
+#include "simulation/generate-dye-track.h"
+#include "util/philox.h"
+
+namespace whatprot {
+
+namespace {
+using std::abs;
+using std::log;
+using std::map;
+using std::pow;
+using std::string;
+using std::vector;
+
+// Two channels, with rates high enough that every kind of event happens often
+// in a few timesteps.
+SequencingModel test_seq_model() {
+    SequencingModel seq_model(2);
+    seq_model.p_edman_failure = 0.2;
+    seq_model.p_detach.base = 0.05;
+    seq_model.p_detach.initial = 0.1;
+    seq_model.p_detach.initial_decay = 0.5;
+    seq_model.p_initial_block = 0.1;
+    seq_model.p_cyclic_block = 0.05;
+    seq_model.channel_models[0]->p_dud = 0.1;
+    seq_model.channel_models[0]->p_bleach = 0.1;
+    seq_model.channel_models[1]->p_dud = 0.2;
+    seq_model.channel_models[1]->p_bleach = 0.15;
+    return seq_model;
+}
+
+// Nothing can go wrong, so every dye is removed by its Edman degradation.
+SequencingModel perfect_seq_model() {
+    SequencingModel seq_model(2);
+    seq_model.p_edman_failure = 0.0;
+    seq_model.p_detach.base = 0.0;
+    seq_model.p_detach.initial = 0.0;
+    seq_model.p_detach.initial_decay = 1.0;
+    seq_model.p_initial_block = 0.0;
+    seq_model.p_cyclic_block = 0.0;
+    for (unsigned int c = 0; c < 2; c++) {
+        seq_model.channel_models[c]->p_dud = 0.0;
+        seq_model.channel_models[c]->p_bleach = 0.0;
+    }
+    return seq_model;
+}
+
+bool is_visible(const DyeTrack& dye_track) {
+    for (short count : dye_track.counts) {
+        if (count != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(simulation_suite)
+BOOST_AUTO_TEST_SUITE(dye_track_sampler_suite)
+
+BOOST_AUTO_TEST_CASE(perfect_test) {
+    SequencingModel seq_model = perfect_seq_model();
+    DyeSeq dye_seq(2, "01.1");
+    DyeTrackSampler sampler(seq_model, 5, 2);
+    Philox generator(0x5eed, 0);
+    vector<DyeTrack> dye_tracks;
+    sampler.sample(dye_seq, 3, &generator, &dye_tracks);
+    DyeTrack expected(5, 2);
+    short counts[] = {1, 2, 0, 2, 0, 1, 0, 1, 0, 0};
+    for (int i = 0; i < 10; i++) {
+        expected.counts[i] = counts[i];
+    }
+    BOOST_REQUIRE(dye_tracks.size() == 3u);
+    for (const DyeTrack& dye_track : dye_tracks) {
+        BOOST_TEST((dye_track == expected));
+    }
+    DyeTrack generated(5, 2);
+    generate_dye_track(seq_model, dye_seq, 5, 2, &generator, &generated);
+    BOOST_TEST((generated == expected));
+}
+
+BOOST_AUTO_TEST_CASE(all_duds_test) {
+    SequencingModel seq_model = test_seq_model();
+    seq_model.channel_models[0]->p_dud = 1.0;
+    seq_model.channel_models[1]->p_dud = 1.0;
+    DyeTrackSampler sampler(seq_model, 5, 2);
+    Philox generator(0x5eed, 0);
+    vector<DyeTrack> dye_tracks;
+    sampler.sample(DyeSeq(2, "01.1"), 100, &generator, &dye_tracks);
+    // Dye tracks which would not be visible are left out.
+    BOOST_TEST(dye_tracks.empty());
+}
+
+BOOST_AUTO_TEST_CASE(geometric_test) {
+    SequencingModel seq_model = test_seq_model();
+    DyeTrackSampler sampler(seq_model, 5, 2);
+    Philox generator(0x5eed, 0);
+    // Never failing is never waiting, and always failing is waiting forever.
+    BOOST_TEST(sampler.geometric(log(0.0), &generator) == 0u);
+    BOOST_TEST(sampler.geometric(0.0, &generator) == 5u);
+    // With trials failing half the time, about half wait for none, a quarter
+    // for one, and so on, and anything from 5 on is given as 5.
+    int num_samples = 100000;
+    vector<int> counts(6, 0);
+    for (int i = 0; i < num_samples; i++) {
+        unsigned int x = sampler.geometric(log(0.5), &generator);
+        BOOST_REQUIRE(x <= 5u);
+        counts[x]++;
+    }
+    for (int x = 0; x < 5; x++) {
+        double frequency = (double)counts[x] / num_samples;
+        BOOST_TEST(abs(frequency - pow(0.5, x + 1)) < 0.01);
+    }
+    BOOST_TEST(abs((double)counts[5] / num_samples - 0.03125) < 0.01);
+}
+
+BOOST_AUTO_TEST_CASE(matches_generate_dye_track_test) {
+    SequencingModel seq_model = test_seq_model();
+    vector<string> dye_seq_strings = {"01.1", "1.10."};
+    for (const string& dye_seq_string : dye_seq_strings) {
+        DyeSeq dye_seq(2, dye_seq_string);
+        int num_samples = 200000;
+        DyeTrackSampler sampler(seq_model, 5, 2);
+        Philox sampler_generator(0x5eed, 0);
+        vector<DyeTrack> sampled;
+        sampler.sample(dye_seq, num_samples, &sampler_generator, &sampled);
+        map<vector<short>, int> sampled_counts;
+        for (const DyeTrack& dye_track : sampled) {
+            BOOST_TEST(is_visible(dye_track));
+            sampled_counts[dye_track.counts]++;
+        }
+        Philox generator(0x5eed, 1);
+        map<vector<short>, int> generated_counts;
+        for (int i = 0; i < num_samples; i++) {
+            DyeTrack dye_track(5, 2);
+            generate_dye_track(
+                    seq_model, dye_seq, 5, 2, &generator, &dye_track);
+            if (is_visible(dye_track)) {
+                generated_counts[dye_track.counts]++;
+            }
+        }
+        // The standard deviation of the difference of two frequencies is at
+        // most sqrt(2) * 0.5 / sqrt(200000), or about 0.0016, so this is
+        // about five of them.
+        for (const auto& entry : sampled_counts) {
+            double difference = (double)entry.second / num_samples
+                                - (double)generated_counts[entry.first]
+                                          / num_samples;
+            BOOST_TEST(abs(difference) < 0.008);
+        }
+        for (const auto& entry : generated_counts) {
+            double difference = (double)entry.second / num_samples
+                                - (double)sampled_counts[entry.first]
+                                          / num_samples;
+            BOOST_TEST(abs(difference) < 0.008);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // dye_track_sampler_suite
+BOOST_AUTO_TEST_SUITE_END()  // simulation_suite
+
+}  // namespace whatprot
@@ -0,0 +1,478 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+// Defining symbols from header:
+#include "enumerate-dye-tracks.h"
+
+// Standard C++ library headers:
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>  // for std::move
+#include <vector>
+
+// Local project headers:
+#include "common/dye-seq.h"
+#include "common/dye-track.h"
+#include "common/sourced-data.h"
+#include "parameterization/model/sequencing-model.h"
+#include "util/vector-hash.h"
+
+namespace whatprot {
+
+namespace {
+using std::llround;
+using std::move;
+using std::pair;
+using std::pow;
+using std::uint64_t;
+using std::unordered_map;
+using std::vector;
+
+// Probabilities of keys, which are kept in the order they were first added,
+// so that going through them is deterministic.
+template <typename K>
+class Distribution {
+public:
+    void add(const K& key, double p) {
+        typename unordered_map<K, unsigned int>::iterator it =
+                indices.find(key);
+        if (it == indices.end()) {
+            indices[key] = keys.size();
+            keys.push_back(key);
+            probabilities.push_back(p);
+        } else {
+            probabilities[it->second] += p;
+        }
+    }
+
+    unordered_map<K, unsigned int> indices;
+    vector<K> keys;
+    vector<double> probabilities;
+};
+
+// The same as a Distribution<uint64_t>, but with a hash table with open
+// addressing, which is much faster for the many pairs of a node and a state.
+// Each slot of the table is one more than the index of its key, or 0 if it is
+// empty. The table is kept at least twice as big as the number of keys.
+class PackedDistribution {
+public:
+    PackedDistribution() : slots(16, 0), shift(60) {}
+
+    void add(uint64_t key, double p) {
+        unsigned int slot = find(key);
+        if (slots[slot] == 0) {
+            keys.push_back(key);
+            probabilities.push_back(p);
+            slots[slot] = keys.size();
+            if (2 * keys.size() > slots.size()) {
+                grow();
+            }
+        } else {
+            probabilities[slots[slot] - 1] += p;
+        }
+    }
+
+    // The slot of key, or the empty slot where it would go.
+    unsigned int find(uint64_t key) const {
+        unsigned int mask = slots.size() - 1;
+        unsigned int slot = (key * 0x9E3779B97F4A7C15) >> shift;
+        while (slots[slot] != 0 && keys[slots[slot] - 1] != key) {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    void grow() {
+        slots.assign(2 * slots.size(), 0);
+        shift--;
+        for (unsigned int i = 0; i < keys.size(); i++) {
+            slots[find(keys[i])] = i + 1;
+        }
+    }
+
+    vector<unsigned int> slots;
+    int shift;  // 64 less the log base 2 of the size of the table.
+    vector<uint64_t> keys;
+    vector<double> probabilities;
+};
+
+uint64_t pack(unsigned int high, unsigned int low) {
+    return ((uint64_t)high << 32) | low;
+}
+
+double binomial_pmf(unsigned int n, unsigned int k, double p) {
+    double coefficient = 1.0;
+    for (unsigned int i = 0; i < k; i++) {
+        coefficient = coefficient * (double)(n - i) / (double)(i + 1);
+    }
+    return coefficient * pow(p, k) * pow(1.0 - p, n - k);
+}
+
+// Adds every way that the dyes of state could each survive with the chance
+// for their channel, from channel c on, to out. The dye counts of the
+// channels start at index 2 of state. The state is changed while working, but
+// is the same at the end.
+void add_thinned(vector<short>* state,
+                 unsigned int c,
+                 const vector<double>& p_survive,
+                 double p,
+                 Distribution<vector<short>>* out) {
+    if (c == p_survive.size()) {
+        out->add(*state, p);
+        return;
+    }
+    short n = (*state)[2 + c];
+    for (short k = 0; k <= n; k++) {
+        (*state)[2 + c] = k;
+        add_thinned(state,
+                    c + 1,
+                    p_survive,
+                    p * binomial_pmf(n, k, p_survive[c]),
+                    out);
+    }
+    (*state)[2 + c] = n;
+}
+
+// The states of the Markov chain of enumerate_dye_seq_dye_tracks(). Each is
+// the number of successful Edman degradations, whether the peptide is
+// blocked, and the number of dyes of each channel, and they are numbered in
+// the order they are found. The transitions out of a state, other than
+// detachment, are the same at every timestep, so they are worked out once,
+// the first time they are needed.
+class StateTable {
+public:
+    StateTable(const SequencingModel& seq_model,
+               const DyeSeq& dye_seq,
+               unsigned int num_channels)
+            : dye_seq(dye_seq),
+              num_channels(num_channels),
+              p_edman_failure(seq_model.p_edman_failure),
+              p_cyclic_block(seq_model.p_cyclic_block) {
+        for (unsigned int c = 0; c < num_channels; c++) {
+            p_not_bleached.push_back(1.0
+                                     - seq_model.channel_models[c]->p_bleach);
+        }
+        // remaining[e * num_channels + c] is the number of positions of
+        // channel c from position e on, which is the number of dyes of that
+        // channel left after e successful Edman degradations if there are no
+        // duds or bleaching.
+        remaining.resize((dye_seq.length + 1) * num_channels, 0);
+        for (int e = (int)dye_seq.length - 1; e >= 0; e--) {
+            for (unsigned int c = 0; c < num_channels; c++) {
+                remaining[e * num_channels + c] =
+                        remaining[(e + 1) * num_channels + c];
+            }
+            if (dye_seq[e] != -1) {
+                remaining[e * num_channels + dye_seq[e]]++;
+            }
+        }
+    }
+
+    unsigned int id(const vector<short>& state) {
+        unordered_map<vector<short>, unsigned int>::iterator it =
+                ids.find(state);
+        if (it != ids.end()) {
+            return it->second;
+        }
+        unsigned int new_id = states.size();
+        ids[state] = new_id;
+        states.push_back(state);
+        // The dye counts are also numbered, so that the dye track can be
+        // recorded with one number for each timestep.
+        vector<short> counts(state.begin() + 2, state.end());
+        it = count_ids.find(counts);
+        if (it == count_ids.end()) {
+            count_ids[counts] = all_counts.size();
+            state_counts.push_back(all_counts.size());
+            all_counts.push_back(counts);
+        } else {
+            state_counts.push_back(it->second);
+        }
+        has_transitions.push_back(false);
+        transitions.push_back(vector<pair<unsigned int, double>>());
+        return new_id;
+    }
+
+    // The next states and their probabilities, given that the peptide does
+    // not detach.
+    const vector<pair<unsigned int, double>>& next(unsigned int id) {
+        if (has_transitions[id]) {
+            return transitions[id];
+        }
+        // Copied because numbering the next states can move states.
+        vector<short> state = states[id];
+        short edmans = state[0];
+        bool blocked = state[1];
+        Distribution<vector<short>> next_states;
+        for (short block = blocked; block <= 1; block++) {
+            double p_block = 1.0;
+            if (!blocked) {
+                p_block = block ? p_cyclic_block : 1.0 - p_cyclic_block;
+            }
+            state[0] = edmans;
+            state[1] = block;
+            // Edman degradation, then bleaching.
+            if (block) {
+                add_thinned(&state, 0, p_not_bleached, p_block, &next_states);
+                continue;
+            }
+            add_thinned(&state,
+                        0,
+                        p_not_bleached,
+                        p_block * p_edman_failure,
+                        &next_states);
+            double p_edman = p_block * (1.0 - p_edman_failure);
+            state[0] = edmans + 1;
+            short c = dye_seq[edmans];
+            if (c == -1) {
+                add_thinned(&state, 0, p_not_bleached, p_edman, &next_states);
+                continue;
+            }
+            // The dye at this position is there with the chance that any
+            // particular position of its channel still has its dye, as in
+            // EdmanTransition.
+            short count = state[2 + c];
+            short total = remaining[edmans * num_channels + c];
+            double p_removed = (double)count / (double)total;
+            if (count < total) {
+                add_thinned(&state,
+                            0,
+                            p_not_bleached,
+                            p_edman * (1.0 - p_removed),
+                            &next_states);
+            }
+            if (count > 0) {
+                state[2 + c]--;
+                add_thinned(&state,
+                            0,
+                            p_not_bleached,
+                            p_edman * p_removed,
+                            &next_states);
+                state[2 + c]++;
+            }
+        }
+        vector<pair<unsigned int, double>> result;
+        for (unsigned int i = 0; i < next_states.keys.size(); i++) {
+            result.push_back(pair<unsigned int, double>(
+                    this->id(next_states.keys[i]),
+                    next_states.probabilities[i]));
+        }
+        transitions[id] = move(result);
+        has_transitions[id] = true;
+        return transitions[id];
+    }
+
+    const DyeSeq& dye_seq;
+    unsigned int num_channels;
+    double p_edman_failure;
+    double p_cyclic_block;
+    vector<double> p_not_bleached;
+    vector<short> remaining;
+    unordered_map<vector<short>, unsigned int> ids;
+    vector<vector<short>> states;
+    vector<unsigned int> state_counts;  // index into all_counts.
+    unordered_map<vector<short>, unsigned int> count_ids;
+    vector<vector<short>> all_counts;
+    vector<bool> has_transitions;
+    vector<vector<pair<unsigned int, double>>> transitions;
+};
+}  // namespace
+
+void enumerate_dye_tracks(
+        const SequencingModel& seq_model,
+        const vector<SourcedData<DyeSeq, SourceCount<int>>>& dye_seqs,
+        unsigned int num_timesteps,
+        unsigned int num_channels,
+        unsigned int dye_tracks_per_peptide,
+        vector<SourcedData<DyeTrack, SourceCountHitsList<int>>>* dye_tracks) {
+    int num_dye_seqs = dye_seqs.size();
+    vector<vector<DyeTrack>> dye_seq_dye_tracks(num_dye_seqs);
+    vector<vector<int>> dye_seq_hits(num_dye_seqs);
+#pragma omp parallel for schedule(dynamic)
+    for (int d = 0; d < num_dye_seqs; d++) {
+        // A dye track with an expected number of hits below one half would
+        // have none after rounding.
+        double expected_per_p =
+                (double)dye_seqs[d].source.count * dye_tracks_per_peptide;
+        vector<DyeTrack> all_dye_tracks;
+        vector<double> probabilities;
+        enumerate_dye_seq_dye_tracks(seq_model,
+                                     dye_seqs[d].value,
+                                     num_timesteps,
+                                     num_channels,
+                                     0.5 / expected_per_p,
+                                     &all_dye_tracks,
+                                     &probabilities);
+        for (unsigned int i = 0; i < all_dye_tracks.size(); i++) {
+            int hits = (int)llround(probabilities[i] * expected_per_p);
+            if (hits > 0) {
+                dye_seq_dye_tracks[d].push_back(move(all_dye_tracks[i]));
+                dye_seq_hits[d].push_back(hits);
+            }
+        }
+    }
+    // Combine the dye tracks which more than one dye seq can give. There are
+    // far fewer dye tracks than when sampling, so this is done in one place.
+    unordered_map<vector<short>, unsigned int> indices;
+    vector<DyeTrack*> unique_dye_tracks;
+    vector<vector<SourceCountHits<int>>> sources;
+    for (int d = 0; d < num_dye_seqs; d++) {
+        for (unsigned int i = 0; i < dye_seq_dye_tracks[d].size(); i++) {
+            DyeTrack* dye_track = &dye_seq_dye_tracks[d][i];
+            unordered_map<vector<short>, unsigned int>::iterator it =
+                    indices.find(dye_track->counts);
+            unsigned int index;
+            if (it == indices.end()) {
+                index = unique_dye_tracks.size();
+                indices[dye_track->counts] = index;
+                unique_dye_tracks.push_back(dye_track);
+                sources.push_back(vector<SourceCountHits<int>>());
+            } else {
+                index = it->second;
+            }
+            sources[index].push_back(
+                    SourceCountHits<int>(dye_seqs[d].source.source,
+                                         dye_seqs[d].source.count,
+                                         dye_seq_hits[d][i]));
+        }
+    }
+    dye_tracks->reserve(dye_tracks->size() + unique_dye_tracks.size());
+    for (unsigned int i = 0; i < unique_dye_tracks.size(); i++) {
+        int num_sources = sources[i].size();
+        SourceCountHits<int>* list = new SourceCountHits<int>[num_sources];
+        for (int s = 0; s < num_sources; s++) {
+            list[s] = sources[i][s];
+        }
+        dye_tracks->push_back(
+                move(SourcedData<DyeTrack, SourceCountHitsList<int>>(
+                        move(*unique_dye_tracks[i]),
+                        move(SourceCountHitsList<int>(num_sources, list)))));
+    }
+}
+
+void enumerate_dye_seq_dye_tracks(const SequencingModel& seq_model,
+                                  const DyeSeq& dye_seq,
+                                  unsigned int num_timesteps,
+                                  unsigned int num_channels,
+                                  double min_probability,
+                                  vector<DyeTrack>* dye_tracks,
+                                  vector<double>* probabilities) {
+    StateTable table(seq_model, dye_seq, num_channels);
+    // Many dye tracks share their first timesteps, so the dye tracks so far
+    // are kept as a tree, where each node adds the dye counts of one more
+    // timestep to its parent, and node 0 is the empty dye track.
+    vector<unsigned int> parents(1, 0);
+    vector<unsigned int> node_counts(1, 0);  // index into table.all_counts.
+    unordered_map<uint64_t, unsigned int> children;
+    // The distribution over pairs of a node and a state, packed together. At
+    // the start there is no dye track yet.
+    PackedDistribution distribution;
+    {
+        vector<short> state(2 + num_channels);
+        state[0] = 0;
+        for (unsigned int c = 0; c < num_channels; c++) {
+            state[2 + c] = table.remaining[c];
+        }
+        vector<double> p_not_dud;
+        for (unsigned int c = 0; c < num_channels; c++) {
+            p_not_dud.push_back(1.0 - seq_model.channel_models[c]->p_dud);
+        }
+        Distribution<vector<short>> initial;
+        for (short blocked = 0; blocked <= 1; blocked++) {
+            state[1] = blocked;
+            double p_blocked = blocked ? seq_model.p_initial_block
+                                       : 1.0 - seq_model.p_initial_block;
+            add_thinned(&state, 0, p_not_dud, p_blocked, &initial);
+        }
+        for (unsigned int i = 0; i < initial.keys.size(); i++) {
+            distribution.add(pack(0, table.id(initial.keys[i])),
+                             initial.probabilities[i]);
+        }
+    }
+    // Finished dye tracks, by the node of their last timestep with any dyes.
+    // All later timesteps are all 0s.
+    Distribution<unsigned int> finished;
+    for (unsigned int t = 0; t < num_timesteps; t++) {
+        double p_detach = seq_model.p_detach[t];
+        PackedDistribution next;
+        for (unsigned int i = 0; i < distribution.keys.size(); i++) {
+            double p = distribution.probabilities[i];
+            if (p < min_probability) {
+                continue;
+            }
+            unsigned int node = distribution.keys[i] >> 32;
+            unsigned int state = (unsigned int)distribution.keys[i];
+            unsigned int counts = table.state_counts[state];
+            // Once there are no dyes left, every later timestep is all 0s.
+            // Any DyeTrack with all 0s at the 0th timestep wouldn't be
+            // detectable.
+            bool nontrivial = false;
+            for (short count : table.all_counts[counts]) {
+                if (count != 0) {
+                    nontrivial = true;
+                }
+            }
+            if (!nontrivial) {
+                if (t > 0) {
+                    finished.add(node, p);
+                }
+                continue;
+            }
+            // Record the counts of this timestep.
+            uint64_t child_key = pack(node, counts);
+            unordered_map<uint64_t, unsigned int>::iterator it =
+                    children.find(child_key);
+            unsigned int child;
+            if (it == children.end()) {
+                child = parents.size();
+                children[child_key] = child;
+                parents.push_back(node);
+                node_counts.push_back(counts);
+            } else {
+                child = it->second;
+            }
+            if (t == num_timesteps - 1) {
+                finished.add(child, p);
+                continue;
+            }
+            finished.add(child, p * p_detach);
+            for (const pair<unsigned int, double>& transition :
+                 table.next(state)) {
+                next.add(pack(child, transition.first),
+                         p * (1.0 - p_detach) * transition.second);
+            }
+        }
+        distribution = move(next);
+    }
+    for (unsigned int i = 0; i < finished.keys.size(); i++) {
+        if (finished.probabilities[i] < min_probability) {
+            continue;
+        }
+        dye_tracks->push_back(DyeTrack(num_timesteps, num_channels));
+        DyeTrack& dye_track = dye_tracks->back();
+        // The depth of a node is the number of timesteps it holds.
+        unsigned int depth = 0;
+        for (unsigned int node = finished.keys[i]; node != 0;
+             node = parents[node]) {
+            depth++;
+        }
+        unsigned int t = depth;
+        for (unsigned int node = finished.keys[i]; node != 0;
+             node = parents[node]) {
+            t--;
+            const vector<short>& counts = table.all_counts[node_counts[node]];
+            for (unsigned int c = 0; c < num_channels; c++) {
+                dye_track(t, c) = counts[c];
+            }
+        }
+        probabilities->push_back(finished.probabilities[i]);
+    }
+}
+
+}  // namespace whatprot
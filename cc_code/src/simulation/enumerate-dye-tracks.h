@@ -0,0 +1,65 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+#ifndef WHATPROT_SIMULATION_ENUMERATE_DYE_TRACKS_H
+#define WHATPROT_SIMULATION_ENUMERATE_DYE_TRACKS_H
+
+// Standard C++ library headers:
+#include <vector>
+
+// Local project headers:
+#include "common/dye-seq.h"
+#include "common/dye-track.h"
+#include "common/sourced-data.h"
+#include "parameterization/model/sequencing-model.h"
+
+namespace whatprot {
+
+// An alternative to generate_dye_tracks() followed by dedup_dye_tracks(),
+// which works out how many times each dye track is expected rather than
+// sampling. For each dye seq, the dye tracks are enumerated with
+// enumerate_dye_seq_dye_tracks(), and each gets round(probability * count *
+// dye_tracks_per_peptide) hits, as if dye_tracks_per_peptide dye tracks had
+// been sampled for each peptide. Dye tracks with no hits after rounding are
+// left out, as are those which would not be visible. The dye seqs are
+// enumerated in parallel. The output is in the order each dye track is first
+// found, going through the dye seqs in order, and the sources of each dye
+// track are in the order of the dye seqs.
+void enumerate_dye_tracks(
+        const SequencingModel& seq_model,
+        const std::vector<SourcedData<DyeSeq, SourceCount<int>>>& dye_seqs,
+        unsigned int num_timesteps,
+        unsigned int num_channels,
+        unsigned int dye_tracks_per_peptide,
+        std::vector<SourcedData<DyeTrack, SourceCountHitsList<int>>>*
+                dye_tracks);
+
+// Enumerates the dye tracks of dye_seq, with their probabilities, under the
+// model of generate_dye_track(). The model is a Markov chain over the number
+// of successful Edman degradations, the number of dyes of each channel, and
+// whether the peptide is blocked, which is the state of the HMM. Within a
+// channel the dyes not yet removed are interchangeable, so the chance that an
+// Edman degradation removes a dye is the same as in EdmanTransition. A
+// distribution over pairs of a state and the dye track so far is carried
+// forward one timestep at a time. Any pair whose probability falls below
+// min_probability is dropped. No dye track is more likely than any of the
+// pairs it passes through, so every dye track with a probability of at least
+// min_probability is found, unless it comes from several pairs which were
+// each dropped. Dye tracks which would not be visible are left out, so the
+// probabilities add up to a little less than the chance of being visible.
+void enumerate_dye_seq_dye_tracks(const SequencingModel& seq_model,
+                                  const DyeSeq& dye_seq,
+                                  unsigned int num_timesteps,
+                                  unsigned int num_channels,
+                                  double min_probability,
+                                  std::vector<DyeTrack>* dye_tracks,
+                                  std::vector<double>* probabilities);
+
+}  // namespace whatprot
+
+#endif  // WHATPROT_SIMULATION_ENUMERATE_DYE_TRACKS_H
@@ -0,0 +1,212 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+// Boost unit test framework (recommended to be the first include):
+#include <boost/test/unit_test.hpp>
+
+// File under test:
+#include "enumerate-dye-tracks.h"
+
+// Standard C++ library headers:
+#include <cmath>
+#include <map>
+#include <vector>
+
+// Local project headers:
+#include "common/dye-seq.h"
+#include "common/dye-track.h"
+#include "common/sourced-data.h"
+#include "parameterization/model/sequencing-model.h"
+#include "simulation/generate-dye-track.h"
+#include "util/philox.h"
+
+namespace whatprot {
+
+namespace {
+using boost::unit_test::tolerance;
+using std::abs;
+using std::llround;
+using std::map;
+using std::vector;
+const double TOL = 0.000000001;
+
+// Two channels, with rates high enough that every kind of event happens often
+// in a few timesteps.
+SequencingModel test_seq_model() {
+    SequencingModel seq_model(2);
+    seq_model.p_edman_failure = 0.2;
+    seq_model.p_detach.base = 0.05;
+    seq_model.p_detach.initial = 0.1;
+    seq_model.p_detach.initial_decay = 0.5;
+    seq_model.p_initial_block = 0.1;
+    seq_model.p_cyclic_block = 0.05;
+    seq_model.channel_models[0]->p_dud = 0.1;
+    seq_model.channel_models[0]->p_bleach = 0.1;
+    seq_model.channel_models[1]->p_dud = 0.2;
+    seq_model.channel_models[1]->p_bleach = 0.15;
+    return seq_model;
+}
+
+// The probability of each dye track, keyed by its counts.
+map<vector<short>, double> enumerate_map(const SequencingModel& seq_model,
+                                         const DyeSeq& dye_seq,
+                                         double min_probability) {
+    vector<DyeTrack> dye_tracks;
+    vector<double> probabilities;
+    enumerate_dye_seq_dye_tracks(seq_model,
+                                 dye_seq,
+                                 4,  // num_timesteps
+                                 2,  // num_channels
+                                 min_probability,
+                                 &dye_tracks,
+                                 &probabilities);
+    BOOST_REQUIRE(dye_tracks.size() == probabilities.size());
+    map<vector<short>, double> result;
+    for (unsigned int i = 0; i < dye_tracks.size(); i++) {
+        // Each dye track must be found once.
+        BOOST_TEST(result.count(dye_tracks[i].counts) == 0u);
+        result[dye_tracks[i].counts] = probabilities[i];
+    }
+    return result;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(simulation_suite)
+BOOST_AUTO_TEST_SUITE(enumerate_dye_tracks_suite)
+
+BOOST_AUTO_TEST_CASE(sum_to_visible_test, *tolerance(TOL)) {
+    SequencingModel seq_model = test_seq_model();
+    DyeSeq dye_seq(2, "01.1");
+    map<vector<short>, double> probabilities =
+            enumerate_map(seq_model, dye_seq, 0.0);
+    double total = 0.0;
+    for (const auto& entry : probabilities) {
+        total += entry.second;
+    }
+    // The only dye track left out is the one of all 0s, which is what you
+    // get if every dye is a dud.
+    double p_all_dud = 0.1 * 0.2 * 0.2;
+    BOOST_TEST(total == 1.0 - p_all_dud);
+}
+
+BOOST_AUTO_TEST_CASE(matches_generate_dye_track_test) {
+    SequencingModel seq_model = test_seq_model();
+    DyeSeq dye_seq(2, "01.1");
+    map<vector<short>, double> probabilities =
+            enumerate_map(seq_model, dye_seq, 0.0);
+    int num_samples = 200000;
+    Philox generator(0x5eed, 0);
+    map<vector<short>, int> counts;
+    for (int i = 0; i < num_samples; i++) {
+        DyeTrack dye_track(4, 2);
+        generate_dye_track(seq_model, dye_seq, 4, 2, &generator, &dye_track);
+        bool visible = false;
+        for (short count : dye_track.counts) {
+            if (count != 0) {
+                visible = true;
+            }
+        }
+        if (visible) {
+            counts[dye_track.counts]++;
+        }
+    }
+    // Every dye track that was sampled must have been enumerated.
+    for (const auto& entry : counts) {
+        BOOST_TEST(probabilities.count(entry.first) == 1u);
+    }
+    // The standard deviation of a frequency is at most 0.5 / sqrt(200000),
+    // or about 0.0011, so this is more than five of them.
+    for (const auto& entry : probabilities) {
+        double frequency = (double)counts[entry.first] / num_samples;
+        BOOST_TEST(abs(frequency - entry.second) < 0.006);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(min_probability_test) {
+    SequencingModel seq_model = test_seq_model();
+    DyeSeq dye_seq(2, "01.1");
+    map<vector<short>, double> all = enumerate_map(seq_model, dye_seq, 0.0);
+    double min_probability = 0.01;
+    map<vector<short>, double> pruned =
+            enumerate_map(seq_model, dye_seq, min_probability);
+    BOOST_TEST(pruned.size() < all.size());
+    for (const auto& entry : pruned) {
+        BOOST_TEST(entry.second >= min_probability);
+        BOOST_REQUIRE(all.count(entry.first) == 1u);
+        // Dropping pairs only loses probability.
+        BOOST_TEST(entry.second <= all[entry.first] + TOL);
+    }
+    // A dye track which is likely, but only through pairs which are each
+    // less likely than min_probability, is lost, so only check that the most
+    // likely ones are all found.
+    int num_likely = 0;
+    for (const auto& entry : all) {
+        if (entry.second >= 0.1) {
+            BOOST_TEST(pruned.count(entry.first) == 1u);
+            num_likely++;
+        }
+    }
+    BOOST_TEST(num_likely > 0);
+}
+
+BOOST_AUTO_TEST_CASE(enumerate_dye_tracks_test) {
+    SequencingModel seq_model = test_seq_model();
+    vector<SourcedData<DyeSeq, SourceCount<int>>> dye_seqs;
+    dye_seqs.push_back(SourcedData<DyeSeq, SourceCount<int>>(
+            DyeSeq(2, "01.1"), SourceCount<int>(7, 2)));
+    dye_seqs.push_back(SourcedData<DyeSeq, SourceCount<int>>(
+            DyeSeq(2, "1.0"), SourceCount<int>(9, 1)));
+    unsigned int dye_tracks_per_peptide = 1000;
+    vector<SourcedData<DyeTrack, SourceCountHitsList<int>>> dye_tracks;
+    enumerate_dye_tracks(
+            seq_model, dye_seqs, 4, 2, dye_tracks_per_peptide, &dye_tracks);
+    // What each dye seq should contribute, with the same threshold.
+    vector<map<vector<short>, int>> expected_hits(2);
+    for (int d = 0; d < 2; d++) {
+        double expected_per_p =
+                (double)dye_seqs[d].source.count * dye_tracks_per_peptide;
+        map<vector<short>, double> probabilities = enumerate_map(
+                seq_model, dye_seqs[d].value, 0.5 / expected_per_p);
+        for (const auto& entry : probabilities) {
+            int hits = (int)llround(entry.second * expected_per_p);
+            if (hits > 0) {
+                expected_hits[d][entry.first] = hits;
+            }
+        }
+    }
+    unsigned int num_sources = 0;
+    map<vector<short>, int> seen;
+    for (const auto& dye_track : dye_tracks) {
+        BOOST_TEST(seen.count(dye_track.value.counts) == 0u);
+        seen[dye_track.value.counts] = 1;
+        const SourceCountHitsList<int>& sources = dye_track.source;
+        BOOST_REQUIRE(sources.num_sources >= 1);
+        BOOST_REQUIRE(sources.num_sources <= 2);
+        for (int s = 0; s < sources.num_sources; s++) {
+            int d = (sources.sources[s].source == 7) ? 0 : 1;
+            // The sources are in the order of the dye seqs.
+            if (s > 0) {
+                BOOST_TEST(sources.sources[s - 1].source == 7);
+                BOOST_TEST(sources.sources[s].source == 9);
+            }
+            BOOST_TEST(sources.sources[s].count == dye_seqs[d].source.count);
+            BOOST_REQUIRE(expected_hits[d].count(dye_track.value.counts)
+                          == 1u);
+            BOOST_TEST(sources.sources[s].hits
+                       == expected_hits[d][dye_track.value.counts]);
+            num_sources++;
+        }
+    }
+    BOOST_TEST(num_sources
+               == expected_hits[0].size() + expected_hits[1].size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // enumerate_dye_tracks_suite
+BOOST_AUTO_TEST_SUITE_END()  // simulation_suite
+
+}  // namespace whatprot
@@ -17,12 +17,12 @@
 #include "common/dye-seq.h"
 #include "common/dye-track.h"
 #include "parameterization/model/sequencing-model.h"
+#include "util/philox.h"
 
 namespace whatprot {
 
 namespace {
 using std::bernoulli_distribution;
-using std::default_random_engine;
 using std::vector;
 }  // namespace
 
@@ -30,7 +30,7 @@ void generate_dye_track(const SequencingModel& seq_model,
                         const DyeSeq& dye_seq,
                         unsigned int num_timesteps,
                         unsigned int num_channels,
-                        default_random_engine* generator,
+                        Philox* generator,
                         DyeTrack* dye_track) {
     bernoulli_distribution edman_failure(seq_model.p_edman_failure);
     vector<bernoulli_distribution> detach_events;
@@ -9,13 +9,11 @@
 #ifndef WHATPROT_SIMULATION_GENERATE_DYE_TRACK_H
 #define WHATPROT_SIMULATION_GENERATE_DYE_TRACK_H
 
-// Standard C++ library headers:
-#include <random>
-
 // Local project headers:
 #include "common/dye-seq.h"
 #include "common/dye-track.h"
 #include "parameterization/model/sequencing-model.h"
+#include "util/philox.h"
 
 namespace whatprot {
 
@@ -23,7 +21,7 @@ void generate_dye_track(const SequencingModel& seq_model,
                         const DyeSeq& dye_seq,
                         unsigned int num_timesteps,
                         unsigned int num_channels,
-                        std::default_random_engine* generator,
+                        Philox* generator,
                         DyeTrack* dye_track);
 
 }  // namespace whatprot
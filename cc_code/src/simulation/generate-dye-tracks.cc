@@ -10,7 +10,8 @@
 #include "generate-dye-tracks.h"
 
 // Standard C++ library headers:
-#include <random>
+#include <algorithm>
+#include <cstdint>
 #include <utility>  // for std::move
 #include <vector>
 
@@ -19,14 +20,21 @@
 #include "common/dye-track.h"
 #include "common/sourced-data.h"
 #include "parameterization/model/sequencing-model.h"
-#include "simulation/generate-dye-track.h"
+#include "simulation/dye-track-sampler.h"
+#include "util/philox.h"
 
 namespace whatprot {
 
 namespace {
-using std::default_random_engine;
+using std::min;
 using std::move;
+using std::uint64_t;
 using std::vector;
+
+// The replicates of each dye seq are simulated in blocks of this many, each
+// with its own stream, so that a dye seq which gives far more dye tracks than
+// the others can still be split between threads.
+const unsigned int REPLICATES_PER_BLOCK = 4096;
 }  // namespace
 
 void generate_dye_tracks(
@@ -35,38 +43,51 @@ void generate_dye_tracks(
         unsigned int num_timesteps,
         unsigned int num_channels,
         unsigned int dye_tracks_per_peptide,
-        default_random_engine* generator,
+        unsigned int seed,
         vector<SourcedData<DyeTrack, SourceCount<int>>>* dye_tracks) {
-    dye_tracks->reserve(dye_seqs.size());
-    for (const SourcedData<DyeSeq, SourceCount<int>>& dye_seq : dye_seqs) {
-        // We want to generate a certain number of radiometries per peptide,
-        // not per dye_seq. Therefore we do this on repeat for each peptide
-        // that produced this dye_seq.
-        for (int i = 0; i < dye_seq.source.count; i++) {
-            for (unsigned int j = 0; j < dye_tracks_per_peptide; j++) {
-                DyeTrack dye_track(num_timesteps, num_channels);
-                generate_dye_track(seq_model,
-                                   dye_seq.value,
-                                   num_timesteps,
-                                   num_channels,
-                                   generator,
-                                   &dye_track);
-                // Ignore any DyeTrack with all 0s because it wouldn't be
-                // detectable. Any DyeTrack with all 0s at the 0th timestep will
-                // have all 0s throughout.
-                bool nontrivial = false;
-                for (unsigned int c = 0; c < num_channels; c++) {
-                    if (dye_track(0, c) != 0) {
-                        nontrivial = true;
-                    }
-                }
-                if (nontrivial) {
-                    dye_tracks->push_back(
-                            move(SourcedData<DyeTrack, SourceCount<int>>(
-                                    move(dye_track), dye_seq.source)));
-                }
-            }
+    DyeTrackSampler sampler(seq_model, num_timesteps, num_channels);
+    int num_dye_seqs = dye_seqs.size();
+    // We want to generate a certain number of radiometries per peptide, not
+    // per dye_seq. Therefore we do this on repeat for each peptide that
+    // produced this dye_seq. The blocks of every dye seq are numbered
+    // together, in order, and block_dye_seqs gives the dye seq of each.
+    vector<unsigned int> num_replicates(num_dye_seqs);
+    vector<int> block_dye_seqs;
+    vector<unsigned int> block_indices;  // within its dye seq.
+    for (int d = 0; d < num_dye_seqs; d++) {
+        num_replicates[d] = dye_seqs[d].source.count * dye_tracks_per_peptide;
+        for (unsigned int first = 0; first < num_replicates[d];
+             first += REPLICATES_PER_BLOCK) {
+            block_dye_seqs.push_back(d);
+            block_indices.push_back(first / REPLICATES_PER_BLOCK);
+        }
+    }
+    int num_blocks = block_dye_seqs.size();
+    vector<vector<DyeTrack>> block_dye_tracks(num_blocks);
+    // Dye seqs can give very different numbers of dye tracks, so the blocks
+    // are handed out to the threads one at a time. Dye tracks which wouldn't
+    // be detectable are left out by the sampler.
+#pragma omp parallel for schedule(dynamic)
+    for (int b = 0; b < num_blocks; b++) {
+        int d = block_dye_seqs[b];
+        unsigned int first = block_indices[b] * REPLICATES_PER_BLOCK;
+        Philox generator(seed, ((uint64_t)d << 32) | block_indices[b]);
+        sampler.sample(dye_seqs[d].value,
+                       min(REPLICATES_PER_BLOCK, num_replicates[d] - first),
+                       &generator,
+                       &block_dye_tracks[b]);
+    }
+    size_t num_dye_tracks = 0;
+    for (int b = 0; b < num_blocks; b++) {
+        num_dye_tracks += block_dye_tracks[b].size();
+    }
+    dye_tracks->reserve(dye_tracks->size() + num_dye_tracks);
+    for (int b = 0; b < num_blocks; b++) {
+        for (DyeTrack& dye_track : block_dye_tracks[b]) {
+            dye_tracks->push_back(SourcedData<DyeTrack, SourceCount<int>>(
+                    move(dye_track), dye_seqs[block_dye_seqs[b]].source));
         }
+        vector<DyeTrack>().swap(block_dye_tracks[b]);
     }
 }
 
@@ -10,8 +10,6 @@
 #define WHATPROT_SIMULATION_GENERATE_DYE_TRACKS_H
 
 // Standard C++ library headers:
-#include <random>
-#include <unordered_map>
 #include <vector>
 
 // Local project headers:
@@ -22,13 +20,21 @@
 
 namespace whatprot {
 
+// Generates dye_tracks_per_peptide dye tracks for every peptide which gave each
+// dye seq, leaving out any which would not be visible. The dye tracks are
+// simulated in parallel, with a DyeTrackSampler, in blocks of up to 4096
+// replicates of one dye seq. Each block has its own stream of random numbers
+// (see Philox), numbered by the index of its dye seq in the upper 32 bits and
+// the index of the block within the dye seq in the lower 32 bits, so the dye
+// tracks depend only on the seed, and not on the number of threads. They are in
+// the order of their dye seqs.
 void generate_dye_tracks(
         const SequencingModel& seq_model,
         const std::vector<SourcedData<DyeSeq, SourceCount<int>>>& dye_seqs,
         unsigned int num_timesteps,
         unsigned int num_channels,
         unsigned int dye_tracks_per_peptide,
-        std::default_random_engine* generator,
+        unsigned int seed,
         std::vector<SourcedData<DyeTrack, SourceCount<int>>>* dye_tracks);
 
 }  // namespace whatprot
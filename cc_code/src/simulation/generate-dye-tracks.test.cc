@@ -0,0 +1,122 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+// Boost unit test framework (recommended to be the first include):
+#include <boost/test/unit_test.hpp>
+
+// File under test:
+#include "generate-dye-tracks.h"
+
+// Standard C++ library headers:
+#include <cstdint>
+#include <vector>
+
+// OpenMP
+#include <omp.h>
+
+// Local project headers:
+#include "common/dye-seq.h"
+#include "common/dye-track.h"
+#include "common/sourced-data.h"
+#include "parameterization/model/sequencing-model.h"
+#include "simulation/dye-track-sampler.h"
+#include "util/philox.h"
+
+namespace whatprot {
+
+namespace {
+using std::uint64_t;
+using std::vector;
+
+SequencingModel test_seq_model() {
+    SequencingModel seq_model(2);
+    seq_model.p_edman_failure = 0.2;
+    seq_model.p_detach.base = 0.05;
+    seq_model.p_detach.initial = 0.1;
+    seq_model.p_detach.initial_decay = 0.5;
+    seq_model.p_initial_block = 0.1;
+    seq_model.p_cyclic_block = 0.05;
+    seq_model.channel_models[0]->p_dud = 0.1;
+    seq_model.channel_models[0]->p_bleach = 0.1;
+    seq_model.channel_models[1]->p_dud = 0.2;
+    seq_model.channel_models[1]->p_bleach = 0.15;
+    return seq_model;
+}
+
+// A dye seq from one peptide, and one from three, which with 3000 dye tracks
+// per peptide takes three blocks, the last of them short.
+void make_dye_seqs(vector<SourcedData<DyeSeq, SourceCount<int>>>* dye_seqs) {
+    dye_seqs->push_back(SourcedData<DyeSeq, SourceCount<int>>(
+            DyeSeq(2, "01.1"), SourceCount<int>(7, 1)));
+    dye_seqs->push_back(SourcedData<DyeSeq, SourceCount<int>>(
+            DyeSeq(2, "1.0"), SourceCount<int>(9, 3)));
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(simulation_suite)
+BOOST_AUTO_TEST_SUITE(generate_dye_tracks_suite)
+
+BOOST_AUTO_TEST_CASE(blocks_test) {
+    SequencingModel seq_model = test_seq_model();
+    vector<SourcedData<DyeSeq, SourceCount<int>>> dye_seqs;
+    make_dye_seqs(&dye_seqs);
+    vector<SourcedData<DyeTrack, SourceCount<int>>> dye_tracks;
+    generate_dye_tracks(seq_model, dye_seqs, 4, 2, 3000, 5, &dye_tracks);
+    // The same dye tracks, one block at a time, with the streams documented
+    // for generate_dye_tracks().
+    DyeTrackSampler sampler(seq_model, 4, 2);
+    vector<DyeTrack> expected;
+    Philox generator(5, 0);
+    sampler.sample(dye_seqs[0].value, 3000, &generator, &expected);
+    unsigned int num_first = expected.size();
+    unsigned int sizes[] = {4096, 4096, 808};
+    for (uint64_t b = 0; b < 3; b++) {
+        Philox block_generator(5, ((uint64_t)1 << 32) | b);
+        sampler.sample(
+                dye_seqs[1].value, sizes[b], &block_generator, &expected);
+    }
+    BOOST_REQUIRE(dye_tracks.size() == expected.size());
+    bool same = true;
+    for (unsigned int i = 0; i < expected.size(); i++) {
+        same = same && dye_tracks[i].value == expected[i];
+        int source = (i < num_first) ? 7 : 9;
+        int count = (i < num_first) ? 1 : 3;
+        BOOST_TEST(dye_tracks[i].source.source == source);
+        BOOST_TEST(dye_tracks[i].source.count == count);
+    }
+    BOOST_TEST(same);
+}
+
+BOOST_AUTO_TEST_CASE(threads_test) {
+    SequencingModel seq_model = test_seq_model();
+    vector<SourcedData<DyeSeq, SourceCount<int>>> dye_seqs;
+    make_dye_seqs(&dye_seqs);
+    vector<SourcedData<DyeTrack, SourceCount<int>>> serial;
+    vector<SourcedData<DyeTrack, SourceCount<int>>> parallel;
+    int max_threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    generate_dye_tracks(seq_model, dye_seqs, 4, 2, 3000, 5, &serial);
+    // With four threads the three blocks of the second dye seq are sampled at
+    // the same time as the first dye seq, and may finish in any order, but
+    // each still draws from its own stream and lands in its own place.
+    omp_set_num_threads(4);
+    generate_dye_tracks(seq_model, dye_seqs, 4, 2, 3000, 5, &parallel);
+    omp_set_num_threads(max_threads);
+    BOOST_REQUIRE(parallel.size() == serial.size());
+    bool same = true;
+    for (unsigned int i = 0; i < serial.size(); i++) {
+        same = same && serial[i].value == parallel[i].value
+               && serial[i].source.source == parallel[i].source.source;
+    }
+    BOOST_TEST(same);
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // generate_dye_tracks_suite
+BOOST_AUTO_TEST_SUITE_END()  // simulation_suite
+
+}  // namespace whatprot
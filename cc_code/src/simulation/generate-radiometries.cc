@@ -10,7 +10,9 @@
 #include "generate-radiometries.h"
 
 // Standard C++ library headers:
+#include <cstdint>
 #include <random>
+#include <utility>  // for std::move
 #include <vector>
 
 // Local project headers:
@@ -18,23 +20,29 @@
 #include "common/radiometry.h"
 #include "parameterization/model/sequencing-model.h"
 #include "simulation/generate-radiometry.h"
+#include "util/philox.h"
 
 namespace whatprot {
 
 namespace {
-using std::default_random_engine;
 using std::discrete_distribution;
+using std::move;
+using std::uint64_t;
 using std::vector;
+// Radiometries are generated in chunks of this many, so that each thread has
+// enough to do between handing out chunks.
+const int CHUNK_SIZE = 4096;
 }  // namespace
 
 void generate_radiometries(
         const SequencingModel& seq_model,
-        const std::vector<SourcedData<DyeSeq, SourceCount<int>>>& dye_seqs,
+        const vector<SourcedData<DyeSeq, SourceCount<int>>>& dye_seqs,
         unsigned int num_timesteps,
         unsigned int num_channels,
+        unsigned int first,
         unsigned int num_to_generate,
-        std::default_random_engine* generator,
-        std::vector<SourcedData<Radiometry, SourceCount<int>>>* radiometries) {
+        unsigned int seed,
+        vector<SourcedData<Radiometry, SourceCount<int>>>* radiometries) {
     // We want the dye tracks generated based on a uniform distribution of
     // peptides, not radiometries. We therefore need a discrete_distribution,
     // because it is weighted.
@@ -45,21 +53,40 @@ void generate_radiometries(
     }
     discrete_distribution<unsigned int> random_dye_seq_idx(
             index_to_weight.begin(), index_to_weight.end());
-    for (unsigned int i = 0; i < num_to_generate; i++) {
-        unsigned int dye_seq_idx = random_dye_seq_idx(*generator);
-        radiometries->push_back(SourcedData<Radiometry, SourceCount<int>>(
-                Radiometry(num_timesteps, num_channels),
-                dye_seqs[dye_seq_idx].source));
-        // We ignore radiometries from invisible dye-tracks (all 0s). These are
-        // indicated by the return value.
-        if (!generate_radiometry(seq_model,
-                                 dye_seqs[dye_seq_idx].value,
-                                 num_timesteps,
-                                 num_channels,
-                                 generator,
-                                 &radiometries->back().value)) {
-            radiometries->pop_back();
+    int num_chunks = (num_to_generate + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    vector<vector<SourcedData<Radiometry, SourceCount<int>>>> chunks(
+            num_chunks);
+#pragma omp parallel for schedule(dynamic) firstprivate(random_dye_seq_idx)
+    for (int chunk = 0; chunk < num_chunks; chunk++) {
+        unsigned int begin = chunk * CHUNK_SIZE;
+        unsigned int end = begin + CHUNK_SIZE;
+        if (end > num_to_generate) {
+            end = num_to_generate;
         }
+        for (unsigned int i = begin; i < end; i++) {
+            Philox generator(seed, (uint64_t)first + i);
+            unsigned int dye_seq_idx = random_dye_seq_idx(generator);
+            chunks[chunk].push_back(SourcedData<Radiometry, SourceCount<int>>(
+                    Radiometry(num_timesteps, num_channels),
+                    dye_seqs[dye_seq_idx].source));
+            // We ignore radiometries from invisible dye-tracks (all 0s). These
+            // are indicated by the return value.
+            if (!generate_radiometry(seq_model,
+                                     dye_seqs[dye_seq_idx].value,
+                                     num_timesteps,
+                                     num_channels,
+                                     &generator,
+                                     &chunks[chunk].back().value)) {
+                chunks[chunk].pop_back();
+            }
+        }
+    }
+    for (int chunk = 0; chunk < num_chunks; chunk++) {
+        for (SourcedData<Radiometry, SourceCount<int>>& radiometry :
+             chunks[chunk]) {
+            radiometries->push_back(move(radiometry));
+        }
+        chunks[chunk].clear();
     }
 }
 
@@ -10,7 +10,6 @@
 #define WHATPROT_SIMULATION_GENERATE_RADIOMETRIES_H
 
 // Standard C++ library headers:
-#include <random>
 #include <vector>
 
 // Local project headers:
@@ -21,13 +20,21 @@
 
 namespace whatprot {
 
+// Generates num_to_generate radiometries, each from a peptide chosen uniformly
+// at random, leaving out any which would not be visible. The radiometries are
+// simulated in parallel. Each radiometry has its own stream of random numbers
+// (see Philox), numbered on from first, so the radiometries depend only on the
+// seed, and not on the number of threads. Generating them in several calls,
+// with first set to the number of radiometries already tried, gives the same
+// radiometries as one call. They are in the order of their streams.
 void generate_radiometries(
         const SequencingModel& seq_model,
         const std::vector<SourcedData<DyeSeq, SourceCount<int>>>& dye_seqs,
         unsigned int num_timesteps,
         unsigned int num_channels,
+        unsigned int first,
         unsigned int num_to_generate,
-        std::default_random_engine* generator,
+        unsigned int seed,
         std::vector<SourcedData<Radiometry, SourceCount<int>>>* radiometries);
 
 }  // namespace whatprot
@@ -16,11 +16,11 @@
 // Local project headers:
 #include "parameterization/model/sequencing-model.h"
 #include "simulation/generate-dye-track.h"
+#include "util/philox.h"
 
 namespace whatprot {
 
 namespace {
-using std::default_random_engine;
 using std::normal_distribution;
 using std::sqrt;
 }  // namespace
@@ -29,7 +29,7 @@ bool generate_radiometry(const SequencingModel& seq_model,
                          const DyeSeq& dye_seq,
                          unsigned int num_timesteps,
                          unsigned int num_channels,
-                         default_random_engine* generator,
+                         Philox* generator,
                          Radiometry* radiometry) {
     DyeTrack dye_track(num_timesteps, num_channels);
     generate_dye_track(seq_model,
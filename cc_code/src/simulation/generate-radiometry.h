@@ -9,13 +9,11 @@
 #ifndef WHATPROT_SIMULATION_GENERATE_RADIOMETRY_H
 #define WHATPROT_SIMULATION_GENERATE_RADIOMETRY_H
 
-// Standard C++ library headers:
-#include <random>
-
 // Local project headers:
 #include "common/dye-seq.h"
 #include "common/radiometry.h"
 #include "parameterization/model/sequencing-model.h"
+#include "util/philox.h"
 
 namespace whatprot {
 
@@ -25,7 +23,7 @@ bool generate_radiometry(const SequencingModel& seq_model,
                          const DyeSeq& dye_seq,
                          unsigned int num_timesteps,
                          unsigned int num_channels,
-                         std::default_random_engine* generator,
+                         Philox* generator,
                          Radiometry* radiometry);
 
 }  // namespace whatprot
@@ -0,0 +1,132 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+#ifndef WHATPROT_TENSOR_RANGE_LOOP_H
+#define WHATPROT_TENSOR_RANGE_LOOP_H
+
+// Standard C++ library headers:
+#include <type_traits>
+#include <vector>
+
+// Local project headers:
+#include "util/kd-range.h"
+
+namespace whatprot {
+
+// The functions here are a faster alternative to TensorIterator and
+// ConstTensorIterator for the hot loops of the HMM steps. A range is walked one
+// "row" at a time, where a row is every location in the range which differs
+// only in the last (innermost) dimension. Because the last dimension has a
+// stride of one in every Tensor, each row is a contiguous block of memory, and
+// the work on it can be a plain loop over a pointer which the compiler is able
+// to vectorize.
+//
+// Most functions here are templated on the order of the range, so that the
+// bookkeeping for the outer dimensions can be fully unrolled. An ORDER of zero
+// means the order is only known at runtime; this is a (slower) fallback for
+// orders that dispatch_order() does not specialize.
+
+// Storage for the location of the start of a row. This next thing is a bit of
+// a hack; we want a fixed-size array on the stack when the order is known at
+// compile-time, and must fall back to a std::vector otherwise.
+template <unsigned int ORDER>
+class RowLocation {
+public:
+    RowLocation(unsigned int order) {}
+    unsigned int* data() {
+        return loc;
+    }
+
+    unsigned int loc[ORDER];
+};
+
+template <>
+class RowLocation<0> {
+public:
+    RowLocation(unsigned int order) : loc(order) {}
+    unsigned int* data() {
+        return &loc[0];
+    }
+
+    std::vector<unsigned int> loc;
+};
+
+// Call f(loc, length) once for every row of the range, in the same order that
+// TensorIterator would visit them. Here loc is the location of the first entry
+// of the row (it has one entry per dimension of the range), and length is the
+// number of entries in the row, which is the same for every row. Nothing is
+// called if the range is empty.
+template <unsigned int ORDER, typename F>
+void for_each_row(const KDRange& range, F f) {
+    const unsigned int order = (ORDER != 0) ? ORDER : range.min.size();
+    if (order == 0) {
+        return;
+    }
+    for (unsigned int d = 0; d < order; d++) {
+        if (range.max[d] <= range.min[d]) {
+            return;
+        }
+    }
+    RowLocation<ORDER> row_location(order);
+    unsigned int* loc = row_location.data();
+    for (unsigned int d = 0; d < order; d++) {
+        loc[d] = range.min[d];
+    }
+    unsigned int length = range.max[order - 1] - range.min[order - 1];
+    while (true) {
+        f((const unsigned int*)loc, length);
+        // Advance to the next row, carrying over into outer dimensions as
+        // needed. The innermost dimension is never touched.
+        int d = (int)order - 2;
+        while (d >= 0) {
+            loc[d]++;
+            if (loc[d] < range.max[d]) {
+                break;
+            }
+            loc[d] = range.min[d];
+            d--;
+        }
+        if (d < 0) {
+            return;
+        }
+    }
+}
+
+// Call f with a std::integral_constant holding order, so that f can pass it on
+// as the ORDER template parameter of the functions above. Orders one through
+// five (i.e., up to four channels for a PeptideStateVector) get their own
+// specialization; anything else gets the runtime-order fallback of zero. This
+// is intended for use with a generic lambda, for example:
+//   - dispatch_order(order, [&](auto o) { kernel<decltype(o)::value>(); });
+template <typename F>
+void dispatch_order(unsigned int order, F f) {
+    switch (order) {
+        case 1:
+            f(std::integral_constant<unsigned int, 1>());
+            break;
+        case 2:
+            f(std::integral_constant<unsigned int, 2>());
+            break;
+        case 3:
+            f(std::integral_constant<unsigned int, 3>());
+            break;
+        case 4:
+            f(std::integral_constant<unsigned int, 4>());
+            break;
+        case 5:
+            f(std::integral_constant<unsigned int, 5>());
+            break;
+        default:
+            f(std::integral_constant<unsigned int, 0>());
+            break;
+    }
+}
+
+}  // namespace whatprot
+
+#endif  // WHATPROT_TENSOR_RANGE_LOOP_H
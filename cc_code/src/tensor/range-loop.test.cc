@@ -0,0 +1,111 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+// Boost unit test framework (recommended to be the first include):
+#include <boost/test/unit_test.hpp>
+
+// File under test:
+#include "range-loop.h"
+
+// Standard C++ library headers:
+#include <vector>
+
+// Local project headers:
+#include "util/kd-range.h"
+
+namespace whatprot {
+
+namespace {
+using std::vector;
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(tensor_suite)
+BOOST_AUTO_TEST_SUITE(range_loop_suite)
+
+BOOST_AUTO_TEST_CASE(for_each_row_order_one_test) {
+    KDRange range;
+    range.min = {2};
+    range.max = {5};
+    vector<unsigned int> starts;
+    vector<unsigned int> lengths;
+    for_each_row<1>(range, [&](const unsigned int* loc, unsigned int length) {
+        starts.push_back(loc[0]);
+        lengths.push_back(length);
+    });
+    BOOST_ASSERT(starts.size() == 1u);
+    BOOST_TEST(starts[0] == 2u);
+    BOOST_TEST(lengths[0] == 3u);
+}
+
+BOOST_AUTO_TEST_CASE(for_each_row_order_three_test) {
+    KDRange range;
+    range.min = {0, 1, 2};
+    range.max = {2, 3, 6};
+    vector<vector<unsigned int>> starts;
+    vector<unsigned int> lengths;
+    for_each_row<3>(range, [&](const unsigned int* loc, unsigned int length) {
+        starts.push_back(vector<unsigned int>(loc, loc + 3));
+        lengths.push_back(length);
+    });
+    BOOST_ASSERT(starts.size() == 4u);
+    BOOST_TEST(starts[0] == vector<unsigned int>({0, 1, 2}));
+    BOOST_TEST(starts[1] == vector<unsigned int>({0, 2, 2}));
+    BOOST_TEST(starts[2] == vector<unsigned int>({1, 1, 2}));
+    BOOST_TEST(starts[3] == vector<unsigned int>({1, 2, 2}));
+    BOOST_TEST(lengths[0] == 4u);
+    BOOST_TEST(lengths[1] == 4u);
+    BOOST_TEST(lengths[2] == 4u);
+    BOOST_TEST(lengths[3] == 4u);
+}
+
+BOOST_AUTO_TEST_CASE(for_each_row_runtime_order_test) {
+    KDRange range;
+    range.min = {0, 1, 2};
+    range.max = {2, 3, 6};
+    vector<vector<unsigned int>> starts;
+    vector<unsigned int> lengths;
+    for_each_row<0>(range, [&](const unsigned int* loc, unsigned int length) {
+        starts.push_back(vector<unsigned int>(loc, loc + 3));
+        lengths.push_back(length);
+    });
+    BOOST_ASSERT(starts.size() == 4u);
+    BOOST_TEST(starts[0] == vector<unsigned int>({0, 1, 2}));
+    BOOST_TEST(starts[1] == vector<unsigned int>({0, 2, 2}));
+    BOOST_TEST(starts[2] == vector<unsigned int>({1, 1, 2}));
+    BOOST_TEST(starts[3] == vector<unsigned int>({1, 2, 2}));
+    BOOST_TEST(lengths[0] == 4u);
+    BOOST_TEST(lengths[3] == 4u);
+}
+
+BOOST_AUTO_TEST_CASE(for_each_row_empty_range_test) {
+    KDRange range;
+    range.min = {0, 3, 0};
+    range.max = {2, 3, 6};
+    unsigned int num_calls = 0;
+    for_each_row<3>(range, [&](const unsigned int* loc, unsigned int length) {
+        num_calls++;
+    });
+    BOOST_TEST(num_calls == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(dispatch_order_specialized_test) {
+    unsigned int result = 999;
+    dispatch_order(3, [&](auto o) { result = decltype(o)::value; });
+    BOOST_TEST(result == 3u);
+}
+
+BOOST_AUTO_TEST_CASE(dispatch_order_fallback_test) {
+    unsigned int result = 999;
+    dispatch_order(9, [&](auto o) { result = decltype(o)::value; });
+    BOOST_TEST(result == 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // range_loop_suite
+BOOST_AUTO_TEST_SUITE_END()  // tensor_suite
+
+}  // namespace whatprot
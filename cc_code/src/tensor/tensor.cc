@@ -17,6 +17,7 @@
 // Local project headers:
 #include "tensor/const-tensor-iterator.h"
 #include "tensor/const-tensor-vector-iterator.h"
+#include "tensor/range-loop.h"
 #include "tensor/tensor-iterator.h"
 #include "tensor/tensor-vector-iterator.h"
 #include "util/kd-range.h"
@@ -29,6 +30,9 @@ using std::initializer_list;
 using std::vector;
 }  // namespace
 
+Tensor::Tensor()
+        : values(NULL), strides(NULL), size(0), capacity(0), order(0) {}
+
 Tensor::Tensor(unsigned int order, const unsigned int* shape) : order(order) {
     this->range.max = vector<unsigned int>(order);
     copy(shape, shape + order, &this->range.max[0]);
@@ -39,6 +43,7 @@ Tensor::Tensor(unsigned int order, const unsigned int* shape) : order(order) {
         strides[i] = size;
         size *= shape[i];
     }
+    capacity = size;
     values = new double[size]();
 }
 
@@ -50,6 +55,7 @@ Tensor::Tensor(const KDRange& range) : order(range.min.size()) {
         strides[i] = size;
         size *= range.max[i] - range.min[i];
     }
+    capacity = size;
     values = new double[size]();
 }
 
@@ -58,6 +64,7 @@ Tensor::Tensor(Tensor&& other)
           range(other.range),
           strides(other.strides),
           size(other.size),
+          capacity(other.capacity),
           order(other.order) {
     other.values = NULL;
     other.strides = NULL;
@@ -72,6 +79,29 @@ Tensor::~Tensor() {
     }
 }
 
+void Tensor::resize(const KDRange& range) {
+    if (strides == NULL || order != range.min.size()) {
+        if (strides != NULL) {
+            delete[] strides;
+        }
+        order = range.min.size();
+        strides = new int[order];
+    }
+    this->range = range;
+    size = 1;
+    for (int i = order - 1; i >= 0; i--) {
+        strides[i] = size;
+        size *= range.max[i] - range.min[i];
+    }
+    if (size > capacity) {
+        if (values != NULL) {
+            delete[] values;
+        }
+        values = new double[size];
+        capacity = size;
+    }
+}
+
 double& Tensor::operator[](const unsigned int* loc) {
     unsigned int index = 0;
     for (unsigned int i = 0; i < order; i++) {
@@ -113,13 +143,17 @@ double Tensor::sum() const {
 }
 
 double Tensor::sum(const KDRange& range) const {
-    ConstTensorIterator* itr = const_iterator(range);
     double total = 0.0;
-    while (!itr->done()) {
-        total += *itr->get();
-        itr->advance();
-    }
-    delete itr;
+    dispatch_order(order, [&](auto o) {
+        const unsigned int ORDER = decltype(o)::value;
+        for_each_row<ORDER>(
+                range, [&](const unsigned int* loc, unsigned int length) {
+                    const double* row = &values[offset<ORDER>(loc)];
+                    for (unsigned int i = 0; i < length; i++) {
+                        total += row[i];
+                    }
+                });
+    });
     return total;
 }
 
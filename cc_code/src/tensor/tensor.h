@@ -23,10 +23,18 @@ namespace whatprot {
 
 class Tensor {
 public:
+    // The default constructor gives an empty tensor of order zero. It is
+    // intended to be followed by a call to resize().
+    Tensor();
     Tensor(unsigned int order, const unsigned int* shape);
     Tensor(const KDRange& range);
     Tensor(Tensor&& other);
     ~Tensor();
+    // Reshape the tensor to cover the given range. The underlying memory is
+    // only reallocated if it is too small, so repeated calls do not allocate
+    // once the tensor has grown to its largest size. Unlike the constructors,
+    // this does NOT zero the values.
+    void resize(const KDRange& range);
     double& operator[](const unsigned int* loc);
     // This next function is probably not useful in production, but is very
     // helpful for readable tests. Note that, unfortunately, lines of code like
@@ -42,6 +50,19 @@ public:
                                           unsigned int vector_dimension);
     ConstTensorVectorIterator* const_vector_iterator(
             const KDRange& range, unsigned int vector_dimension) const;
+    // Index into values of loc, which must have one entry per dimension.
+    // ORDER must be either the order of the tensor or zero, in which case the
+    // order is looked up at runtime (see range-loop.h). Combined with
+    // for_each_row() this gives the start of a contiguous row of values.
+    template <unsigned int ORDER>
+    unsigned int offset(const unsigned int* loc) const {
+        const unsigned int o = (ORDER != 0) ? ORDER : order;
+        unsigned int index = 0;
+        for (unsigned int i = 0; i < o; i++) {
+            index += strides[i] * (loc[i] - range.min[i]);
+        }
+        return index;
+    }
     double sum() const;
     double sum(const KDRange& range) const;
 
@@ -49,6 +70,7 @@ public:
     KDRange range;
     int* strides;
     unsigned int size;
+    unsigned int capacity;  // allocated length of values, at least size.
     unsigned int order;
 };
 
@@ -175,6 +175,70 @@ BOOST_AUTO_TEST_CASE(move_constructor_test, *tolerance(TOL)) {
     BOOST_TEST(t2.values[23] == 0.0);
 }
 
+BOOST_AUTO_TEST_CASE(default_constructor_test) {
+    Tensor t;
+    BOOST_TEST(t.values == (void*)NULL);
+    BOOST_TEST(t.strides == (void*)NULL);
+    BOOST_TEST(t.size == 0u);
+    BOOST_TEST(t.capacity == 0u);
+    BOOST_TEST(t.order == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(resize_from_default_test) {
+    KDRange range;
+    range.min = {1, 0};
+    range.max = {3, 3};
+    Tensor t;
+    t.resize(range);
+    BOOST_TEST(t.order == 2u);
+    BOOST_TEST(t.range.min[0] == 1u);
+    BOOST_TEST(t.range.min[1] == 0u);
+    BOOST_TEST(t.range.max[0] == 3u);
+    BOOST_TEST(t.range.max[1] == 3u);
+    BOOST_TEST(t.strides[0] == 3);
+    BOOST_TEST(t.strides[1] == 1);
+    BOOST_TEST(t.size == 2u * 3u);
+    BOOST_TEST(t.capacity == 2u * 3u);
+    BOOST_TEST(t.values != (void*)NULL);
+}
+
+BOOST_AUTO_TEST_CASE(resize_smaller_keeps_memory_test) {
+    unsigned int order = 2;
+    unsigned int* shape = new unsigned int[order];
+    shape[0] = 4;
+    shape[1] = 5;
+    Tensor t(order, shape);
+    delete[] shape;
+    double* values = t.values;
+    KDRange range;
+    range.min = {0, 0};
+    range.max = {2, 3};
+    t.resize(range);
+    BOOST_TEST(t.values == values);
+    BOOST_TEST(t.strides[0] == 3);
+    BOOST_TEST(t.strides[1] == 1);
+    BOOST_TEST(t.size == 2u * 3u);
+    BOOST_TEST(t.capacity == 4u * 5u);
+}
+
+BOOST_AUTO_TEST_CASE(resize_bigger_reallocates_test) {
+    unsigned int order = 1;
+    unsigned int* shape = new unsigned int[order];
+    shape[0] = 2;
+    Tensor t(order, shape);
+    delete[] shape;
+    KDRange range;
+    range.min = {0, 0, 0};
+    range.max = {2, 3, 4};
+    t.resize(range);
+    BOOST_TEST(t.order == 3u);
+    BOOST_TEST(t.strides[0] == 3 * 4);
+    BOOST_TEST(t.strides[1] == 4);
+    BOOST_TEST(t.strides[2] == 1);
+    BOOST_TEST(t.size == 2u * 3u * 4u);
+    BOOST_TEST(t.capacity == 2u * 3u * 4u);
+}
+
 BOOST_AUTO_TEST_CASE(bracket_op_test, *tolerance(TOL)) {
     unsigned int order = 2;
     unsigned int* shape = new unsigned int[order];
@@ -529,6 +593,17 @@ BOOST_AUTO_TEST_CASE(const_vector_iterator_dimension_1_test, *tolerance(TOL)) {
     delete[] shape;
 }
 
+BOOST_AUTO_TEST_CASE(offset_test) {
+    KDRange range;
+    range.min = {1, 2};
+    range.max = {3, 5};
+    Tensor t(range);
+    unsigned int loc[] = {2, 3};
+    BOOST_TEST(t.offset<2>(loc) == 1u * 3u + 1u);
+    BOOST_TEST(t.offset<0>(loc) == 1u * 3u + 1u);
+    BOOST_TEST(&t.values[t.offset<2>(loc)] == &(t[{2, 3}]));
+}
+
 BOOST_AUTO_TEST_CASE(sum_trivial_test, *tolerance(TOL)) {
     unsigned int order = 1;
     unsigned int* shape = new unsigned int[order];
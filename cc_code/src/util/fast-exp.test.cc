@@ -0,0 +1,54 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+
+// Boost unit test framework (recommended to be the first include):
+#include <boost/test/unit_test.hpp>
+
+// File under test:
+#include "fast-exp.h"
+
+// Standard C++ library headers:
+#include <cmath>
+#include <limits>
+
+namespace whatprot {
+
+namespace {
+using boost::unit_test::tolerance;
+using std::exp;
+using std::numeric_limits;
+const double TOL = 0.00000001;
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(util_suite)
+BOOST_AUTO_TEST_SUITE(fast_exp_suite)
+
+BOOST_AUTO_TEST_CASE(zero_test) {
+    BOOST_TEST(fast_exp(0.0) == 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(matches_exp_test, *tolerance(TOL)) {
+    for (double x = -700.0; x < 700.0; x += 0.37) {
+        BOOST_TEST(fast_exp(x) / exp(x) == 1.0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(underflow_test) {
+    BOOST_TEST(fast_exp(-1000.0) == 0.0);
+    BOOST_TEST(fast_exp(-numeric_limits<double>::infinity()) == 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(overflow_test) {
+    BOOST_TEST(fast_exp(1000.0) == numeric_limits<double>::infinity());
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // fast_exp_suite
+BOOST_AUTO_TEST_SUITE_END()  // util_suite
+
+}  // namespace whatprot
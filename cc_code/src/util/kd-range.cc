@@ -26,6 +26,35 @@ KDRange KDRange::intersect(const KDRange& other) const {
     return result;
 }
 
+KDRange KDRange::bounding_union(const KDRange& other) const {
+    if (other.is_empty()) {
+        return *this;
+    }
+    if (is_empty()) {
+        return other;
+    }
+    KDRange result;
+    result.min.resize(min.size());
+    result.max.resize(max.size());
+    for (unsigned int i = 0; i < result.min.size(); i++) {
+        result.min[i] = std::min(min[i], other.min[i]);
+        result.max[i] = std::max(max[i], other.max[i]);
+    }
+    return result;
+}
+
+bool KDRange::contains(const KDRange& other) const {
+    if (other.is_empty()) {
+        return true;
+    }
+    for (unsigned int i = 0; i < min.size(); i++) {
+        if (other.min[i] < min[i] || other.max[i] > max[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool KDRange::is_empty() const {
     for (unsigned int i = 0; i < min.size(); i++) {
         if (min[i] >= max[i]) {
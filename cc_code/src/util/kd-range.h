@@ -17,6 +17,12 @@ namespace whatprot {
 class KDRange {
 public:
     KDRange intersect(const KDRange& other) const;
+    // Smallest range which contains both this and other. An empty range
+    // contains nothing, so it has no effect on the result.
+    KDRange bounding_union(const KDRange& other) const;
+    // Whether every location in other is also in this. An empty range is
+    // contained by everything.
+    bool contains(const KDRange& other) const;
     bool is_empty() const;
     bool includes_zero() const;
 
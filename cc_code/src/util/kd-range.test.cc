@@ -45,6 +45,59 @@ BOOST_AUTO_TEST_CASE(intersect_test) {
     BOOST_TEST(z.max[2] == 10u);
 }
 
+BOOST_AUTO_TEST_CASE(bounding_union_test) {
+    KDRange x;
+    x.min = {2, 5, 7};
+    x.max = {4, 9, 11};
+    KDRange y;
+    y.min = {1, 7, 6};
+    y.max = {5, 13, 10};
+    KDRange z = x.bounding_union(y);
+    BOOST_TEST(z.min[0] == 1u);
+    BOOST_TEST(z.min[1] == 5u);
+    BOOST_TEST(z.min[2] == 6u);
+    BOOST_TEST(z.max[0] == 5u);
+    BOOST_TEST(z.max[1] == 13u);
+    BOOST_TEST(z.max[2] == 11u);
+}
+
+BOOST_AUTO_TEST_CASE(bounding_union_empty_test) {
+    KDRange x;
+    x.min = {2, 5, 7};
+    x.max = {4, 9, 11};
+    KDRange y;
+    y.min = {0, 7, 0};
+    y.max = {9, 7, 20};
+    KDRange z = x.bounding_union(y);
+    BOOST_TEST(z.min == x.min);
+    BOOST_TEST(z.max == x.max);
+    z = y.bounding_union(x);
+    BOOST_TEST(z.min == x.min);
+    BOOST_TEST(z.max == x.max);
+}
+
+BOOST_AUTO_TEST_CASE(contains_test) {
+    KDRange x;
+    x.min = {0, 5, 2};
+    x.max = {1, 8, 11};
+    KDRange y;
+    y.min = {0, 6, 2};
+    y.max = {1, 8, 10};
+    BOOST_TEST(x.contains(y) == true);
+    BOOST_TEST(y.contains(x) == false);
+    BOOST_TEST(x.contains(x) == true);
+}
+
+BOOST_AUTO_TEST_CASE(contains_empty_test) {
+    KDRange x;
+    x.min = {0, 5, 2};
+    x.max = {1, 8, 11};
+    KDRange y;
+    y.min = {3, 20, 2};
+    y.max = {3, 21, 10};
+    BOOST_TEST(x.contains(y) == true);
+}
+
 BOOST_AUTO_TEST_CASE(is_empty_false_test) {
     KDRange x;
     x.min.resize(3);
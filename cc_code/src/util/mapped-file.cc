@@ -0,0 +1,70 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+
+// Defining symbols from header:
+#include "mapped-file.h"
+
+// Standard C++ library headers:
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace whatprot {
+
+namespace {
+using std::size_t;
+using std::string;
+using std::uint64_t;
+}  // namespace
+
+MappedFile::MappedFile(const string& filename) : data(NULL), size(0) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+        void* addr = mmap(
+                NULL, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+            data = (const char*)addr;
+            size = (size_t)file_stat.st_size;
+            // Our readers go through the file front to back.
+            madvise(addr, size, MADV_SEQUENTIAL);
+        }
+    }
+    // The mapping stays valid after the file descriptor is closed.
+    close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (data != NULL) {
+        munmap((void*)data, size);
+    }
+}
+
+bool MappedFile::has_room(uint64_t offset,
+                          uint64_t num_blocks,
+                          uint64_t block_size) const {
+    if (offset > size) {
+        return false;
+    }
+    if (block_size == 0) {
+        return true;
+    }
+    return num_blocks <= (size - offset) / block_size;
+}
+
+}  // namespace whatprot
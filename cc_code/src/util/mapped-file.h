@@ -0,0 +1,44 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+
+#ifndef WHATPROT_UTIL_MAPPED_FILE_H
+#define WHATPROT_UTIL_MAPPED_FILE_H
+
+// Standard C++ library headers:
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace whatprot {
+
+// Maps a whole file into memory read-only, so that binary files can be read
+// straight out of the page cache without copying them into buffers of our
+// own. The mapping is released by the destructor, so anything pointing into
+// data must not outlive the MappedFile.
+class MappedFile {
+public:
+    MappedFile(const std::string& filename);
+    ~MappedFile();
+
+    // Whether the file holds num_blocks blocks of block_size bytes, starting
+    // at offset. This is safe from overflow however large the arguments are,
+    // so they can come straight from the header of a file which may be
+    // damaged, so long as block_size itself was computed without overflow.
+    bool has_room(std::uint64_t offset,
+                  std::uint64_t num_blocks,
+                  std::uint64_t block_size) const;
+
+    // NULL if the file could not be opened or mapped, or is empty.
+    const char* data;
+    std::size_t size;
+};
+
+}  // namespace whatprot
+
+#endif  // WHATPROT_UTIL_MAPPED_FILE_H
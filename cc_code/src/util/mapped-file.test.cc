@@ -0,0 +1,80 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+
+// Boost unit test framework (recommended to be the first include):
+#include <boost/test/unit_test.hpp>
+
+// File under test:
+#include "mapped-file.h"
+
+// Standard C++ library headers:
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+namespace whatprot {
+
+namespace {
+using std::ofstream;
+using std::remove;
+using std::string;
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(util_suite)
+BOOST_AUTO_TEST_SUITE(mapped_file_suite)
+
+BOOST_AUTO_TEST_CASE(constructor_test) {
+    string filename = "mapped-file-test.tmp";
+    {
+        ofstream f(filename, ofstream::binary);
+        f << "abc";
+    }
+    {
+        MappedFile mf(filename);
+        BOOST_REQUIRE(mf.data != NULL);
+        BOOST_TEST(mf.size == 3u);
+        BOOST_TEST(mf.data[0] == 'a');
+        BOOST_TEST(mf.data[1] == 'b');
+        BOOST_TEST(mf.data[2] == 'c');
+    }
+    remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(has_room_test) {
+    string filename = "mapped-file-test.tmp";
+    {
+        ofstream f(filename, ofstream::binary);
+        f << "abcdefghij";
+    }
+    {
+        MappedFile mf(filename);
+        BOOST_REQUIRE(mf.size == 10u);
+        BOOST_TEST(mf.has_room(0, 10, 1));
+        BOOST_TEST(mf.has_room(2, 4, 2));
+        BOOST_TEST(mf.has_room(10, 0, 4));
+        BOOST_TEST(mf.has_room(10, 1000, 0));
+        BOOST_TEST(!mf.has_room(0, 11, 1));
+        BOOST_TEST(!mf.has_room(3, 4, 2));
+        BOOST_TEST(!mf.has_room(11, 0, 1));
+        // Would wrap around if multiplied out.
+        BOOST_TEST(!mf.has_room(0, 0x8000000000000000ull, 2));
+    }
+    remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(constructor_missing_file_test) {
+    MappedFile mf("mapped-file-test-does-not-exist.tmp");
+    BOOST_TEST(mf.data == (const char*)NULL);
+    BOOST_TEST(mf.size == 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // mapped_file_suite
+BOOST_AUTO_TEST_SUITE_END()  // util_suite
+
+}  // namespace whatprot
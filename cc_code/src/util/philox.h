@@ -0,0 +1,101 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+#ifndef WHATPROT_UTIL_PHILOX_H
+#define WHATPROT_UTIL_PHILOX_H
+
+// Standard C++ library headers:
+#include <cstdint>
+
+namespace whatprot {
+
+// The Philox4x32-10 counter-based random number generator (Salmon et al.,
+// "Parallel random numbers: as easy as 1, 2, 3", SC 2011). Each output block
+// is a fixed function of a key and a counter, so any number of independent
+// streams can be made from one seed without any shared state: the seed is the
+// key, the stream is the upper half of the counter, and the position in the
+// stream is the lower half. A simulation which gives every unit of work its
+// own stream gets the same results no matter how the work is split between
+// threads.
+//
+// This meets the requirements of a UniformRandomBitGenerator, so it can be used
+// with the distributions of <random> in place of default_random_engine. It is
+// defined here in the header so that it can be inlined into hot loops.
+class Philox {
+public:
+    typedef std::uint32_t result_type;
+
+    Philox(std::uint64_t seed, std::uint64_t stream) : index(4) {
+        key[0] = (std::uint32_t)seed;
+        key[1] = (std::uint32_t)(seed >> 32);
+        counter[0] = 0;
+        counter[1] = 0;
+        counter[2] = (std::uint32_t)stream;
+        counter[3] = (std::uint32_t)(stream >> 32);
+    }
+
+    static constexpr result_type min() {
+        return 0;
+    }
+
+    static constexpr result_type max() {
+        return 0xFFFFFFFF;
+    }
+
+    result_type operator()() {
+        if (index == 4) {
+            block(counter, key, output);
+            // The position in the stream is the lower 64 bits of the counter.
+            counter[0]++;
+            if (counter[0] == 0) {
+                counter[1]++;
+            }
+            index = 0;
+        }
+        return output[index++];
+    }
+
+    // Sets out to the ten-round Philox4x32 function of in and k.
+    static void block(const std::uint32_t* in,
+                      const std::uint32_t* k,
+                      std::uint32_t* out) {
+        std::uint32_t x0 = in[0];
+        std::uint32_t x1 = in[1];
+        std::uint32_t x2 = in[2];
+        std::uint32_t x3 = in[3];
+        std::uint32_t k0 = k[0];
+        std::uint32_t k1 = k[1];
+        for (int r = 0; r < 10; r++) {
+            std::uint64_t p0 = (std::uint64_t)0xD2511F53 * x0;
+            std::uint64_t p1 = (std::uint64_t)0xCD9E8D57 * x2;
+            std::uint32_t y0 = (std::uint32_t)(p1 >> 32) ^ x1 ^ k0;
+            std::uint32_t y1 = (std::uint32_t)p1;
+            std::uint32_t y2 = (std::uint32_t)(p0 >> 32) ^ x3 ^ k1;
+            std::uint32_t y3 = (std::uint32_t)p0;
+            x0 = y0;
+            x1 = y1;
+            x2 = y2;
+            x3 = y3;
+            k0 += 0x9E3779B9;
+            k1 += 0xBB67AE85;
+        }
+        out[0] = x0;
+        out[1] = x1;
+        out[2] = x2;
+        out[3] = x3;
+    }
+
+    std::uint32_t key[2];
+    std::uint32_t counter[4];
+    std::uint32_t output[4];
+    int index;  // of the next output to use; 4 if there are none left.
+};
+
+}  // namespace whatprot
+
+#endif  // WHATPROT_UTIL_PHILOX_H
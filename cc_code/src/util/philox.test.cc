@@ -0,0 +1,118 @@
+/******************************************************************************\
+* Author: Matthew Beauregard Smith                                             *
+* Affiliation: The University of Texas at Austin                               *
+* Department: Oden Institute and Institute for Cellular and Molecular Biology  *
+* PI: Edward Marcotte                                                          *
+* Project: Protein Fluorosequencing                                            *
+\******************************************************************************/
+
+// Boost unit test framework (recommended to be the first include):
+#include <boost/test/unit_test.hpp>
+
+// File under test:
+#include "util/philox.h"
+
+// Standard C++ library headers:
+#include <cstdint>
+#include <random>
+
+namespace whatprot {
+
+namespace {
+using std::uint32_t;
+using std::uniform_real_distribution;
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(util_suite)
+BOOST_AUTO_TEST_SUITE(philox_suite)
+
+BOOST_AUTO_TEST_CASE(block_zero_test) {
+    // Known answer from the Random123 library.
+    uint32_t in[4] = {0, 0, 0, 0};
+    uint32_t k[2] = {0, 0};
+    uint32_t out[4];
+    Philox::block(in, k, out);
+    BOOST_TEST(out[0] == 0x6627e8d5u);
+    BOOST_TEST(out[1] == 0xe169c58du);
+    BOOST_TEST(out[2] == 0xbc57ac4cu);
+    BOOST_TEST(out[3] == 0x9b00dbd8u);
+}
+
+BOOST_AUTO_TEST_CASE(block_ones_test) {
+    // Known answer from the Random123 library.
+    uint32_t in[4] = {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff};
+    uint32_t k[2] = {0xffffffff, 0xffffffff};
+    uint32_t out[4];
+    Philox::block(in, k, out);
+    BOOST_TEST(out[0] == 0x408f276du);
+    BOOST_TEST(out[1] == 0x41c83b0eu);
+    BOOST_TEST(out[2] == 0xa20bc7c6u);
+    BOOST_TEST(out[3] == 0x6d5451fdu);
+}
+
+BOOST_AUTO_TEST_CASE(block_pi_test) {
+    // Known answer from the Random123 library.
+    uint32_t in[4] = {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344};
+    uint32_t k[2] = {0xa4093822, 0x299f31d0};
+    uint32_t out[4];
+    Philox::block(in, k, out);
+    BOOST_TEST(out[0] == 0xd16cfe09u);
+    BOOST_TEST(out[1] == 0x94fdccebu);
+    BOOST_TEST(out[2] == 0x5001e420u);
+    BOOST_TEST(out[3] == 0x24126ea1u);
+}
+
+BOOST_AUTO_TEST_CASE(stream_test) {
+    // The first outputs are the first block for the counter (0, 0, stream),
+    // and the next ones are the block for (1, 0, stream).
+    Philox philox(0x0000000200000001ull, 0x0000000400000003ull);
+    uint32_t in[4] = {0, 0, 3, 4};
+    uint32_t k[2] = {1, 2};
+    uint32_t out[4];
+    Philox::block(in, k, out);
+    for (int i = 0; i < 4; i++) {
+        BOOST_TEST(philox() == out[i]);
+    }
+    in[0] = 1;
+    Philox::block(in, k, out);
+    for (int i = 0; i < 4; i++) {
+        BOOST_TEST(philox() == out[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(reproducible_test) {
+    // The same seed and stream give the same numbers, and different streams
+    // give different numbers.
+    Philox a(7, 11);
+    Philox b(7, 11);
+    Philox c(7, 12);
+    bool all_same = true;
+    for (int i = 0; i < 10; i++) {
+        uint32_t x = a();
+        BOOST_TEST(x == b());
+        if (x != c()) {
+            all_same = false;
+        }
+    }
+    BOOST_TEST(!all_same);
+}
+
+BOOST_AUTO_TEST_CASE(distribution_test) {
+    // Works with the distributions of <random>.
+    Philox philox(3, 5);
+    uniform_real_distribution<double> uniform(0.0, 1.0);
+    double total = 0.0;
+    for (int i = 0; i < 10000; i++) {
+        double x = uniform(philox);
+        BOOST_TEST(x >= 0.0);
+        BOOST_TEST(x < 1.0);
+        total += x;
+    }
+    BOOST_TEST(total / 10000.0 > 0.48);
+    BOOST_TEST(total / 10000.0 < 0.52);
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // philox_suite
+BOOST_AUTO_TEST_SUITE_END()  // util_suite
+
+}  // namespace whatprot
@@ -0,0 +1,77 @@
+# -*- coding: utf-8 -*-
+"""
+@author: Matthew Beauregard Smith (UT Austin)
+"""
+
+import subprocess
+import time
+
+def read_predictions(predictions_file):
+    f = open(predictions_file, "r")
+    preds_csv = f.readlines()
+    f.close()
+    preds_csv = preds_csv[1:]
+    preds = [0] * len(preds_csv)
+    for i in range(0, len(preds_csv)):
+        cells = preds_csv[i].split(",")
+        preds[i] = int(cells[1])
+    return preds
+
+# Runs whatprot with args, which must write its predictions to
+# predictions_file, and returns how long it took in seconds and the predicted
+# ids.
+def run_nn(args, predictions_file):
+    start = time.time()
+    subprocess.run(args, check = True, stdout = subprocess.DEVNULL)
+    seconds = time.time() - start
+    return seconds, read_predictions(predictions_file)
+
+# The fraction of radiometries given the same id in preds as in ref_preds.
+def agreement(preds, ref_preds):
+    same = 0
+    for j in range(0, len(ref_preds)):
+        if (preds[j] == ref_preds[j]):
+            same += 1
+    return same / len(ref_preds)
+
+# Runs the kNN classifier for each k, once with an exact search and then once
+# for each value of epsilon (the -a parameter), and prints how long each run
+# took next to the fraction of radiometries given the same classification as
+# the exact search with the same k. The default ks are a small k and the k we
+# recommend for the hybrid classifier. Use this to choose how much accuracy to
+# trade for speed; a small epsilon may prune too little to be any faster.
+#
+# This measures the classifications, not the neighbors. whatprot does not
+# write out the neighbors it finds, so their recall can't be measured here.
+def nn_epsilon_benchmark(whatprot,
+                         seq_params_file,
+                         dye_tracks_file,
+                         radiometries_file,
+                         directory,
+                         ks = [100, 10000],
+                         sigma = 0.5,
+                         epsilons = [0.25, 0.5, 1.0, 2.0, 4.0]):
+    runs = [0.0] + epsilons
+    print("k\tepsilon\tseconds\tspeedup\tagreement")
+    for k in ks:
+        times = [0.0] * len(runs)
+        preds = [0] * len(runs)
+        for i in range(0, len(runs)):
+            predictions_file = (directory + "nn-epsilon-" + str(k) + "-"
+                                + str(runs[i]) + ".csv")
+            args = [whatprot, "classify", "nn",
+                    "-k", str(k),
+                    "-s", str(sigma),
+                    "-P", directory + seq_params_file,
+                    "-T", directory + dye_tracks_file,
+                    "-R", directory + radiometries_file,
+                    "-Y", predictions_file]
+            if (runs[i] > 0.0):
+                args += ["-a", str(runs[i])]
+            times[i], preds[i] = run_nn(args, predictions_file)
+        for i in range(0, len(runs)):
+            print(str(k) + "\t"
+                  + str(runs[i]) + "\t"
+                  + "{:.2f}".format(times[i]) + "\t"
+                  + "{:.2f}".format(times[0] / times[i]) + "\t"
+                  + "{:.4f}".format(agreement(preds[i], preds[0])))
@@ -0,0 +1,41 @@
+# -*- coding: utf-8 -*-
+"""
+@author: Matthew Beauregard Smith (UT Austin)
+"""
+
+from nn_epsilon_benchmark import agreement
+from nn_epsilon_benchmark import run_nn
+
+# Runs the kNN classifier once with each index (the -i parameter), and prints
+# how long each run took next to the fraction of radiometries given the same
+# classification as the KD-tree. Both searches are exact, but they still don't
+# always agree (about 4% of radiometries in our runs). A dye track with more
+# than one hit counts that many times towards k, so which of the farthest
+# neighbors are kept depends on the order they are found in, and each index
+# finds them in a different order.
+def nn_index_benchmark(whatprot,
+                       seq_params_file,
+                       dye_tracks_file,
+                       radiometries_file,
+                       directory,
+                       k = 10000,
+                       sigma = 0.5,
+                       indexes = ["kd", "ball"]):
+    times = [0.0] * len(indexes)
+    preds = [0] * len(indexes)
+    for i in range(0, len(indexes)):
+        predictions_file = directory + "nn-index-" + indexes[i] + ".csv"
+        args = [whatprot, "classify", "nn",
+                "-k", str(k),
+                "-s", str(sigma),
+                "-i", indexes[i],
+                "-P", directory + seq_params_file,
+                "-T", directory + dye_tracks_file,
+                "-R", directory + radiometries_file,
+                "-Y", predictions_file]
+        times[i], preds[i] = run_nn(args, predictions_file)
+    print("index\tseconds\tagreement")
+    for i in range(0, len(indexes)):
+        print(indexes[i] + "\t"
+              + "{:.2f}".format(times[i]) + "\t"
+              + "{:.4f}".format(agreement(preds[i], preds[0])))